@@ -0,0 +1,104 @@
+/**
+ * @file bench_async_channel.cpp
+ * @brief Handing elements from a producer stage to a consumer stage through saxion::async_channel compared with
+ *        polling a saxion::list behind a mutex
+ *
+ * Usage: bench_async_channel [elements] [capacity]
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "async_channel.h"
+#include "bench_util.h"
+#include "list.h"
+
+namespace {
+
+    /// the baseline: the consumer polls a locked list and yields while it is empty
+    double run_polled(std::size_t elements) {
+        std::mutex mutex;
+        saxion::list<std::size_t> queue;
+        std::size_t sum = 0;
+
+        auto ns = bench::time_ns([&] {
+            std::thread consumer([&] {
+                for (std::size_t received = 0; received < elements;) {
+                    saxion::list<std::size_t> batch;
+                    {
+                        std::lock_guard lock{mutex};
+                        batch.splice(batch.end(), queue);
+                    }
+                    if (batch.empty()) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (auto v : batch) {
+                        sum += v;
+                    }
+                    received += batch.size();
+                }
+            });
+            for (std::size_t i = 0; i < elements; ++i) {
+                std::lock_guard lock{mutex};
+                queue.push_back(i);
+            }
+            consumer.join();
+        });
+        bench::do_not_optimize(sum);
+        return ns;
+    }
+
+    saxion::detached_task produce(saxion::async_channel<std::size_t>& channel, std::size_t elements) {
+        for (std::size_t i = 0; i < elements; ++i) {
+            co_await channel.push(i);
+        }
+        channel.close();
+    }
+
+    saxion::detached_task consume(saxion::async_channel<std::size_t>& channel, std::size_t& sum,
+                                  std::atomic<bool>& done) {
+        saxion::list<std::size_t> batch;
+        while (co_await channel.pop_batch(batch, 64)) {
+            for (auto v : batch) {
+                sum += v;
+            }
+            batch.clear();
+        }
+        done = true;
+        done.notify_one();
+    }
+
+    template<typename Executor>
+    double run_channel(Executor& exec, std::size_t elements, std::size_t capacity) {
+        std::size_t sum = 0;
+        std::atomic<bool> done{false};
+        auto ns = bench::time_ns([&] {
+            saxion::async_channel<std::size_t> channel(exec, capacity);
+            spawn(exec, consume(channel, sum, done));
+            spawn(exec, produce(channel, elements));
+            if constexpr (std::is_same_v<Executor, saxion::manual_executor>) {
+                exec.run();
+            }
+            done.wait(false);
+        });
+        bench::do_not_optimize(sum);
+        return ns;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto elements = bench::arg_or(argc, argv, 1, 1'000'000);
+    auto capacity = bench::arg_or(argc, argv, 2, 1024);
+
+    std::cout << elements << " elements, channel capacity " << capacity << ":\n";
+    saxion::manual_executor manual;
+    bench::report("async_channel, manual_executor", elements, run_channel(manual, elements, capacity));
+    {
+        saxion::thread_pool_executor pool(2);
+        bench::report("async_channel, 2 threads", elements, run_channel(pool, elements, capacity));
+    }
+    bench::report("polled list + mutex", elements, run_polled(elements));
+}
@@ -0,0 +1,104 @@
+/**
+ * @file bench_concurrent_ordered_list.cpp
+ * @brief Scaling of saxion::concurrent_ordered_list from 1 to N threads, compared with a std::set behind a mutex
+ *
+ * Every thread performs a mix of 90% lookups, 5% inserts and 5% erases on a shared key range.
+ *
+ * Usage: bench_concurrent_ordered_list [max threads] [operations per thread] [key range]
+ */
+
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "concurrent_ordered_list.h"
+
+namespace {
+
+    /// the baseline: a sorted set serialized by one mutex
+    class locked_set {
+        std::mutex mutex_;
+        std::set<int> set_;
+
+    public:
+        bool insert(int value) {
+            std::lock_guard lock{mutex_};
+            return set_.insert(value).second;
+        }
+
+        bool erase(int value) {
+            std::lock_guard lock{mutex_};
+            return set_.erase(value) != 0;
+        }
+
+        bool contains(int value) {
+            std::lock_guard lock{mutex_};
+            return set_.contains(value);
+        }
+    };
+
+    template<typename Set>
+    double run(Set& set, std::size_t threads, std::size_t ops, std::size_t keys) {
+        return bench::time_ns([&] {
+            std::vector<std::thread> workers;
+            for (std::size_t id = 0; id < threads; ++id) {
+                workers.emplace_back([&set, id, ops, keys] {
+                    std::mt19937 gen(static_cast<unsigned>(id));
+                    std::size_t found = 0;
+                    for (std::size_t i = 0; i < ops; ++i) {
+                        auto key = static_cast<int>(gen() % keys);
+                        auto roll = gen() % 100;
+                        if (roll < 5) {
+                            set.insert(key);
+                        } else if (roll < 10) {
+                            set.erase(key);
+                        } else {
+                            found += set.contains(key);
+                        }
+                    }
+                    bench::do_not_optimize(found);
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        });
+    }
+
+    template<typename Set>
+    void prefill(Set& set, std::size_t keys) {
+        for (std::size_t key = 0; key < keys; key += 2) {
+            set.insert(static_cast<int>(key));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    auto max_threads = bench::arg_or(argc, argv, 1, std::max(1U, std::thread::hardware_concurrency()));
+    auto ops = bench::arg_or(argc, argv, 2, 200'000);
+    auto keys = bench::arg_or(argc, argv, 3, 512);
+
+    std::cout << "Mixed workload (90% contains) on " << keys << " keys, " << ops << " operations per thread:\n";
+    // 1, 2, 4, ... and max_threads itself
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (auto threads : thread_counts) {
+        saxion::concurrent_ordered_list<int> lock_free;
+        prefill(lock_free, keys);
+        bench::report("concurrent_ordered_list " + std::to_string(threads) + " threads", threads * ops,
+                      run(lock_free, threads, ops, keys));
+
+        locked_set locked;
+        prefill(locked, keys);
+        bench::report("std::set + mutex " + std::to_string(threads) + " threads", threads * ops,
+                      run(locked, threads, ops, keys));
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file bench_concurrent_queue.cpp
+ * @brief Throughput of saxion::concurrent_queue compared with a saxion::list behind a single mutex
+ *
+ * P producers push their items one by one, P consumers pop them either one at a time or in batches with pop_n.
+ *
+ * Usage: bench_concurrent_queue [producers] [items per producer] [batch size]
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "concurrent_queue.h"
+#include "list.h"
+
+namespace {
+
+    /// the baseline: the work queue the concurrent queue replaces
+    class locked_queue {
+        std::mutex mutex_;
+        saxion::list<std::size_t> list_;
+
+    public:
+        void push(std::size_t value) {
+            std::lock_guard lock{mutex_};
+            list_.push_back(value);
+        }
+
+        std::size_t pop_n(saxion::list<std::size_t>& out, std::size_t n) {
+            std::lock_guard lock{mutex_};
+            std::size_t count = 0;
+            for (; count < n && !list_.empty(); ++count) {
+                out.push_back(list_.front());
+                list_.pop_front();
+            }
+            return count;
+        }
+    };
+
+    template<typename Queue>
+    double run(std::size_t pairs, std::size_t items, std::size_t batch) {
+        Queue queue;
+        return bench::time_ns([&] {
+            std::vector<std::thread> threads;
+            for (std::size_t id = 0; id < pairs; ++id) {
+                threads.emplace_back([&queue, items] {
+                    for (std::size_t i = 0; i < items; ++i) {
+                        queue.push(i);
+                    }
+                });
+                threads.emplace_back([&queue, items, batch] {
+                    saxion::list<std::size_t> local;
+                    std::size_t received = 0;
+                    std::size_t sum = 0;
+                    while (received < items) {
+                        local.clear();
+                        auto count = queue.pop_n(local, std::min(batch, items - received));
+                        if (count == 0) {
+                            std::this_thread::yield();
+                        }
+                        for (auto value : local) {
+                            sum += value;
+                        }
+                        received += count;
+                    }
+                    bench::do_not_optimize(sum);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+    }
+}
+
+int main(int argc, char** argv) {
+    auto pairs = bench::arg_or(argc, argv, 1, std::max(1U, std::thread::hardware_concurrency() / 2));
+    auto items = bench::arg_or(argc, argv, 2, 500'000);
+    auto batch = bench::arg_or(argc, argv, 3, 64);
+
+    std::cout << pairs << " producers and " << pairs << " consumers, " << items << " items each:\n";
+    for (auto size : {std::size_t{1}, batch}) {
+        auto suffix = " (pop " + std::to_string(size) + ")";
+        bench::report("concurrent_queue" + suffix, pairs * items, run<saxion::concurrent_queue<std::size_t>>(pairs, items, size));
+        bench::report("list + mutex" + suffix, pairs * items, run<locked_queue>(pairs, items, size));
+    }
+}
@@ -0,0 +1,259 @@
+/**
+ * @file bench_list.cpp
+ * @brief Microbenchmarks of saxion::list against std::list, std::deque and std::vector
+ *
+ * Every operation runs for every container, element type (int, std::string, a 64 byte record) and size
+ * (10^3, 10^4, ... up to the maximum). The operations that are O(n) per call for a container (inserting in the
+ * middle of a vector, operator[] on a list) run fewer times, the result is always the time per operation.
+ *
+ * Usage: bench_list [max size] [json file]
+ *
+ * The JSON file has one result per line, so the files of two versions can be diffed.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+
+namespace {
+
+    struct record {
+        std::uint64_t id;
+        double values[7];
+    };
+
+    static_assert(sizeof(record) == 64);
+
+    template<typename T>
+    T make(std::size_t i) {
+        if constexpr (std::is_same_v<T, int>) {
+            return static_cast<int>(i);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            // longer than the small string buffer, so every string allocates
+            return "element number " + std::to_string(i) + " of the benchmark";
+        } else {
+            return record{i, {}};
+        }
+    }
+
+    template<typename T>
+    std::size_t key(const T& value) {
+        if constexpr (std::is_same_v<T, int>) {
+            return static_cast<std::size_t>(value);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return value.size();
+        } else {
+            return value.id;
+        }
+    }
+
+    template<typename T>
+    const char* type_name() {
+        if constexpr (std::is_same_v<T, int>) {
+            return "int";
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return "string";
+        } else {
+            return "record64";
+        }
+    }
+
+    template<typename C>
+    constexpr bool is_vector = std::is_same_v<C, std::vector<typename C::value_type>>;
+
+    template<typename C>
+    constexpr bool is_deque = std::is_same_v<C, std::deque<typename C::value_type>>;
+
+    template<typename C>
+    constexpr bool is_std_list = std::is_same_v<C, std::list<typename C::value_type>>;
+
+    template<typename C>
+    C filled(std::size_t n) {
+        C c;
+        for (std::size_t i = 0; i < n; ++i) {
+            c.push_back(make<typename C::value_type>(i));
+        }
+        return c;
+    }
+
+    template<typename C>
+    void push_front(C& c, typename C::value_type value) {
+        if constexpr (is_vector<C>) {
+            c.insert(c.begin(), std::move(value));
+        } else {
+            c.push_front(std::move(value));
+        }
+    }
+
+    template<typename C>
+    void pop_front(C& c) {
+        if constexpr (is_vector<C>) {
+            c.erase(c.begin());
+        } else {
+            c.pop_front();
+        }
+    }
+
+    template<typename C>
+    const typename C::value_type& at_index(const C& c, std::size_t i) {
+        if constexpr (is_std_list<C>) {
+            return *std::next(c.begin(), static_cast<std::ptrdiff_t>(i));
+        } else {
+            return c[i];
+        }
+    }
+
+    /// number of calls of an operation that is O(n) per call, so that one measurement takes about 10^7 steps
+    std::size_t linear_calls(std::size_t n) {
+        return std::clamp<std::size_t>(10'000'000 / std::max<std::size_t>(n, 1), 1, 1000);
+    }
+
+    class suite {
+        bench::results& results_;
+
+        template<typename C>
+        void record_result(const char* container, const char* operation, std::size_t n, std::size_t ops, double ns) {
+            using T = typename C::value_type;
+            bench::report(std::string(container) + " " + type_name<T>() + " " + operation + " n=" + std::to_string(n), ops, ns);
+            results_.add()
+                    .label("container", container)
+                    .label("type", type_name<T>())
+                    .label("operation", operation)
+                    .value("size", static_cast<double>(n))
+                    .value("ns_per_op", ns / static_cast<double>(ops));
+        }
+
+    public:
+        explicit suite(bench::results& results) :
+            results_{results}
+        {}
+
+        template<typename C>
+        void run(const char* container, std::size_t n) {
+            using T = typename C::value_type;
+            constexpr bool front_is_linear = is_vector<C>;
+            constexpr bool middle_is_linear = is_vector<C> || is_deque<C>;
+            constexpr bool index_is_linear = !is_vector<C> && !is_deque<C>;
+
+            {
+                C c;
+                record_result<C>(container, "push_back", n, n, bench::time_ns([&] {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        c.push_back(make<T>(i));
+                    }
+                }));
+                record_result<C>(container, "pop_back", n, n, bench::time_ns([&] {
+                    while (!c.empty()) {
+                        c.pop_back();
+                    }
+                }));
+            }
+            {
+                C c;
+                auto calls = front_is_linear ? std::min(n, linear_calls(n)) : n;
+                record_result<C>(container, "push_front", n, calls, bench::time_ns([&] {
+                    for (std::size_t i = 0; i < calls; ++i) {
+                        push_front(c, make<T>(i));
+                    }
+                }));
+                c = filled<C>(n);
+                record_result<C>(container, "pop_front", n, calls, bench::time_ns([&] {
+                    for (std::size_t i = 0; i < calls; ++i) {
+                        pop_front(c);
+                    }
+                }));
+            }
+            {
+                auto c = filled<C>(n);
+                auto calls = middle_is_linear ? linear_calls(n) : std::max<std::size_t>(n, 1000);
+                auto middle = std::next(c.begin(), static_cast<std::ptrdiff_t>(n / 2));
+                record_result<C>(container, "insert_middle", n, calls, bench::time_ns([&] {
+                    for (std::size_t i = 0; i < calls; ++i) {
+                        middle = c.insert(middle, make<T>(i));
+                    }
+                }));
+                record_result<C>(container, "erase_middle", n, calls, bench::time_ns([&] {
+                    for (std::size_t i = 0; i < calls; ++i) {
+                        middle = c.erase(middle);
+                    }
+                }));
+            }
+            {
+                const auto c = filled<C>(n);
+                record_result<C>(container, "iterate", n, n, bench::best_of_ns(3, [&] {
+                    std::size_t sum = 0;
+                    for (const auto& v : c) {
+                        sum += key(v);
+                    }
+                    bench::do_not_optimize(sum);
+                }));
+
+                auto calls = index_is_linear ? linear_calls(n) : n;
+                record_result<C>(container, "operator[]", n, calls, bench::time_ns([&] {
+                    std::size_t sum = 0;
+                    std::size_t index = 0;
+                    for (std::size_t i = 0; i < calls; ++i) {
+                        // a stride co-prime with most sizes, to visit indexes all over the container
+                        index = (index + 7919) % n;
+                        sum += key(at_index(c, index));
+                    }
+                    bench::do_not_optimize(sum);
+                }));
+
+                // the copy is destroyed outside of the measurement, destroy measures that
+                std::optional<C> copy;
+                record_result<C>(container, "copy", n, n, bench::time_ns([&] {
+                    copy.emplace(c);
+                }));
+                bench::do_not_optimize(copy->size());
+            }
+            {
+                auto c = filled<C>(n);
+                record_result<C>(container, "clear", n, n, bench::time_ns([&] {
+                    c.clear();
+                }));
+            }
+            {
+                auto c = new C(filled<C>(n));
+                record_result<C>(container, "destroy", n, n, bench::time_ns([&] {
+                    delete c;
+                }));
+            }
+        }
+    };
+
+    template<typename T>
+    void run_type(suite& s, std::size_t n) {
+        s.run<saxion::list<T>>("saxion::list", n);
+        s.run<std::list<T>>("std::list", n);
+        s.run<std::deque<T>>("std::deque", n);
+        s.run<std::vector<T>>("std::vector", n);
+    }
+}
+
+int main(int argc, char** argv) {
+    auto max_size = bench::arg_or(argc, argv, 1, 1'000'000);
+
+    bench::results results("bench_list");
+    suite s(results);
+    for (std::size_t n = 1000; n <= max_size; n *= 10) {
+        run_type<int>(s, n);
+        run_type<std::string>(s, n);
+        run_type<record>(s, n);
+    }
+
+    if (argc > 2) {
+        std::ofstream out(argv[2]);
+        results.write_json(out);
+        std::cout << "results written to " << argv[2] << '\n';
+    }
+}
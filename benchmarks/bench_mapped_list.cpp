@@ -0,0 +1,66 @@
+/**
+ * @file bench_mapped_list.cpp
+ * @brief Restarting with saxion::mapped_list compared with rebuilding a saxion::list from a dump
+ *
+ * Usage: bench_mapped_list [elements] [file]
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+#include "mapped_list.h"
+
+namespace {
+
+    struct record {
+        std::size_t id;
+        double values[3];
+    };
+}
+
+int main(int argc, char** argv) {
+    auto elements = bench::arg_or(argc, argv, 1, 1'000'000);
+    std::filesystem::path file = argc > 2 ? argv[2] : "bench_mapped_list.dat";
+    auto dump = std::filesystem::path(file).replace_extension(".dump");
+    std::filesystem::remove(file);
+
+    std::cout << elements << " records of " << sizeof(record) << " bytes:\n";
+    {
+        saxion::mapped_list<record> lst(file);
+        bench::report("mapped_list push_back", elements, bench::time_ns([&] {
+            for (std::size_t i = 0; i < elements; ++i) {
+                lst.push_back(record{i, {}});
+            }
+        }));
+        bench::report("mapped_list checkpoint", 1, bench::time_ns([&] {
+            lst.checkpoint();
+        }));
+
+        // the baseline writes the same records to a plain dump
+        std::ofstream out(dump, std::ios::binary);
+        for (const auto& r : lst) {
+            out.write(reinterpret_cast<const char*>(&r), sizeof(r));
+        }
+    }
+
+    bench::report("mapped_list reopen", 1, bench::time_ns([&] {
+        saxion::mapped_list<record> lst(file);
+        bench::do_not_optimize(lst.size());
+    }));
+    bench::report("list rebuilt from dump", 1, bench::time_ns([&] {
+        saxion::list<record> lst;
+        std::ifstream in(dump, std::ios::binary);
+        record r{};
+        while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) {
+            lst.push_back(r);
+        }
+        bench::do_not_optimize(lst.size());
+    }));
+
+    std::filesystem::remove(file);
+    std::filesystem::remove(dump);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file bench_node_layout.cpp
+ * @brief Compares the node layout of saxion::list with the original one
+ *
+ * The original nodes had a virtual destructor and owned their successor through a std::unique_ptr,
+ * and every node was a separate std::make_unique allocation. A minimal list with that layout lives
+ * in the legacy namespace below.
+ *
+ * Usage: bench_node_layout [number of elements]
+ */
+
+#include <memory>
+#include <string>
+
+#include "bench_util.h"
+#include "list.h"
+
+namespace legacy {
+
+    struct node_base {
+        node_base* prev_{};
+        std::unique_ptr<node_base> next_{};
+
+        virtual ~node_base() noexcept = default;
+    };
+
+    template<typename T>
+    struct node : node_base {
+        T value_;
+
+        explicit node(T v) : value_{std::move(v)} {}
+    };
+
+    /// the original ownership scheme: head_ owns the first node, every node owns the next one
+    template<typename T>
+    class list {
+        std::unique_ptr<node_base> head_{};
+        node_base* tail_{};
+        std::size_t size_{};
+
+    public:
+        list() = default;
+
+        ~list() noexcept {
+            // unlink iteratively to avoid a recursive destruction of the chain
+            while (head_) {
+                head_ = std::move(head_->next_);
+            }
+        }
+
+        void push_back(T value) {
+            auto fresh = std::make_unique<node<T>>(std::move(value));
+            fresh->prev_ = tail_;
+            auto raw = fresh.get();
+            if (tail_) {
+                tail_->next_ = std::move(fresh);
+            } else {
+                head_ = std::move(fresh);
+            }
+            tail_ = raw;
+            ++size_;
+        }
+
+        void pop_front() noexcept {
+            if (head_) {
+                head_ = std::move(head_->next_);
+                if (head_) {
+                    head_->prev_ = nullptr;
+                } else {
+                    tail_ = nullptr;
+                }
+                --size_;
+            }
+        }
+
+        /// erases every other element, starting with the first one
+        void erase_every_other() noexcept {
+            auto current = head_.get();
+            bool erase = true;
+            while (current) {
+                auto next = current->next_.get();
+                if (erase) {
+                    if (next) {
+                        next->prev_ = current->prev_;
+                    } else {
+                        tail_ = current->prev_;
+                    }
+                    if (current->prev_) {
+                        current->prev_->next_ = std::move(current->next_);
+                    } else {
+                        head_ = std::move(current->next_);
+                    }
+                    --size_;
+                }
+                erase = !erase;
+                current = next;
+            }
+        }
+
+        [[nodiscard]]
+        std::size_t size() const noexcept {
+            return size_;
+        }
+    };
+}
+
+namespace {
+
+    template<typename T>
+    void print_layout(const std::string& type_name) {
+        std::cout << std::left << std::setw(24) << type_name
+                  << " legacy: " << std::setw(4) << sizeof(legacy::node<T>)
+                  << " bytes/node, saxion: " << std::setw(4) << sizeof(saxion::detail::list_node<T>)
+                  << " bytes/node\n";
+    }
+
+    void erase_every_other(saxion::list<int>& lst) {
+        auto it = lst.begin();
+        while (it != lst.end()) {
+            it = lst.erase(it);
+            if (it != lst.end()) {
+                ++it;
+            }
+        }
+    }
+
+    template<typename List>
+    void run(const std::string& name, std::size_t n) {
+        bench::report(name + " push_back", n, bench::best_of_ns(3, [n] {
+            List lst;
+            for (std::size_t i = 0; i < n; ++i) {
+                lst.push_back(static_cast<int>(i));
+            }
+            bench::do_not_optimize(lst);
+        }));
+
+        {
+            List lst;
+            for (std::size_t i = 0; i < n; ++i) {
+                lst.push_back(static_cast<int>(i));
+            }
+            bench::report(name + " erase every other", n / 2, bench::time_ns([&lst] {
+                if constexpr (std::is_same_v<List, saxion::list<int>>) {
+                    erase_every_other(lst);
+                } else {
+                    lst.erase_every_other();
+                }
+            }));
+            bench::do_not_optimize(lst.size());
+        }
+
+        {
+            List lst;
+            for (std::size_t i = 0; i < n; ++i) {
+                lst.push_back(static_cast<int>(i));
+            }
+            bench::report(name + " pop_front", n, bench::time_ns([&lst, n] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    lst.pop_front();
+                }
+            }));
+        }
+
+        {
+            auto lst = std::make_unique<List>();
+            for (std::size_t i = 0; i < n; ++i) {
+                lst->push_back(static_cast<int>(i));
+            }
+            bench::report(name + " destruction", n, bench::time_ns([&lst] { lst.reset(); }));
+        }
+
+        bench::report(name + " push_back/pop_front churn", n, bench::best_of_ns(3, [n] {
+            List lst;
+            for (int i = 0; i < 64; ++i) {
+                lst.push_back(i);
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                lst.push_back(static_cast<int>(i));
+                lst.pop_front();
+            }
+            bench::do_not_optimize(lst);
+        }));
+    }
+}
+
+int main(int argc, char** argv) {
+    auto n = bench::arg_or(argc, argv, 1, 1'000'000);
+
+    std::cout << "Node sizes:\n";
+    print_layout<int>("int");
+    print_layout<double>("double");
+    print_layout<std::string>("std::string");
+
+    std::cout << "\nThroughput with " << n << " elements:\n";
+    run<legacy::list<int>>("legacy", n);
+    run<saxion::list<int>>("saxion", n);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file bench_parallel.cpp
+ * @brief Scaling of the parallel algorithms of parallel.h over a saxion::list
+ *
+ * Every algorithm runs sequentially and then on 1, 2, 4, ... threads up to the maximum. The copy of a list of
+ * strings compares the copy constructor (seq) with the parallel copy.
+ *
+ * Usage: bench_parallel [elements] [max threads]
+ */
+
+#include <cmath>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+
+#include "bench_util.h"
+#include "list.h"
+#include "parallel.h"
+
+namespace {
+
+    namespace ex = saxion::execution;
+
+    /// some arithmetic per element, so that the work isn't only the walk over the links
+    double weight(double v) {
+        return std::sqrt(v) * std::log1p(v);
+    }
+
+    template<typename Fn>
+    void scale(const std::string& name, std::size_t elements, std::size_t max_threads, Fn fn) {
+        bench::report(name + " seq", elements, bench::best_of_ns(3, [&] { fn(ex::seq); }));
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            bench::report(name + " par(" + std::to_string(threads) + ")", elements,
+                          bench::best_of_ns(3, [&] { fn(ex::par(threads)); }));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    auto elements = bench::arg_or(argc, argv, 1, 5'000'000);
+    auto max_threads = bench::arg_or(argc, argv, 2, std::max(1U, std::thread::hardware_concurrency()));
+
+    saxion::list<double> lst;
+    std::mt19937_64 rng(19);
+    std::uniform_real_distribution<double> dist(0, 1e6);
+    for (std::size_t i = 0; i < elements; ++i) {
+        lst.push_back(dist(rng));
+    }
+
+    std::cout << elements << " elements, up to " << max_threads << " threads:\n";
+    scale("transform_reduce", elements, max_threads, [&](const auto& policy) {
+        bench::do_not_optimize(saxion::transform_reduce(policy, lst, 0.0, std::plus<>{}, weight));
+    });
+    scale("count_if", elements, max_threads, [&](const auto& policy) {
+        bench::do_not_optimize(saxion::count_if(policy, lst, [](double v) { return weight(v) > 1e4; }));
+    });
+    scale("for_each", elements, max_threads, [&](const auto& policy) {
+        saxion::for_each(policy, lst, [](double& v) { v = weight(v); });
+    });
+    scale("sort", elements, max_threads, [&](const auto& policy) {
+        // sorting alternately ascending and descending, so that every run has the same amount of work
+        static bool ascending = false;
+        ascending = !ascending;
+        if (ascending) {
+            saxion::sort(policy, lst);
+        } else {
+            saxion::sort(policy, lst, std::greater<>{});
+        }
+    });
+
+    saxion::list<std::string> strings;
+    for (std::size_t i = 0; i < elements; ++i) {
+        strings.push_back("a string too long for the small string buffer " + std::to_string(i));
+    }
+    scale("copy", elements, max_threads, [&](const auto& policy) {
+        bench::do_not_optimize(saxion::copy(policy, strings).size());
+    });
+}
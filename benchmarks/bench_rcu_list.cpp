@@ -0,0 +1,131 @@
+/**
+ * @file bench_rcu_list.cpp
+ * @brief Reader throughput of saxion::rcu_list compared with a saxion::list behind a std::shared_mutex
+ *
+ * Readers traverse the whole list over and over while one writer replaces an element every millisecond, like a
+ * routing table that is consulted on every request.
+ *
+ * Usage: bench_rcu_list [max readers] [traversals per reader] [elements]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+#include "rcu_list.h"
+
+namespace {
+
+    /// the baseline: readers share a lock, the writer takes it exclusively
+    class locked_list {
+        mutable std::shared_mutex mutex_;
+        saxion::list<std::size_t> list_;
+
+    public:
+        explicit locked_list(std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                list_.push_back(i);
+            }
+        }
+
+        [[nodiscard]]
+        std::size_t sum() const {
+            std::shared_lock lock{mutex_};
+            std::size_t sum = 0;
+            for (auto value : list_) {
+                sum += value;
+            }
+            return sum;
+        }
+
+        void replace(std::size_t value) {
+            std::lock_guard lock{mutex_};
+            for (auto& element : list_) {
+                if (element == value) {
+                    element = value;
+                }
+            }
+        }
+    };
+
+    class rcu_table {
+        saxion::rcu_list<std::size_t> list_;
+
+    public:
+        explicit rcu_table(std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                list_.push_back(i);
+            }
+        }
+
+        [[nodiscard]]
+        std::size_t sum() const {
+            std::size_t sum = 0;
+            for (auto value : list_.read()) {
+                sum += value;
+            }
+            return sum;
+        }
+
+        void replace(std::size_t value) {
+            list_.replace_if([value](std::size_t element) { return element == value; }, value);
+        }
+    };
+
+    template<typename Table>
+    double run(std::size_t readers, std::size_t traversals, std::size_t elements) {
+        Table table(elements);
+        std::atomic<bool> done{false};
+        std::thread writer([&] {
+            for (std::size_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+                table.replace(i % elements);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        auto ns = bench::time_ns([&] {
+            std::vector<std::thread> threads;
+            for (std::size_t id = 0; id < readers; ++id) {
+                threads.emplace_back([&table, traversals] {
+                    std::size_t total = 0;
+                    for (std::size_t i = 0; i < traversals; ++i) {
+                        total += table.sum();
+                    }
+                    bench::do_not_optimize(total);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        done = true;
+        writer.join();
+        return ns;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto max_readers = bench::arg_or(argc, argv, 1, std::max(1U, std::thread::hardware_concurrency()));
+    auto traversals = bench::arg_or(argc, argv, 2, 200'000);
+    auto elements = bench::arg_or(argc, argv, 3, 64);
+
+    std::cout << traversals << " traversals of " << elements << " elements per reader, one writer:\n";
+    // 1, 2, 4, ... and max_readers itself
+    std::vector<std::size_t> reader_counts;
+    for (std::size_t readers = 1; readers < max_readers; readers *= 2) {
+        reader_counts.push_back(readers);
+    }
+    reader_counts.push_back(max_readers);
+
+    for (auto readers : reader_counts) {
+        auto suffix = std::to_string(readers) + " readers";
+        bench::report("rcu_list " + suffix, readers * traversals, run<rcu_table>(readers, traversals, elements));
+        bench::report("list + shared_mutex " + suffix, readers * traversals, run<locked_list>(readers, traversals, elements));
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file bench_sharded_list.cpp
+ * @brief Multi-threaded appends to saxion::sharded_list compared with one saxion::list behind a mutex
+ *
+ * Every thread appends events while a flusher thread drains everything every 100 microseconds.
+ *
+ * Usage: bench_sharded_list [threads] [events per thread]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+#include "sharded_list.h"
+
+namespace {
+
+    struct event {
+        std::size_t timestamp;
+        std::size_t payload;
+    };
+
+    /// the baseline: one log behind one lock
+    class locked_log {
+        std::mutex mutex_;
+        saxion::list<event> list_;
+
+    public:
+        void push_back(const event& e) {
+            std::lock_guard lock{mutex_};
+            list_.push_back(e);
+        }
+
+        saxion::list<event> drain() {
+            saxion::list<event> out;
+            std::lock_guard lock{mutex_};
+            out.splice(out.end(), list_);
+            return out;
+        }
+    };
+
+    template<typename Log>
+    double run(Log& log, std::size_t threads, std::size_t events) {
+        std::atomic<bool> done{false};
+        std::size_t flushed = 0;
+        std::thread flusher([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                flushed += log.drain().size();
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+
+        auto ns = bench::time_ns([&] {
+            std::vector<std::thread> appenders;
+            for (std::size_t id = 0; id < threads; ++id) {
+                appenders.emplace_back([&log, events] {
+                    for (std::size_t i = 0; i < events; ++i) {
+                        log.push_back(event{i, i * 3});
+                    }
+                });
+            }
+            for (auto& appender : appenders) {
+                appender.join();
+            }
+        });
+        done = true;
+        flusher.join();
+        flushed += log.drain().size();
+        bench::do_not_optimize(flushed);
+        return ns;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto threads = bench::arg_or(argc, argv, 1, std::max(1U, std::thread::hardware_concurrency()));
+    auto events = bench::arg_or(argc, argv, 2, 1'000'000);
+
+    std::cout << threads << " threads appending " << events << " events each:\n";
+    saxion::sharded_list<event> sharded(threads);
+    bench::report("sharded_list", threads * events, run(sharded, threads, events));
+    locked_log locked;
+    bench::report("list + mutex", threads * events, run(locked, threads, events));
+
+    for (std::size_t i = 0; i < 1000; ++i) {
+        sharded.push_back(event{i, 0});
+    }
+    bench::report("sharded_list drain_merged", 1000, bench::time_ns([&] {
+        bench::do_not_optimize(sharded.drain_merged(std::less<>{}, &event::timestamp).size());
+    }));
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_shm_list.cpp
+ * @brief Handing records to another process through saxion::shm_list compared with a socket pair
+ *
+ * A forked child pops the records the parent pushes. The socket baseline writes every record with its own write().
+ *
+ * Usage: bench_shm_list [records] [capacity]
+ */
+
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+#include "shm_list.h"
+
+namespace {
+
+    struct record {
+        std::size_t id;
+        double values[6];
+    };
+
+    double run_shm(std::size_t records, std::size_t capacity) {
+        auto lst = saxion::shm_list<record>::anonymous(capacity);
+        return bench::time_ns([&] {
+            pid_t child = ::fork();
+            if (child == 0) {
+                std::size_t sum = 0;
+                for (std::size_t i = 0; i < records; ++i) {
+                    sum += lst.pop_front().id;
+                }
+                bench::do_not_optimize(sum);
+                ::_exit(0);
+            }
+            for (std::size_t i = 0; i < records; ++i) {
+                lst.push_back(record{i, {}});
+            }
+            ::waitpid(child, nullptr, 0);
+        });
+    }
+
+    /// the baseline: one write() and one read() of the bytes of every record
+    double run_socket(std::size_t records) {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            return 0;
+        }
+        auto ns = bench::time_ns([&] {
+            pid_t child = ::fork();
+            if (child == 0) {
+                ::close(fds[0]);
+                std::size_t sum = 0;
+                record r{};
+                for (std::size_t i = 0; i < records; ++i) {
+                    std::size_t got = 0;
+                    while (got < sizeof(r)) {
+                        auto n = ::read(fds[1], reinterpret_cast<char*>(&r) + got, sizeof(r) - got);
+                        if (n <= 0) {
+                            ::_exit(1);
+                        }
+                        got += static_cast<std::size_t>(n);
+                    }
+                    sum += r.id;
+                }
+                bench::do_not_optimize(sum);
+                ::_exit(0);
+            }
+            for (std::size_t i = 0; i < records; ++i) {
+                record r{i, {}};
+                if (::write(fds[0], &r, sizeof(r)) != static_cast<ssize_t>(sizeof(r))) {
+                    break;
+                }
+            }
+            ::waitpid(child, nullptr, 0);
+        });
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return ns;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto records = bench::arg_or(argc, argv, 1, 1'000'000);
+    auto capacity = bench::arg_or(argc, argv, 2, 4096);
+
+    std::cout << records << " records of " << sizeof(record) << " bytes to a child process:\n";
+    bench::report("shm_list, capacity " + std::to_string(capacity), records, run_shm(records, capacity));
+    bench::report("socketpair", records, run_socket(records));
+}
@@ -0,0 +1,204 @@
+/**
+ * @file bench_soak.cpp
+ * @brief Tail latency of the operations of saxion::list under a long mixed workload
+ *
+ * A random mix of pushes, pops, inserts and erases makes the list grow and shrink, now and then the list is
+ * copied into another one (operator=), cleared or destroyed, which on a big list are the operations that stall.
+ * Every operation is timed on its own and recorded in a latency histogram, the percentiles show the stalls that
+ * an average hides.
+ *
+ * The workload runs in two configurations:
+ *  - string: std::string elements too long for the small string buffer, so nearly every operation allocates
+ *    or frees memory (allocator heavy);
+ *  - int_reserved: int elements in lists that reserved their nodes up front, so no operation calls the
+ *    allocator, except for rebuilding the pool after a destroy, which isn't timed.
+ *
+ * Usage: bench_soak [seconds per configuration] [max size] [json file] [csv file]
+ */
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "bench_util.h"
+#include "list.h"
+
+namespace {
+
+    enum class op {
+        push_back, push_front, pop_back, pop_front, insert, erase, assign, clear, destroy, count
+    };
+
+    constexpr const char* op_names[] = {
+        "push_back", "push_front", "pop_back", "pop_front", "insert", "erase", "operator=", "clear", "~list"
+    };
+
+    /// xorshift64*, cheap enough not to show up in the latencies
+    class xorshift {
+        std::uint64_t state_;
+
+    public:
+        explicit xorshift(std::uint64_t seed) :
+            state_{seed}
+        {}
+
+        std::uint64_t operator()() {
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * 0x2545F4914F6CDD1DULL;
+        }
+    };
+
+    template<typename T>
+    T make(std::uint64_t i) {
+        if constexpr (std::is_same_v<T, int>) {
+            return static_cast<int>(i);
+        } else {
+            return "soak test element number " + std::to_string(i);
+        }
+    }
+
+    template<typename T>
+    class soak {
+        using clock = std::chrono::steady_clock;
+
+        std::size_t max_size_;
+        bool reserved_;
+        saxion::list<T> list_{};
+        saxion::list<T> copy_{};
+        xorshift rng_{0x5eed};
+        bench::histogram histograms_[static_cast<std::size_t>(op::count)]{};
+
+        template<typename F>
+        void timed(op o, F&& fn) {
+            auto start = clock::now();
+            fn();
+            auto stop = clock::now();
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+            histograms_[static_cast<std::size_t>(o)].record(static_cast<std::uint64_t>(ns));
+        }
+
+        void reserve() {
+            if (reserved_) {
+                list_.reserve(max_size_);
+                copy_.reserve(max_size_);
+            }
+        }
+
+        /// a position near the front, so that finding it costs little next to the operation itself
+        typename saxion::list<T>::iterator near_front() {
+            return std::next(list_.begin(), static_cast<std::ptrdiff_t>(std::min<std::size_t>(list_.size(), rng_() % 8)));
+        }
+
+        void step() {
+            auto r = rng_() % 1'000'000;
+            auto value = make<T>(r);
+            // growing more often than shrinking, so that the list gets big between two clears
+            if (r < 650'000) {
+                if (list_.size() >= max_size_) {
+                    timed(op::clear, [&] { list_.clear(); });
+                } else if (r < 300'000) {
+                    timed(op::push_back, [&] { list_.push_back(std::move(value)); });
+                } else if (r < 550'000) {
+                    timed(op::push_front, [&] { list_.push_front(std::move(value)); });
+                } else {
+                    auto pos = near_front();
+                    timed(op::insert, [&] { list_.insert(pos, std::move(value)); });
+                }
+            } else if (r < 999'970) {
+                if (list_.empty()) {
+                    return;
+                }
+                if (r < 800'000) {
+                    timed(op::pop_back, [&] { list_.pop_back(); });
+                } else if (r < 950'000) {
+                    timed(op::pop_front, [&] { list_.pop_front(); });
+                } else {
+                    auto pos = near_front();
+                    if (pos == list_.end()) {
+                        pos = list_.begin();
+                    }
+                    timed(op::erase, [&] { list_.erase(pos); });
+                }
+            } else if (r < 999'980) {
+                timed(op::assign, [&] { copy_ = list_; });
+            } else if (r < 999'990) {
+                timed(op::clear, [&] { list_.clear(); });
+            } else {
+                auto doomed = new saxion::list<T>(std::move(list_));
+                timed(op::destroy, [&] { delete doomed; });
+                reserve();
+            }
+        }
+
+    public:
+        soak(std::size_t max_size, bool reserved) :
+            max_size_{max_size},
+            reserved_{reserved}
+        {
+            reserve();
+        }
+
+        void run(std::chrono::seconds duration) {
+            auto stop = clock::now() + duration;
+            while (clock::now() < stop) {
+                // checking the clock every step would double the work of the cheap operations
+                for (int i = 0; i < 1024; ++i) {
+                    step();
+                }
+            }
+        }
+
+        void report(const std::string& config, bench::results& results) const {
+            std::cout << config << ":\n"
+                      << std::left << std::setw(12) << "operation" << std::right << std::setw(12) << "count"
+                      << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+                      << std::setw(12) << "max" << std::setw(12) << "mean (ns)\n";
+            for (std::size_t i = 0; i < static_cast<std::size_t>(op::count); ++i) {
+                const auto& h = histograms_[i];
+                std::cout << std::left << std::setw(12) << op_names[i] << std::right << std::setw(12) << h.count()
+                          << std::setw(10) << h.percentile(50) << std::setw(10) << h.percentile(99)
+                          << std::setw(10) << h.percentile(99.9) << std::setw(12) << h.max()
+                          << std::setw(11) << std::fixed << std::setprecision(1) << h.mean() << '\n';
+                results.add()
+                        .label("config", config)
+                        .label("operation", op_names[i])
+                        .value("count", static_cast<double>(h.count()))
+                        .value("p50_ns", static_cast<double>(h.percentile(50)))
+                        .value("p99_ns", static_cast<double>(h.percentile(99)))
+                        .value("p999_ns", static_cast<double>(h.percentile(99.9)))
+                        .value("max_ns", static_cast<double>(h.max()))
+                        .value("mean_ns", h.mean());
+            }
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    auto seconds = std::chrono::seconds(bench::arg_or(argc, argv, 1, 10));
+    auto max_size = bench::arg_or(argc, argv, 2, 1'000'000);
+
+    bench::results results("bench_soak");
+    {
+        soak<std::string> s(max_size, false);
+        s.run(seconds);
+        s.report("string", results);
+    }
+    {
+        soak<int> s(max_size, true);
+        s.run(seconds);
+        s.report("int_reserved", results);
+    }
+
+    if (argc > 3) {
+        std::ofstream out(argv[3]);
+        results.write_json(out);
+    }
+    if (argc > 4) {
+        std::ofstream out(argv[4]);
+        results.write_csv(out);
+    }
+}
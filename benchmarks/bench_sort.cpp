@@ -0,0 +1,54 @@
+/**
+ * @file bench_sort.cpp
+ * @brief Compares list::sort with copying the elements into a std::vector, sorting and rebuilding the list
+ *
+ * Usage: bench_sort [number of elements]
+ */
+
+#include <algorithm>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+
+namespace {
+
+    std::vector<int> random_values(std::size_t n) {
+        std::mt19937 gen(42);
+        std::vector<int> values(n);
+        for (auto& v : values) {
+            v = static_cast<int>(gen());
+        }
+        return values;
+    }
+
+    template<typename List>
+    void run(const std::string& name, const std::vector<int>& values) {
+        auto n = values.size();
+        {
+            List lst(values.begin(), values.end());
+            bench::report(name + " copy, sort, rebuild", n, bench::time_ns([&lst] {
+                std::vector<int> copy(lst.begin(), lst.end());
+                std::stable_sort(copy.begin(), copy.end());
+                lst = List(copy.begin(), copy.end());
+            }));
+            bench::do_not_optimize(lst.front());
+        }
+        {
+            List lst(values.begin(), values.end());
+            bench::report(name + " sort()", n, bench::time_ns([&lst] { lst.sort(); }));
+            bench::do_not_optimize(lst.front());
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    auto n = bench::arg_or(argc, argv, 1, 10'000'000);
+    auto values = random_values(n);
+
+    std::cout << "Sorting " << n << " random ints:\n";
+    run<std::list<int>>("std::list", values);
+    run<saxion::list<int>>("saxion::list", values);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file bench_unrolled_list.cpp
+ * @brief Compares the scan and insertion throughput of saxion::unrolled_list with saxion::list and std::vector
+ *
+ * Usage: bench_unrolled_list [number of elements]
+ */
+
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+#include "unrolled_list.h"
+
+namespace {
+
+    template<typename Container>
+    Container filled(std::size_t n) {
+        Container c;
+        for (std::size_t i = 0; i < n; ++i) {
+            c.push_back(static_cast<int>(i));
+        }
+        return c;
+    }
+
+    template<typename Container>
+    void run(const std::string& name, std::size_t n) {
+        auto c = filled<Container>(n);
+        bench::report(name + " scan", n, bench::best_of_ns(5, [&c] {
+            bench::do_not_optimize(std::accumulate(c.begin(), c.end(), 0L));
+        }));
+
+        // insert in the middle, the position is found once and reused
+        auto inserts = n / 10;
+        bench::report(name + " insert in the middle", inserts, bench::time_ns([&c, n, inserts] {
+            auto pos = std::next(c.begin(), static_cast<std::ptrdiff_t>(n / 2));
+            for (std::size_t i = 0; i < inserts; ++i) {
+                pos = c.insert(pos, static_cast<int>(i));
+            }
+        }));
+        bench::do_not_optimize(c.size());
+    }
+}
+
+int main(int argc, char** argv) {
+    auto n = bench::arg_or(argc, argv, 1, 1'000'000);
+
+    std::cout << "unrolled_list<int> chunk capacity: " << saxion::unrolled_list<int>::chunk_capacity << "\n";
+    std::cout << "Throughput with " << n << " elements:\n";
+    run<std::vector<int>>("std::vector", n);
+    run<saxion::list<int>>("saxion::list", n);
+    run<saxion::unrolled_list<int>>("saxion::unrolled_list", n);
+}
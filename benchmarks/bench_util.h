@@ -0,0 +1,263 @@
+#ifndef BENCHMARKS_BENCH_UTIL_H
+#define BENCHMARKS_BENCH_UTIL_H
+
+/**
+ * @file bench_util.h
+ * @brief Small helpers shared by the benchmark executables
+ */
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+    /**
+     * @brief Prevents the compiler from optimizing away the computation of value
+     */
+    template<typename T>
+    inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Runs fn once and returns the elapsed time in nanoseconds
+     */
+    template<typename F>
+    [[nodiscard]]
+    double time_ns(F&& fn) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+    /**
+     * @brief Runs fn reps times and returns the fastest run in nanoseconds
+     */
+    template<typename F>
+    [[nodiscard]]
+    double best_of_ns(int reps, F&& fn) {
+        auto best = time_ns(fn);
+        while (--reps > 0) {
+            auto t = time_ns(fn);
+            best = t < best ? t : best;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Reads an unsigned number from argv[index], or returns the default value
+     */
+    [[nodiscard]]
+    inline std::size_t arg_or(int argc, char** argv, int index, std::size_t default_value) {
+        return index < argc ? static_cast<std::size_t>(std::strtoull(argv[index], nullptr, 10)) : default_value;
+    }
+
+    /**
+     * @brief Prints one result row: name, time per operation and throughput
+     */
+    inline void report(const std::string& name, std::size_t ops, double ns) {
+        auto per_op = ns / static_cast<double>(ops);
+        std::cout << std::left << std::setw(44) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << per_op << " ns/op"
+                  << std::setw(10) << std::setprecision(1) << (1e3 / per_op) << " Mops/s\n";
+    }
+
+    /**
+     * @brief Machine-readable results: rows of labels (strings) and values (numbers), written as JSON or CSV
+     *
+     * All the rows are expected to have the same columns, in the same order, so that the CSV has one header and
+     * two JSON files of the same benchmark can be diffed line by line.
+     */
+    class results {
+    public:
+        struct row {
+            std::vector<std::pair<std::string, std::string>> labels_;
+            std::vector<std::pair<std::string, double>> values_;
+
+            row& label(std::string name, std::string value) {
+                labels_.emplace_back(std::move(name), std::move(value));
+                return *this;
+            }
+
+            row& value(std::string name, double value) {
+                values_.emplace_back(std::move(name), value);
+                return *this;
+            }
+        };
+
+    private:
+        std::string benchmark_;
+        std::vector<row> rows_{};
+
+        static void write_string(std::ostream& out, const std::string& s) {
+            out << '"';
+            for (char c : s) {
+                if (c == '"' || c == '\\') {
+                    out << '\\';
+                }
+                out << c;
+            }
+            out << '"';
+        }
+
+    public:
+        explicit results(std::string benchmark) :
+            benchmark_{std::move(benchmark)}
+        {}
+
+        /// adds a row, to be filled with label() and value()
+        row& add() {
+            return rows_.emplace_back();
+        }
+
+        /// one object per line, so that the results of two versions diff well
+        void write_json(std::ostream& out) const {
+            out << "{\"benchmark\": ";
+            write_string(out, benchmark_);
+            out << ", \"results\": [\n";
+            for (std::size_t i = 0; i < rows_.size(); ++i) {
+                out << "  {";
+                const char* separator = "";
+                for (const auto& [name, label] : rows_[i].labels_) {
+                    out << separator;
+                    write_string(out, name);
+                    out << ": ";
+                    write_string(out, label);
+                    separator = ", ";
+                }
+                for (const auto& [name, value] : rows_[i].values_) {
+                    out << separator;
+                    write_string(out, name);
+                    out << ": " << std::setprecision(10) << std::defaultfloat << value;
+                    separator = ", ";
+                }
+                out << (i + 1 < rows_.size() ? "},\n" : "}\n");
+            }
+            out << "]}\n";
+        }
+
+        void write_csv(std::ostream& out) const {
+            if (rows_.empty()) {
+                return;
+            }
+            const char* separator = "";
+            for (const auto& column : rows_.front().labels_) {
+                out << separator << column.first;
+                separator = ",";
+            }
+            for (const auto& column : rows_.front().values_) {
+                out << separator << column.first;
+                separator = ",";
+            }
+            out << '\n';
+            for (const auto& r : rows_) {
+                separator = "";
+                for (const auto& column : r.labels_) {
+                    out << separator << column.second;
+                    separator = ",";
+                }
+                for (const auto& column : r.values_) {
+                    out << separator << std::setprecision(10) << std::defaultfloat << column.second;
+                    separator = ",";
+                }
+                out << '\n';
+            }
+        }
+    };
+
+    /**
+     * @brief Latency histogram in the style of HdrHistogram: log-linear buckets with a bounded relative error
+     *
+     * The values below 128 have a bucket each, above that every power of two is split into 64 buckets, so a
+     * recorded value is off by less than 1/64 (1.6%). The maximum is kept exactly.
+     */
+    class histogram {
+        static constexpr unsigned linear_bits = 7;
+        static constexpr std::uint64_t linear_count = 1U << linear_bits;
+        static constexpr std::uint64_t sub_count = linear_count / 2;
+
+        std::vector<std::uint64_t> counts_ = std::vector<std::uint64_t>(linear_count + 64 * sub_count);
+        std::uint64_t total_{};
+        std::uint64_t max_{};
+        double sum_{};
+
+        static std::size_t bucket(std::uint64_t value) {
+            if (value < linear_count) {
+                return value;
+            }
+            auto shift = static_cast<unsigned>(std::bit_width(value)) - linear_bits;
+            return linear_count + (shift - 1) * sub_count + ((value >> shift) - sub_count);
+        }
+
+        /// largest value that falls in the bucket
+        static std::uint64_t highest(std::size_t index) {
+            if (index < linear_count) {
+                return index;
+            }
+            auto shift = (index - linear_count) / sub_count + 1;
+            auto top = (index - linear_count) % sub_count + sub_count;
+            return ((top + 1) << shift) - 1;
+        }
+
+    public:
+        void record(std::uint64_t value) {
+            ++counts_[bucket(value)];
+            ++total_;
+            max_ = std::max(max_, value);
+            sum_ += static_cast<double>(value);
+        }
+
+        [[nodiscard]]
+        std::uint64_t count() const {
+            return total_;
+        }
+
+        [[nodiscard]]
+        std::uint64_t max() const {
+            return max_;
+        }
+
+        [[nodiscard]]
+        double mean() const {
+            return total_ ? sum_ / static_cast<double>(total_) : 0;
+        }
+
+        /**
+         * @brief Returns the value below which the given percentage of the recorded values fall
+         *
+         * @param percent between 0 and 100, e.g. 99.9
+         * @return the upper end of the bucket of that value, at most the maximum
+         */
+        [[nodiscard]]
+        std::uint64_t percentile(double percent) const {
+            auto rank = static_cast<std::uint64_t>(percent / 100 * static_cast<double>(total_) + 0.5);
+            rank = std::clamp<std::uint64_t>(rank, 1, std::max<std::uint64_t>(total_, 1));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < counts_.size(); ++i) {
+                seen += counts_[i];
+                if (seen >= rank) {
+                    return std::min(highest(i), max_);
+                }
+            }
+            return max_;
+        }
+    };
+}
+
+#endif //BENCHMARKS_BENCH_UTIL_H
@@ -0,0 +1,132 @@
+/**
+ * @file bench_work_stealing.cpp
+ * @brief Fork-join scheduling with saxion::work_stealing_deque compared with saxion::list behind a mutex
+ *
+ * The workload is the call tree of a naive fib(n): every task with n >= 2 spawns the tasks n - 1 and n - 2, the
+ * leaves add n to the result. Every worker runs its own tasks from the back and, when it runs out, steals half
+ * of the tasks of a random other worker.
+ *
+ * Usage: bench_work_stealing [workers] [n]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+#include "work_stealing_deque.h"
+
+namespace {
+
+    /// the baseline: the per-worker task lists the deque replaces
+    class locked_deque {
+        std::mutex mutex_;
+        saxion::list<int> list_;
+
+    public:
+        void push_back(int task) {
+            std::lock_guard lock{mutex_};
+            list_.push_back(task);
+        }
+
+        std::optional<int> pop_back() {
+            std::lock_guard lock{mutex_};
+            if (list_.empty()) {
+                return std::nullopt;
+            }
+            auto task = list_.back();
+            list_.pop_back();
+            return task;
+        }
+
+        std::size_t steal_half(locked_deque& into) {
+            saxion::list<int> stolen;
+            {
+                std::lock_guard lock{mutex_};
+                auto n = std::max<std::size_t>(1, list_.size() / 2);
+                for (std::size_t i = 0; i < n && !list_.empty(); ++i) {
+                    stolen.push_back(list_.front());
+                    list_.pop_front();
+                }
+            }
+            std::lock_guard lock{into.mutex_};
+            auto n = stolen.size();
+            into.list_.splice(into.list_.end(), stolen);
+            return n;
+        }
+    };
+
+    template<typename Deque>
+    double run(std::size_t workers, int n, long long& result) {
+        std::vector<Deque> deques(workers);
+        std::atomic<long long> sum{};
+        // tasks that were pushed and not finished yet
+        std::atomic<long long> pending{1};
+        deques[0].push_back(n);
+
+        auto ns = bench::time_ns([&] {
+            std::vector<std::thread> threads;
+            for (std::size_t id = 0; id < workers; ++id) {
+                threads.emplace_back([&, id] {
+                    auto& own = deques[id];
+                    std::mt19937 gen(static_cast<unsigned>(id));
+                    long long local_sum = 0;
+                    while (pending.load(std::memory_order_acquire) != 0) {
+                        auto task = own.pop_back();
+                        if (!task) {
+                            if (workers > 1) {
+                                auto victim = gen() % (workers - 1);
+                                deques[victim >= id ? victim + 1 : victim].steal_half(own);
+                            }
+                            continue;
+                        }
+                        if (*task < 2) {
+                            local_sum += *task;
+                        } else {
+                            pending.fetch_add(2, std::memory_order_relaxed);
+                            own.push_back(*task - 1);
+                            own.push_back(*task - 2);
+                        }
+                        pending.fetch_sub(1, std::memory_order_release);
+                    }
+                    sum += local_sum;
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        result = sum;
+        return ns;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto workers = bench::arg_or(argc, argv, 1, std::max(1U, std::thread::hardware_concurrency()));
+    auto n = static_cast<int>(bench::arg_or(argc, argv, 2, 27));
+
+    // number of tasks of fib(n): 2 * fib(n + 1) - 1
+    long long a = 0;
+    long long b = 1;
+    for (int i = 0; i < n + 1; ++i) {
+        b = std::exchange(a, b) + b;
+    }
+    auto tasks = static_cast<std::size_t>(2 * a - 1);
+
+    std::cout << "fib(" << n << ") with " << workers << " workers, " << tasks << " tasks:\n";
+    long long result = 0;
+    bench::report("work_stealing_deque", tasks, run<saxion::work_stealing_deque<int>>(workers, n, result));
+    auto expected = result;
+    bench::report("list + mutex", tasks, run<locked_deque>(workers, n, result));
+    if (result != expected) {
+        std::cout << "results differ: " << expected << " and " << result << '\n';
+        return 1;
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file list_replay.cpp
+ * @brief Replays a trace recorded with saxion::recorded_list against saxion::list and the standard containers
+ *
+ * For every container and element type (int, and a std::string that doesn't fit the small string buffer) the
+ * trace is replayed a few times, the fastest replay and the allocations it made are reported. Without a trace
+ * file a sample workload is recorded first (a bounded queue that now and then inserts in the middle), and saved as
+ * list_replay_sample.trace.
+ *
+ * Usage: list_replay [trace file] [repetitions] [json file]
+ */
+
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "list.h"
+#include "list_trace.h"
+
+namespace {
+
+    std::size_t allocations = 0;
+    std::size_t allocated_bytes = 0;
+
+    saxion::list_trace sample_trace() {
+        saxion::list_trace trace;
+        saxion::recorded_list<int> lst;
+        lst.observer().attach(trace);
+        for (int i = 0; i < 200'000; ++i) {
+            lst.push_back(i);
+            while (lst.size() > 1000) {
+                lst.pop_front();
+            }
+            if (i % 100 == 0) {
+                lst.insert(std::next(lst.begin(), static_cast<long>(lst.size() / 2)), 10, i);
+            }
+            if (i % 20'000 == 0) {
+                auto snapshot = lst;
+                bench::do_not_optimize(snapshot.size());
+            }
+        }
+        lst.clear();
+        return trace;
+    }
+
+    template<typename Container, typename MakeValue>
+    void run(const saxion::list_trace& trace, std::size_t repetitions, const char* container, const char* type,
+             MakeValue make_value, bench::results& results) {
+        double best = 0;
+        std::size_t calls = 0;
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; i < repetitions; ++i) {
+            auto allocations_before = allocations;
+            auto bytes_before = allocated_bytes;
+            auto ns = bench::time_ns([&] {
+                Container c;
+                saxion::replay(trace, c, make_value);
+            });
+            if (i == 0 || ns < best) {
+                best = ns;
+            }
+            calls = allocations - allocations_before;
+            bytes = allocated_bytes - bytes_before;
+        }
+
+        std::cout << std::left << std::setw(16) << container << std::setw(8) << type
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(12) << best / 1e6 << " ms"
+                  << std::setw(14) << calls << " allocations" << std::setw(12) << std::setprecision(1)
+                  << static_cast<double>(bytes) / (1 << 20) << " MiB\n";
+        results.add()
+                .label("container", container)
+                .label("type", type)
+                .value("ms", best / 1e6)
+                .value("allocations", static_cast<double>(calls))
+                .value("allocated_bytes", static_cast<double>(bytes));
+    }
+
+    template<typename T, typename MakeValue>
+    void run_type(const saxion::list_trace& trace, std::size_t repetitions, const char* type, MakeValue make_value,
+                  bench::results& results) {
+        run<saxion::list<T>>(trace, repetitions, "saxion::list", type, make_value, results);
+        run<std::list<T>>(trace, repetitions, "std::list", type, make_value, results);
+        run<std::deque<T>>(trace, repetitions, "std::deque", type, make_value, results);
+        run<std::vector<T>>(trace, repetitions, "std::vector", type, make_value, results);
+    }
+}
+
+// counts every allocation of the replays
+void* operator new(std::size_t size) {
+    ++allocations;
+    allocated_bytes += size;
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// GCC takes the free() below for the release of memory from the standard operator new
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    saxion::list_trace trace;
+    if (argc > 1) {
+        trace = saxion::list_trace::load(argv[1]);
+    } else {
+        trace = sample_trace();
+        trace.save("list_replay_sample.trace");
+        std::cout << "no trace given, recorded a sample workload in list_replay_sample.trace\n";
+    }
+    auto repetitions = std::max<std::size_t>(bench::arg_or(argc, argv, 2, 3), 1);
+
+    std::cout << trace.size() << " operations, " << trace.bytes() << " bytes:\n";
+    bench::results results("list_replay");
+    run_type<int>(trace, repetitions, "int", [](std::size_t n) { return static_cast<int>(n); }, results);
+    run_type<std::string>(trace, repetitions, "string", [](std::size_t n) {
+        return "replayed element number " + std::to_string(n);
+    }, results);
+
+    if (argc > 3) {
+        std::ofstream out(argv[3]);
+        results.write_json(out);
+    }
+}
@@ -0,0 +1,328 @@
+#ifndef INCLUDE_ASYNC_CHANNEL_H
+#define INCLUDE_ASYNC_CHANNEL_H
+
+/**
+ * @file async_channel.h
+ * @brief Channel between coroutines, buffered in a saxion::list
+ */
+
+#include <coroutine>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "executor.h"
+#include "intrusive_list.h"
+#include "list.h"
+
+namespace saxion {
+
+    /**
+     * @brief FIFO channel for coroutines, optionally bounded
+     *
+     * co_await pop() suspends the consumer while the channel is empty, co_await push() suspends the producer while
+     * the buffer is full. A suspended coroutine is queued in the channel itself (an intrusive list of the awaiters,
+     * which live in the coroutine frames) and is posted to the executor of the channel as soon as its operation
+     * completed, so there is no polling and a coroutine is woken only when it can go on.
+     *
+     * An element given to a waiting consumer skips the buffer. With a capacity of 0 the channel is unbuffered:
+     * every push waits for a consumer to take its element.
+     *
+     * All operations may be used from coroutines running on different threads.
+     *
+     * @tparam T type of the elements
+     * @tparam Allocator allocator of the buffer
+     * @tparam Observer observer of the buffer and of the lists filled by pop_batch()
+     */
+    template<typename T, typename Allocator = std::allocator<T>, typename Observer = list_observer>
+    class async_channel {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using list_type = list<T, Allocator, Observer>;
+
+        /// capacity of a channel that never makes a producer wait
+        static constexpr size_type unbounded = std::numeric_limits<size_type>::max();
+
+    private:
+        /// a suspended pop() or pop_batch()
+        struct consumer : intrusive_list_hook {
+            std::coroutine_handle<> handle_{};
+            std::optional<T> value_{};
+            /// receives the elements instead of value_ for pop_batch()
+            list_type* batch_{};
+
+            void deliver(T&& value) {
+                if (batch_) {
+                    batch_->push_back(std::move(value));
+                } else {
+                    value_.emplace(std::move(value));
+                }
+            }
+        };
+
+        /// a suspended push()
+        struct producer : intrusive_list_hook {
+            std::coroutine_handle<> handle_{};
+            T value_;
+            bool pushed_{};
+        };
+
+        executor& executor_;
+        size_type capacity_;
+
+        std::mutex mutex_{};
+        list_type buffer_;
+        intrusive_base_list<consumer> consumers_{};
+        intrusive_base_list<producer> producers_{};
+        bool closed_{};
+
+        /// resumes a waiting producer whose element was taken, the lock must be held
+        void release_producer(producer& p) {
+            producers_.remove(p);
+            p.pushed_ = true;
+            // the awaiter lives in the coroutine frame: don't touch it after posting
+            executor_.post(p.handle_);
+        }
+
+        /**
+         * @brief Hands up to n elements to c, the lock must be held
+         *
+         * An element leaves the buffer, and a producer is released, only after it was delivered or buffered. If that
+         * throws, the exception goes to the consumer and the element stays in the buffer or with its waiting producer.
+         *
+         * @return number of elements handed over
+         */
+        size_type take(consumer& c, size_type n) {
+            size_type count = 0;
+            for (; count < n && !buffer_.empty(); ++count) {
+                c.deliver(std::move(buffer_.front()));
+                buffer_.pop_front();
+            }
+            // refill the buffer from the waiting producers, or take directly from them if there is no buffer
+            while (!producers_.empty() && (buffer_.size() < capacity_ || count < n)) {
+                auto& p = producers_.front();
+                if (count < n && buffer_.empty()) {
+                    c.deliver(std::move(p.value_));
+                    ++count;
+                } else {
+                    buffer_.push_back(std::move(p.value_));
+                }
+                release_producer(p);
+            }
+            return count;
+        }
+
+        class pop_awaiter {
+            async_channel& channel_;
+            consumer consumer_{};
+
+        public:
+            explicit pop_awaiter(async_channel& channel) noexcept :
+                channel_{channel}
+            {}
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::lock_guard lock{channel_.mutex_};
+                if (channel_.take(consumer_, 1) != 0 || channel_.closed_) {
+                    return false;
+                }
+                consumer_.handle_ = handle;
+                channel_.consumers_.push_back(consumer_);
+                return true;
+            }
+
+            std::optional<T> await_resume() {
+                return std::move(consumer_.value_);
+            }
+        };
+
+        class pop_batch_awaiter {
+            async_channel& channel_;
+            consumer consumer_{};
+            size_type max_;
+            size_type before_;
+
+        public:
+            pop_batch_awaiter(async_channel& channel, list_type& out, size_type max) noexcept :
+                channel_{channel},
+                max_{max},
+                before_{out.size()} {
+                consumer_.batch_ = &out;
+            }
+
+            bool await_ready() const noexcept {
+                return max_ == 0;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::lock_guard lock{channel_.mutex_};
+                if (channel_.take(consumer_, max_) != 0 || channel_.closed_) {
+                    return false;
+                }
+                consumer_.handle_ = handle;
+                channel_.consumers_.push_back(consumer_);
+                return true;
+            }
+
+            size_type await_resume() const noexcept {
+                return consumer_.batch_->size() - before_;
+            }
+        };
+
+        class push_awaiter {
+            async_channel& channel_;
+            producer producer_;
+
+        public:
+            push_awaiter(async_channel& channel, T&& value) :
+                channel_{channel},
+                producer_{{}, {}, std::move(value), false}
+            {}
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle) {
+                std::lock_guard lock{channel_.mutex_};
+                if (channel_.closed_) {
+                    return false;
+                }
+                producer_.pushed_ = true;
+                if (!channel_.consumers_.empty()) {
+                    // dequeue the consumer only once it has the element: if delivering throws it keeps waiting
+                    auto& c = channel_.consumers_.front();
+                    c.deliver(std::move(producer_.value_));
+                    channel_.consumers_.pop_front();
+                    channel_.executor_.post(c.handle_);
+                    return false;
+                }
+                if (channel_.buffer_.size() < channel_.capacity_) {
+                    channel_.buffer_.push_back(std::move(producer_.value_));
+                    return false;
+                }
+                producer_.pushed_ = false;
+                producer_.handle_ = handle;
+                channel_.producers_.push_back(producer_);
+                return true;
+            }
+
+            bool await_resume() const noexcept {
+                return producer_.pushed_;
+            }
+        };
+
+    public:
+
+        /**
+         * @brief Construct a new, empty channel
+         *
+         * @param exec executor the woken coroutines are posted to
+         * @param capacity maximum number of buffered elements, 0 for an unbuffered channel
+         * @param alloc allocator of the buffer
+         */
+        explicit async_channel(executor& exec, size_type capacity = unbounded, const Allocator& alloc = Allocator()) :
+            executor_{exec},
+            capacity_{capacity},
+            buffer_(alloc)
+        {}
+
+        // the waiting coroutines refer to the channel
+        async_channel(const async_channel&) = delete;
+        async_channel& operator=(const async_channel&) = delete;
+
+        /**
+         * @brief Takes the first element, waiting for one if the channel is empty
+         *
+         * @return awaitable returning the element, or an empty optional once the channel is closed and empty
+         */
+        [[nodiscard]]
+        pop_awaiter pop() noexcept {
+            return pop_awaiter{*this};
+        }
+
+        /**
+         * @brief Moves up to max elements to the end of out, waiting only if the channel is empty
+         *
+         * The elements are moved into the free nodes of out, so a list that is cleared and reused doesn't allocate.
+         *
+         * @param out list to append to, it must stay alive until the operation completed
+         * @param max maximum number of elements to take
+         * @return awaitable returning the number of elements taken, 0 once the channel is closed and empty
+         */
+        [[nodiscard]]
+        pop_batch_awaiter pop_batch(list_type& out, size_type max) noexcept {
+            return pop_batch_awaiter{*this, out, max};
+        }
+
+        /**
+         * @brief Appends an element, waiting while the buffer is full
+         *
+         * @param value element to append
+         * @return awaitable returning true if the element was pushed, false if the channel was closed
+         */
+        [[nodiscard]]
+        push_awaiter push(T value) {
+            return push_awaiter{*this, std::move(value)};
+        }
+
+        /**
+         * @brief Closes the channel: waiting producers fail, waiting consumers get nothing
+         *
+         * The buffered elements can still be popped, further pushes fail.
+         */
+        void close() {
+            std::lock_guard lock{mutex_};
+            closed_ = true;
+            while (!consumers_.empty()) {
+                auto& c = consumers_.front();
+                consumers_.pop_front();
+                executor_.post(c.handle_);
+            }
+            while (!producers_.empty()) {
+                auto& p = producers_.front();
+                producers_.pop_front();
+                executor_.post(p.handle_);
+            }
+        }
+
+        /**
+         * @brief Number of buffered elements
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type size() {
+            std::lock_guard lock{mutex_};
+            return buffer_.size();
+        }
+
+        [[nodiscard]]
+        size_type capacity() const noexcept {
+            return capacity_;
+        }
+
+        [[nodiscard]]
+        bool closed() {
+            std::lock_guard lock{mutex_};
+            return closed_;
+        }
+    };
+
+    namespace pmr {
+        /// saxion::async_channel using a polymorphic allocator
+        template<typename T>
+        using async_channel = saxion::async_channel<T, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+#endif
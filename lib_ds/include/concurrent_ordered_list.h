@@ -0,0 +1,306 @@
+#ifndef INCLUDE_CONCURRENT_ORDERED_LIST_H
+#define INCLUDE_CONCURRENT_ORDERED_LIST_H
+
+/**
+ * @file concurrent_ordered_list.h
+ * @brief Lock-free sorted set based on a singly-linked list (Harris-Michael)
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "epoch.h"
+
+namespace saxion {
+
+    namespace detail {
+
+        /**
+         * @brief Link of a node of a concurrent ordered list
+         *
+         * The lowest bit of next_ is the deletion mark: a node whose next_ is marked is logically erased and
+         * about to be unlinked. Nodes are at least pointer aligned, so the bit is never part of the address.
+         */
+        struct concurrent_node_base {
+            std::atomic<std::uintptr_t> next_{};
+
+            static constexpr std::uintptr_t mark_bit = 1;
+
+            [[nodiscard]]
+            static concurrent_node_base* pointer(std::uintptr_t link) noexcept {
+                return reinterpret_cast<concurrent_node_base*>(link & ~mark_bit);
+            }
+
+            [[nodiscard]]
+            static bool is_marked(std::uintptr_t link) noexcept {
+                return link & mark_bit;
+            }
+
+            [[nodiscard]]
+            static std::uintptr_t link_to(const concurrent_node_base* node, bool marked = false) noexcept {
+                return reinterpret_cast<std::uintptr_t>(node) | (marked ? mark_bit : 0);
+            }
+
+            [[nodiscard]]
+            concurrent_node_base* next() const noexcept {
+                return pointer(next_.load(std::memory_order_acquire));
+            }
+        };
+
+        template<typename T>
+        struct concurrent_node : public concurrent_node_base {
+            T value_;
+
+            template<typename... Args>
+            explicit concurrent_node(Args&&... args) :
+                concurrent_node_base{},
+                value_(std::forward<Args>(args)...)
+            {}
+
+            /// deleter handed to the epoch domain
+            static void destroy(void* node) {
+                delete static_cast<concurrent_node*>(node);
+            }
+        };
+    }
+
+    /**
+     * @brief Lock-free sorted set
+     *
+     * The elements are kept in a sorted singly-linked list between a head and a tail sentinel, like the
+     * sentinel of saxion::list. insert(), erase() and contains() can be called from any number of threads at
+     * the same time. Erasing first marks the link of the node (logical deletion), then unlinks it; traversals
+     * that meet a marked node help unlinking it. Unlinked nodes are retired to the global epoch domain and
+     * freed only when no thread can still be reading them.
+     *
+     * contains() doesn't write to shared memory. All operations are O(n).
+     *
+     * @tparam T type of the elements
+     * @tparam Compare strict weak ordering of the elements
+     */
+    template<typename T, typename Compare = std::less<T>>
+    class concurrent_ordered_list {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using key_compare = Compare;
+
+    private:
+        using node_base_t = detail::concurrent_node_base;
+        using node_t = detail::concurrent_node<T>;
+
+        node_base_t head_{};
+        node_base_t tail_{};
+
+        [[no_unique_address]]
+        Compare less_{};
+
+        std::atomic<size_type> size_{};
+
+        struct position {
+            node_base_t* prev;
+            node_base_t* curr;
+            bool found;
+        };
+
+        [[nodiscard]]
+        epoch_domain& domain() const noexcept {
+            return epoch_domain::global();
+        }
+
+        [[nodiscard]]
+        static const T& value_of(node_base_t* node) noexcept {
+            return static_cast<node_t*>(node)->value_;
+        }
+
+        /**
+         * @brief Finds the first node not less than value, unlinking the marked nodes on the way
+         *
+         * @note The calling thread must be pinned.
+         */
+        template<typename K>
+        position search(const K& value) {
+            while (true) {
+                node_base_t* prev = &head_;
+                auto curr = prev->next();
+                bool restart = false;
+                while (curr != &tail_) {
+                    auto next = curr->next_.load(std::memory_order_acquire);
+                    if (node_base_t::is_marked(next)) {
+                        auto expected = node_base_t::link_to(curr);
+                        if (!prev->next_.compare_exchange_strong(expected, next & ~node_base_t::mark_bit,
+                                                                 std::memory_order_acq_rel, std::memory_order_acquire)) {
+                            // prev changed or got marked itself, start over from the head
+                            restart = true;
+                            break;
+                        }
+                        domain().retire(curr, &node_t::destroy);
+                        curr = node_base_t::pointer(next);
+                        continue;
+                    }
+                    if (!less_(value_of(curr), value)) {
+                        return {prev, curr, !less_(value, value_of(curr))};
+                    }
+                    prev = curr;
+                    curr = node_base_t::pointer(next);
+                }
+                if (!restart) {
+                    return {prev, curr, false};
+                }
+            }
+        }
+
+    public:
+
+        /**
+         * @brief Construct a new, empty set
+         *
+         * @param comp ordering of the elements
+         */
+        explicit concurrent_ordered_list(const Compare& comp = Compare()) :
+                less_(comp) {
+            head_.next_.store(node_base_t::link_to(&tail_), std::memory_order_relaxed);
+        }
+
+        // the nodes point to the sentinels
+        concurrent_ordered_list(const concurrent_ordered_list&) = delete;
+        concurrent_ordered_list& operator=(const concurrent_ordered_list&) = delete;
+
+        /**
+         * @brief Destroy the set, no other thread may be using it anymore
+         *
+         * @note Nodes that were already retired are freed by the epoch domain.
+         */
+        ~concurrent_ordered_list() {
+            auto curr = head_.next();
+            while (curr != &tail_) {
+                delete static_cast<node_t*>(std::exchange(curr, curr->next()));
+            }
+        }
+
+        /**
+         * @brief Inserts a value if no equivalent value is present
+         *
+         * @param args arguments passed to the constructor of the element
+         * @return true if the value was inserted
+         */
+        template<typename... Args>
+        bool emplace(Args&&... args) {
+            auto node = new node_t(std::forward<Args>(args)...);
+            auto guard = domain().pin();
+            while (true) {
+                auto [prev, curr, found] = search(node->value_);
+                if (found) {
+                    delete node;
+                    return false;
+                }
+                node->next_.store(node_base_t::link_to(curr), std::memory_order_relaxed);
+                auto expected = node_base_t::link_to(curr);
+                if (prev->next_.compare_exchange_strong(expected, node_base_t::link_to(node),
+                                                        std::memory_order_release, std::memory_order_relaxed)) {
+                    size_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+
+        bool insert(const T& value) {
+            return emplace(value);
+        }
+
+        bool insert(T&& value) {
+            return emplace(std::move(value));
+        }
+
+        /**
+         * @brief Erases the element equivalent to value
+         *
+         * @param value value to look for
+         * @return true if this call erased the element
+         */
+        template<typename K>
+        bool erase(const K& value) {
+            auto guard = domain().pin();
+            while (true) {
+                auto [prev, curr, found] = search(value);
+                if (!found) {
+                    return false;
+                }
+                auto next = curr->next_.load(std::memory_order_acquire);
+                if (node_base_t::is_marked(next)) {
+                    continue;
+                }
+                // logical deletion: once marked, no node can be linked after curr anymore
+                if (!curr->next_.compare_exchange_strong(next, next | node_base_t::mark_bit,
+                                                         std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    continue;
+                }
+                size_.fetch_sub(1, std::memory_order_relaxed);
+
+                auto expected = node_base_t::link_to(curr);
+                if (prev->next_.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                    domain().retire(curr, &node_t::destroy);
+                } else {
+                    // somebody changed prev, let a search unlink curr
+                    search(value);
+                }
+                return true;
+            }
+        }
+
+        /**
+         * @brief Checks if an element equivalent to value is present
+         *
+         * @param value value to look for
+         * @return true if found
+         */
+        template<typename K>
+        [[nodiscard]]
+        bool contains(const K& value) const {
+            auto guard = domain().pin();
+            auto curr = head_.next();
+            while (curr != &tail_ && less_(value_of(curr), value)) {
+                curr = curr->next();
+            }
+            return curr != &tail_ && !less_(value, value_of(curr)) &&
+                   !node_base_t::is_marked(curr->next_.load(std::memory_order_acquire));
+        }
+
+        /**
+         * @brief Calls f for every element, in order
+         *
+         * The elements inserted or erased during the traversal may or may not be visited.
+         *
+         * @param f function called with a const reference to every element
+         */
+        template<typename F>
+        void for_each(F f) const {
+            auto guard = domain().pin();
+            for (auto curr = head_.next(); curr != &tail_; curr = curr->next()) {
+                if (!node_base_t::is_marked(curr->next_.load(std::memory_order_acquire))) {
+                    f(value_of(curr));
+                }
+            }
+        }
+
+        /**
+         * @brief Number of elements, exact only when no other thread is modifying the set
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,432 @@
+#ifndef INCLUDE_CONCURRENT_QUEUE_H
+#define INCLUDE_CONCURRENT_QUEUE_H
+
+/**
+ * @file concurrent_queue.h
+ * @brief Multi-producer multi-consumer FIFO queue with separate head and tail locks
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "list.h"
+
+namespace saxion {
+
+    /**
+     * @brief Unbounded multi-producer multi-consumer FIFO queue
+     *
+     * The queue is a singly-linked chain of saxion::list nodes that starts with a dummy node (the two-lock queue
+     * of Michael and Scott). Producers only lock the tail and consumers only lock the head, so one producer and
+     * one consumer never wait for each other. The only link both sides touch, the next_ of the last node, is
+     * accessed through std::atomic_ref.
+     *
+     * Nodes are recycled: consumers hand the nodes they are done with to the producers through a few spare slots,
+     * taken with a single exchange, and push the rest on a lock-free stack. A push normally takes only the tail
+     * lock. A producer that finds the spare slots empty takes the pool lock once, pops the stack (or grows the
+     * pool) and refills the slots for the next producers. Values are constructed and moved out of the nodes
+     * outside the locks.
+     *
+     * @tparam T type of the elements
+     * @tparam Allocator allocator used for the elements (rebound to allocate the nodes)
+     */
+    template<typename T, typename Allocator = std::allocator<T>>
+    class concurrent_queue {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+
+    private:
+        using node_base_t = detail::list_node_base;
+        using node_t = detail::list_node<T>;
+
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using node_allocator_type = typename alloc_traits::template rebind_alloc<node_t>;
+        using node_alloc_traits = std::allocator_traits<node_allocator_type>;
+
+        static_assert(std::is_same_v<typename node_alloc_traits::pointer, node_t*>,
+                      "Allocators with fancy pointers are not supported");
+
+        using pool_t = detail::node_pool<node_t, node_allocator_type>;
+
+        // the two ends, the pool and the spare slots each live on their own cache line
+
+        struct alignas(64) {
+            std::mutex mutex_{};
+            node_base_t* node_{};
+        } head_;
+
+        struct alignas(64) {
+            std::mutex mutex_{};
+            node_base_t* node_{};
+        } tail_;
+
+        struct alignas(64) {
+            /// taken by producers that find no spare node: the stack has a single popper at a time, so no ABA
+            std::mutex mutex_{};
+            std::atomic<node_base_t*> recycled_{};
+            pool_t pool_;
+        } nodes_;
+
+        /// free nodes ready for the producers, an exchange takes one without a lock (and without ABA)
+        alignas(64) std::array<std::atomic<node_base_t*>, 8> spares_{};
+
+        /// number of elements, incremented before an element becomes visible so it never underflows
+        alignas(64) std::atomic<size_type> size_{};
+
+        [[nodiscard]]
+        static std::atomic_ref<node_base_t*> next_of(node_base_t* node) noexcept {
+            return std::atomic_ref<node_base_t*>(node->next_);
+        }
+
+        /// pops the recycle stack, the pool lock must be held
+        node_base_t* pop_recycled() noexcept {
+            auto top = nodes_.recycled_.load(std::memory_order_acquire);
+            while (top && !nodes_.recycled_.compare_exchange_weak(top, top->next_, std::memory_order_acquire,
+                                                                  std::memory_order_acquire)) {}
+            return top;
+        }
+
+        /// storage for a node: a spare or recycled one if possible
+        [[nodiscard]]
+        node_t* allocate_node() {
+            for (auto& slot : spares_) {
+                if (slot.load(std::memory_order_relaxed)) {
+                    if (auto node = slot.exchange(nullptr, std::memory_order_acquire)) {
+                        return static_cast<node_t*>(node);
+                    }
+                }
+            }
+
+            std::lock_guard lock{nodes_.mutex_};
+            auto node = pop_recycled();
+            for (auto& slot : spares_) {
+                if (slot.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+                auto spare = pop_recycled();
+                if (!spare) {
+                    break;
+                }
+                node_base_t* expected = nullptr;
+                if (!slot.compare_exchange_strong(expected, spare, std::memory_order_release, std::memory_order_relaxed)) {
+                    recycle(spare, spare);
+                }
+            }
+            if (node) {
+                return static_cast<node_t*>(node);
+            }
+            return nodes_.pool_.allocate();
+        }
+
+        /// gives a single node back: to an empty spare slot, or to the recycle stack
+        void recycle_one(node_base_t* node) noexcept {
+            for (auto& slot : spares_) {
+                node_base_t* expected = nullptr;
+                if (!slot.load(std::memory_order_relaxed) &&
+                    slot.compare_exchange_strong(expected, node, std::memory_order_release, std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+            recycle(node, node);
+        }
+
+        /// pushes the chain [first, last], linked through next_, on the recycle stack
+        void recycle(node_base_t* first, node_base_t* last) noexcept {
+            auto top = nodes_.recycled_.load(std::memory_order_relaxed);
+            do {
+                last->next_ = top;
+            } while (!nodes_.recycled_.compare_exchange_weak(top, first, std::memory_order_release,
+                                                             std::memory_order_relaxed));
+        }
+
+        template<typename... Args>
+        node_t* create_node(Args&&... args) {
+            auto node = allocate_node();
+            node_alloc_traits::construct(nodes_.pool_.allocator(), node);
+            try {
+                allocator_type value_alloc(nodes_.pool_.allocator());
+                alloc_traits::construct(value_alloc, std::addressof(node->value_), std::forward<Args>(args)...);
+            } catch (...) {
+                node_alloc_traits::destroy(nodes_.pool_.allocator(), node);
+                recycle_one(node);
+                throw;
+            }
+            node->next_ = nullptr;
+            return node;
+        }
+
+        /// moves the value out of a node that is the dummy now and destroys the value in the node
+        T take_value(node_base_t* node) {
+            auto value_node = static_cast<node_t*>(node);
+            T value(std::move(value_node->value_));
+            destroy_value(value_node);
+            return value;
+        }
+
+        void destroy_value(node_t* node) noexcept {
+            allocator_type value_alloc(nodes_.pool_.allocator());
+            alloc_traits::destroy(value_alloc, std::addressof(node->value_));
+        }
+
+        /// links a chain of nodes [first, last] after the tail
+        void link_back(node_base_t* first, node_base_t* last, size_type n) noexcept {
+            std::lock_guard lock{tail_.mutex_};
+            size_.fetch_add(n, std::memory_order_relaxed);
+            next_of(tail_.node_).store(first, std::memory_order_release);
+            tail_.node_ = last;
+        }
+
+        /// nodes unlinked from the head: the values of the nodes after dummy up to last are taken by the caller
+        struct unlinked {
+            node_base_t* dummy;
+            node_base_t* last;
+            size_type count;
+            /// value of last, the new dummy
+            std::optional<T> last_value;
+        };
+
+        /**
+         * @brief Unlinks up to n nodes from the head
+         *
+         * The last unlinked node becomes the new dummy. Its value is moved out while the head is still locked:
+         * as soon as the lock is released, the next consumer may recycle it.
+         *
+         * @param n maximum number of nodes to unlink
+         * @return the unlinked nodes
+         */
+        unlinked unlink_front(size_type n) {
+            std::lock_guard lock{head_.mutex_};
+            unlinked result{head_.node_, head_.node_, 0, std::nullopt};
+            while (result.count < n) {
+                auto next = next_of(result.last).load(std::memory_order_acquire);
+                if (!next) {
+                    break;
+                }
+                result.last = next;
+                ++result.count;
+            }
+            if (result.count != 0) {
+                result.last_value.emplace(take_value(result.last));
+                head_.node_ = result.last;
+            }
+            return result;
+        }
+
+        /// recycles the nodes from first up to, but excluding, last
+        void recycle_prefix(node_base_t* first, node_base_t* last) noexcept {
+            auto end = first;
+            while (end->next_ != last) {
+                end = end->next_;
+            }
+            recycle(first, end);
+        }
+
+        void notify_pushed(size_type n) noexcept {
+            if (n == 1) {
+                size_.notify_one();
+            } else {
+                size_.notify_all();
+            }
+        }
+
+    public:
+
+        /**
+         * @brief Construct a new, empty queue
+         *
+         * @param alloc allocator used for the elements and the nodes
+         */
+        explicit concurrent_queue(const Allocator& alloc = Allocator()) :
+                nodes_{.pool_ = pool_t(node_allocator_type(alloc))} {
+            auto dummy = nodes_.pool_.allocate();
+            node_alloc_traits::construct(nodes_.pool_.allocator(), dummy);
+            head_.node_ = tail_.node_ = dummy;
+        }
+
+        // the queue is shared between threads, it stays where it was created
+        concurrent_queue(const concurrent_queue&) = delete;
+        concurrent_queue& operator=(const concurrent_queue&) = delete;
+
+        /**
+         * @brief Destroy the queue, no other thread may be using it anymore
+         *
+         * @note The slabs are released as a whole, the nodes are visited only to destroy their values.
+         */
+        ~concurrent_queue() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (auto node = head_.node_->next_; node; node = node->next_) {
+                    destroy_value(static_cast<node_t*>(node));
+                }
+            }
+        }
+
+        /**
+         * @brief Appends an element constructed in place
+         *
+         * @param args arguments passed to the constructor of the element
+         */
+        template<typename... Args>
+        void emplace(Args&&... args) {
+            auto node = create_node(std::forward<Args>(args)...);
+            link_back(node, node, 1);
+            notify_pushed(1);
+        }
+
+        void push(const T& value) {
+            emplace(value);
+        }
+
+        void push(T&& value) {
+            emplace(std::move(value));
+        }
+
+        /**
+         * @brief Appends the elements of a range, they become visible to the consumers at once
+         *
+         * @param first begin of the range
+         * @param last end of the range
+         * @return number of elements pushed
+         */
+        template<typename Iter, typename = std::enable_if_t<
+                std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>>>
+        size_type push(Iter first, Iter last) {
+            node_base_t* chain_first = nullptr;
+            node_base_t* chain_last = nullptr;
+            size_type n = 0;
+            try {
+                for (; first != last; ++first, ++n) {
+                    auto node = create_node(*first);
+                    (chain_last ? chain_last->next_ : chain_first) = node;
+                    chain_last = node;
+                }
+            } catch (...) {
+                for (auto node = chain_first; node;) {
+                    auto next = node->next_;
+                    destroy_value(static_cast<node_t*>(node));
+                    recycle_one(node);
+                    node = next;
+                }
+                throw;
+            }
+            if (n != 0) {
+                link_back(chain_first, chain_last, n);
+                notify_pushed(n);
+            }
+            return n;
+        }
+
+        /**
+         * @brief Removes the first element, if there is one
+         *
+         * @return the element, or an empty optional if the queue was empty
+         */
+        std::optional<T> try_pop() {
+            auto taken = unlink_front(1);
+            if (taken.count != 0) {
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                recycle_one(taken.dummy);
+            }
+            return std::move(taken.last_value);
+        }
+
+        /**
+         * @brief Removes the first element, waits for one if the queue is empty
+         *
+         * @return the element
+         */
+        T pop() {
+            while (true) {
+                if (auto value = try_pop()) {
+                    return std::move(*value);
+                }
+                size_.wait(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Moves up to n elements to the end of a list, taking the head lock only once
+         *
+         * Except for the last one, the values are moved into out after the lock is released. out reserves room for
+         * the elements that are in the queue first, so that usually nothing is allocated while handing them over.
+         *
+         * @param out list the elements are appended to
+         * @param n maximum number of elements to remove
+         * @return number of elements moved to out, 0 if the queue was empty
+         */
+        template<typename OutAllocator, typename OutObserver>
+        size_type pop_n(list<T, OutAllocator, OutObserver>& out, size_type n) {
+            out.reserve(out.size() + std::min(n, size()));
+            auto [dummy, last, count, last_value] = unlink_front(n);
+            if (count == 0) {
+                return 0;
+            }
+            size_.fetch_sub(count, std::memory_order_relaxed);
+
+            // the nodes between the old dummy and the new one belong to this call only
+            auto node = dummy->next_;
+            try {
+                for (; node != last; node = node->next_) {
+                    out.push_back(std::move(static_cast<node_t*>(node)->value_));
+                    destroy_value(static_cast<node_t*>(node));
+                }
+                out.push_back(std::move(*last_value));
+            } catch (...) {
+                // the value of node was not moved from yet (or the move failed), so it is still alive
+                for (; node != last; node = node->next_) {
+                    destroy_value(static_cast<node_t*>(node));
+                }
+                recycle_prefix(dummy, last);
+                throw;
+            }
+            recycle_prefix(dummy, last);
+            return count;
+        }
+
+        /**
+         * @brief Number of elements, exact only when no other thread is using the queue
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Makes sure n elements can be queued without allocating
+         *
+         * @param n number of elements
+         */
+        void reserve(size_type n) {
+            std::lock_guard lock{nodes_.mutex_};
+            // one node is always taken by the dummy
+            nodes_.pool_.reserve(n + 1);
+        }
+
+        [[nodiscard]]
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(nodes_.pool_.allocator());
+        }
+    };
+
+    namespace pmr {
+        /// saxion::concurrent_queue using a polymorphic allocator
+        template<typename T>
+        using concurrent_queue = saxion::concurrent_queue<T, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+#endif
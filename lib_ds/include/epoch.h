@@ -0,0 +1,272 @@
+#ifndef INCLUDE_EPOCH_H
+#define INCLUDE_EPOCH_H
+
+/**
+ * @file epoch.h
+ * @brief Epoch based memory reclamation for the concurrent containers
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace saxion {
+
+    /**
+     * @brief Epoch based reclamation domain
+     *
+     * A thread pins the domain (epoch_domain::guard) for as long as it holds pointers to shared nodes. A node
+     * that was unlinked is retired instead of freed; it is freed only after the global epoch advanced twice,
+     * when no thread can be pinned in the epoch the node was retired in anymore.
+     *
+     * Every thread gets a record in the domain on first use. The records are never freed, they are reused by
+     * later threads. Nodes retired by a thread that exits are handed to the domain and freed by the next
+     * collection of any thread.
+     *
+     * @note A domain must outlive all the threads that used it, which is why the containers use global().
+     */
+    class epoch_domain {
+    public:
+        /// frees a retired pointer
+        using deleter_type = void (*)(void*);
+
+    private:
+        struct retired {
+            void* ptr;
+            deleter_type deleter;
+            std::uint64_t epoch;
+        };
+
+        /// per thread state, padded to a cache line so pinning doesn't cause false sharing
+        struct alignas(64) record {
+            /// (epoch << 1) | 1 while the thread is pinned, 0 otherwise
+            std::atomic<std::uint64_t> state{0};
+            std::atomic<bool> in_use{false};
+            record* next{};
+
+            // only used by the owning thread
+            std::size_t nesting{};
+            std::vector<retired> retired_nodes{};
+        };
+
+        /// number of retired nodes of a thread that triggers a collection
+        static constexpr std::size_t collect_threshold = 64;
+
+        std::atomic<std::uint64_t> epoch_{1};
+        std::atomic<record*> records_{};
+
+        std::mutex orphans_mutex_{};
+        std::vector<retired> orphans_{};
+
+        /// releases the records of the current thread when it exits
+        struct thread_registry {
+            std::vector<std::pair<epoch_domain*, record*>> entries;
+
+            ~thread_registry() {
+                for (auto [domain, rec] : entries) {
+                    domain->release(rec);
+                }
+            }
+        };
+
+        record* acquire() {
+            for (auto rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+                bool expected = false;
+                if (!rec->in_use.load(std::memory_order_relaxed) &&
+                    rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return rec;
+                }
+            }
+            auto rec = new record;
+            rec->in_use.store(true, std::memory_order_relaxed);
+            auto head = records_.load(std::memory_order_relaxed);
+            do {
+                rec->next = head;
+            } while (!records_.compare_exchange_weak(head, rec, std::memory_order_release, std::memory_order_relaxed));
+            return rec;
+        }
+
+        void release(record* rec) {
+            rec->state.store(0, std::memory_order_release);
+            rec->nesting = 0;
+            if (!rec->retired_nodes.empty()) {
+                std::lock_guard lock{orphans_mutex_};
+                orphans_.insert(orphans_.end(), rec->retired_nodes.begin(), rec->retired_nodes.end());
+                rec->retired_nodes.clear();
+            }
+            rec->in_use.store(false, std::memory_order_release);
+        }
+
+        /// the record of the calling thread
+        record& local() {
+            thread_local thread_registry registry;
+            for (auto [domain, rec] : registry.entries) {
+                if (domain == this) {
+                    return *rec;
+                }
+            }
+            auto rec = acquire();
+            registry.entries.emplace_back(this, rec);
+            return *rec;
+        }
+
+        /**
+         * @brief Advances the global epoch if every pinned thread has seen the current one
+         *
+         * @return the global epoch after the attempt
+         */
+        std::uint64_t try_advance() noexcept {
+            auto epoch = epoch_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (auto rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+                auto state = rec->state.load(std::memory_order_acquire);
+                if ((state & 1) && (state >> 1) != epoch) {
+                    return epoch;
+                }
+            }
+            if (epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel)) {
+                return epoch + 1;
+            }
+            return epoch;
+        }
+
+        /// frees the nodes retired at least two epochs before the given one, keeps the others
+        static void free_expired(std::vector<retired>& nodes, std::uint64_t epoch) {
+            std::size_t kept = 0;
+            for (auto& node : nodes) {
+                if (node.epoch + 2 <= epoch) {
+                    node.deleter(node.ptr);
+                } else {
+                    nodes[kept++] = node;
+                }
+            }
+            nodes.resize(kept);
+        }
+
+        void collect(record& rec) {
+            auto epoch = try_advance();
+            free_expired(rec.retired_nodes, epoch);
+
+            std::unique_lock lock{orphans_mutex_, std::try_to_lock};
+            if (lock.owns_lock() && !orphans_.empty()) {
+                free_expired(orphans_, epoch);
+            }
+        }
+
+    public:
+        /**
+         * @brief Keeps the calling thread pinned while it exists
+         *
+         * Guards can be nested, the thread is unpinned when the outermost guard is destroyed.
+         */
+        class guard {
+            record* rec_;
+
+        public:
+            explicit guard(epoch_domain& domain) :
+                rec_{&domain.local()} {
+                if (rec_->nesting++ == 0) {
+                    auto epoch = domain.epoch_.load(std::memory_order_relaxed);
+                    rec_->state.store((epoch << 1) | 1, std::memory_order_relaxed);
+                    // the announcement must be visible before any shared pointer is read
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+            }
+
+            guard(const guard&) = delete;
+            guard& operator=(const guard&) = delete;
+
+            ~guard() {
+                if (--rec_->nesting == 0) {
+                    rec_->state.store(0, std::memory_order_release);
+                }
+            }
+        };
+
+        epoch_domain() = default;
+
+        epoch_domain(const epoch_domain&) = delete;
+        epoch_domain& operator=(const epoch_domain&) = delete;
+
+        /**
+         * @brief Frees all the retired nodes, no thread may be using the domain anymore
+         */
+        ~epoch_domain() {
+            for (auto rec = records_.load(std::memory_order_acquire); rec;) {
+                for (auto& node : rec->retired_nodes) {
+                    node.deleter(node.ptr);
+                }
+                delete std::exchange(rec, rec->next);
+            }
+            for (auto& node : orphans_) {
+                node.deleter(node.ptr);
+            }
+        }
+
+        /**
+         * @brief The domain shared by all the concurrent containers
+         */
+        [[nodiscard]]
+        static epoch_domain& global() {
+            static epoch_domain domain;
+            return domain;
+        }
+
+        /**
+         * @brief Pins the calling thread
+         *
+         * @return guard that unpins the thread when destroyed
+         */
+        [[nodiscard]]
+        guard pin() {
+            return guard{*this};
+        }
+
+        /**
+         * @brief Frees ptr with deleter once no thread can reach it anymore
+         *
+         * @param ptr pointer to a node that is no longer reachable from the shared structure
+         * @param deleter function that frees the node
+         */
+        void retire(void* ptr, deleter_type deleter) {
+            auto& rec = local();
+            rec.retired_nodes.push_back({ptr, deleter, epoch_.load(std::memory_order_acquire)});
+            // collecting while pinned is fine: the own pin keeps the epoch from advancing past what we can see
+            if (rec.retired_nodes.size() >= collect_threshold) {
+                collect(rec);
+            }
+        }
+
+        /**
+         * @brief Waits until all the nodes retired so far by this thread (and by exited threads) are freed
+         *
+         * @note The calling thread must not be pinned. Other pinned threads delay the return.
+         */
+        void synchronize() {
+            auto& rec = local();
+            auto target = epoch_.load(std::memory_order_acquire) + 2;
+            while (try_advance() < target) {
+                std::this_thread::yield();
+            }
+            free_expired(rec.retired_nodes, target);
+            std::lock_guard lock{orphans_mutex_};
+            free_expired(orphans_, target);
+        }
+
+        /**
+         * @brief Number of nodes retired by the calling thread that are not freed yet
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]]
+        std::size_t pending() {
+            return local().retired_nodes.size();
+        }
+    };
+}
+
+#endif
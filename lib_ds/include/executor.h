@@ -0,0 +1,210 @@
+#ifndef INCLUDE_EXECUTOR_H
+#define INCLUDE_EXECUTOR_H
+
+/**
+ * @file executor.h
+ * @brief Minimal executors and a fire-and-forget coroutine type for the asynchronous containers
+ */
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "concurrent_queue.h"
+#include "list.h"
+
+namespace saxion {
+
+    /**
+     * @brief Something that resumes coroutines
+     */
+    class executor {
+    public:
+        /**
+         * @brief Schedules a suspended coroutine to be resumed
+         *
+         * @param handle coroutine to resume, it must not be resumed by anybody else
+         */
+        virtual void post(std::coroutine_handle<> handle) = 0;
+
+    protected:
+        ~executor() = default;
+    };
+
+    /**
+     * @brief Single-threaded executor: the coroutines run when the owner calls run() or run_one()
+     *
+     * post() may be called from any thread.
+     */
+    class manual_executor final : public executor {
+        std::mutex mutex_{};
+        list<std::coroutine_handle<>> ready_{};
+
+    public:
+        manual_executor() = default;
+
+        manual_executor(const manual_executor&) = delete;
+        manual_executor& operator=(const manual_executor&) = delete;
+
+        /**
+         * @brief Destroy the executor, the coroutines that are still scheduled are destroyed
+         */
+        ~manual_executor() {
+            for (auto handle : ready_) {
+                handle.destroy();
+            }
+        }
+
+        void post(std::coroutine_handle<> handle) override {
+            std::lock_guard lock{mutex_};
+            ready_.push_back(handle);
+        }
+
+        /**
+         * @brief Resumes the coroutine that was scheduled first, if any
+         *
+         * @return true if a coroutine was resumed
+         */
+        bool run_one() {
+            std::coroutine_handle<> handle;
+            {
+                std::lock_guard lock{mutex_};
+                if (ready_.empty()) {
+                    return false;
+                }
+                handle = ready_.front();
+                ready_.pop_front();
+            }
+            handle.resume();
+            return true;
+        }
+
+        /**
+         * @brief Resumes coroutines until none is scheduled anymore
+         *
+         * @return number of coroutines resumed
+         */
+        std::size_t run() {
+            std::size_t count = 0;
+            while (run_one()) {
+                ++count;
+            }
+            return count;
+        }
+    };
+
+    /**
+     * @brief Multi-threaded executor: a fixed number of threads resume the coroutines in FIFO order
+     */
+    class thread_pool_executor final : public executor {
+        concurrent_queue<std::coroutine_handle<>> ready_{};
+        std::vector<std::thread> threads_{};
+
+    public:
+        /**
+         * @brief Starts the threads
+         *
+         * @param thread_count number of threads, at least 1
+         */
+        explicit thread_pool_executor(std::size_t thread_count = std::max(1U, std::thread::hardware_concurrency())) {
+            for (std::size_t i = 0; i < std::max<std::size_t>(1, thread_count); ++i) {
+                threads_.emplace_back([this] {
+                    // an empty handle asks the thread to stop
+                    while (auto handle = ready_.pop()) {
+                        handle.resume();
+                    }
+                });
+            }
+        }
+
+        thread_pool_executor(const thread_pool_executor&) = delete;
+        thread_pool_executor& operator=(const thread_pool_executor&) = delete;
+
+        /**
+         * @brief Waits for the coroutines that were scheduled so far to be resumed and stops the threads
+         *
+         * @note Coroutines that are suspended on something else (e.g. a channel) are left alone, and so are the ones
+         *       posted while the pool is stopping.
+         */
+        ~thread_pool_executor() {
+            for (std::size_t i = 0; i < threads_.size(); ++i) {
+                ready_.push(std::coroutine_handle<>{});
+            }
+            for (auto& thread : threads_) {
+                thread.join();
+            }
+        }
+
+        void post(std::coroutine_handle<> handle) override {
+            ready_.push(handle);
+        }
+    };
+
+    /**
+     * @brief Coroutine that nobody waits for: it starts when spawned and frees itself when it finishes
+     *
+     * @note An exception escaping the coroutine terminates the program.
+     */
+    class detached_task {
+    public:
+        struct promise_type {
+            detached_task get_return_object() noexcept {
+                return detached_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {}
+
+            void unhandled_exception() noexcept {
+                std::terminate();
+            }
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+        explicit detached_task(std::coroutine_handle<promise_type> handle) noexcept :
+            handle_{handle}
+        {}
+
+        friend void spawn(executor& exec, detached_task task);
+
+    public:
+        detached_task(detached_task&& other) noexcept :
+            handle_{std::exchange(other.handle_, nullptr)}
+        {}
+
+        detached_task& operator=(detached_task&&) = delete;
+
+        /// a task that was never spawned is destroyed without running
+        ~detached_task() {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+    };
+
+    /**
+     * @brief Starts a detached task on an executor
+     *
+     * @param exec executor that runs the task until its first suspension
+     * @param task coroutine to start
+     */
+    inline void spawn(executor& exec, detached_task task) {
+        exec.post(std::exchange(task.handle_, nullptr));
+    }
+}
+
+#endif
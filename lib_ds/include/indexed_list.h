@@ -0,0 +1,1061 @@
+#ifndef INCLUDE_INDEXED_LIST_H
+#define INCLUDE_INDEXED_LIST_H
+
+/**
+ * @file indexed_list.h
+ * @brief Doubly-linked list with O(log n) positional access
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+
+namespace saxion {
+
+    template<typename T, typename Allocator>
+    class indexed_list;
+
+    namespace detail {
+
+        /**
+         * @brief Links of a node of an indexed list
+         *
+         * Every node is linked twice: in the usual doubly-linked list (prev_/next_), which gives O(1) iteration,
+         * and in an AVL tree ordered by position, whose subtree sizes give O(log n) positional access.
+         * The header of the list is the sentinel of both: its parent_ is the root of the tree and the
+         * root's parent_ is the header.
+         */
+        struct indexed_node_base : public list_node_base {
+            indexed_node_base* parent_{};
+            indexed_node_base* left_{};
+            indexed_node_base* right_{};
+
+            /// number of nodes in the subtree rooted at this node
+            std::size_t count_{};
+
+            /// height of the subtree rooted at this node, -1 marks the header
+            int height_{};
+
+            indexed_node_base() noexcept = default;
+
+            [[nodiscard]]
+            bool is_header() const noexcept {
+                return height_ < 0;
+            }
+        };
+
+        /**
+         * @brief Order statistics on the AVL tree of an indexed list
+         *
+         * All functions are O(log n).
+         */
+        struct indexed_tree {
+            [[nodiscard]]
+            static std::size_t size_of(const indexed_node_base* node) noexcept {
+                return node ? node->count_ : 0;
+            }
+
+            [[nodiscard]]
+            static int height_of(const indexed_node_base* node) noexcept {
+                return node ? node->height_ : 0;
+            }
+
+            /// the header of the tree that contains node
+            [[nodiscard]]
+            static indexed_node_base* header_of(indexed_node_base* node) noexcept {
+                while (!node->is_header()) {
+                    node = node->parent_;
+                }
+                return node;
+            }
+
+            /**
+             * @brief Position of a node in its list
+             *
+             * @param node a node or a header
+             * @return index of the node, or the size of the list for the header
+             */
+            [[nodiscard]]
+            static std::size_t index_of(const indexed_node_base* node) noexcept {
+                if (node->is_header()) {
+                    return size_of(node->parent_);
+                }
+                auto index = size_of(node->left_);
+                while (!node->parent_->is_header()) {
+                    if (node == node->parent_->right_) {
+                        index += size_of(node->parent_->left_) + 1;
+                    }
+                    node = node->parent_;
+                }
+                return index;
+            }
+
+            /**
+             * @brief Finds the node at the given position
+             *
+             * @param header header of the tree
+             * @param index position of the node
+             * @return the node, or the header if index is not smaller than the size
+             */
+            [[nodiscard]]
+            static indexed_node_base* select(indexed_node_base* header, std::size_t index) noexcept {
+                if (index >= size_of(header->parent_)) {
+                    return header;
+                }
+                auto node = header->parent_;
+                while (true) {
+                    auto left = size_of(node->left_);
+                    if (index < left) {
+                        node = node->left_;
+                    } else if (index == left) {
+                        return node;
+                    } else {
+                        index -= left + 1;
+                        node = node->right_;
+                    }
+                }
+            }
+
+            /**
+             * @brief Links a node before pos, in the list and in the tree
+             *
+             * @param header header of the tree
+             * @param node unlinked node
+             * @param pos node (or header) to insert before
+             */
+            static void insert_before(indexed_node_base* header, indexed_node_base* node, indexed_node_base* pos) noexcept {
+                node->left_ = nullptr;
+                node->right_ = nullptr;
+                node->count_ = 1;
+                node->height_ = 1;
+
+                if (!header->parent_) {
+                    header->parent_ = node;
+                    node->parent_ = header;
+                } else if (!pos->is_header() && !pos->left_) {
+                    pos->left_ = node;
+                    node->parent_ = pos;
+                } else {
+                    // the predecessor of pos is the rightmost node of its left subtree (or of the whole tree)
+                    auto pred = static_cast<indexed_node_base*>(pos->prev());
+                    pred->right_ = node;
+                    node->parent_ = pred;
+                }
+                node->hook_before(pos);
+                retrace(node->parent_);
+            }
+
+            /**
+             * @brief Unlinks a node from the list and from the tree
+             *
+             * @param node node to unlink
+             */
+            static void erase(indexed_node_base* node) noexcept {
+                indexed_node_base* fix;
+                if (node->left_ && node->right_) {
+                    // the successor has no left child, it takes the place of node
+                    auto succ = static_cast<indexed_node_base*>(node->next());
+                    if (succ->parent_ == node) {
+                        fix = succ;
+                    } else {
+                        fix = succ->parent_;
+                        replace_child(succ->parent_, succ, succ->right_);
+                        succ->right_ = node->right_;
+                        succ->right_->parent_ = succ;
+                    }
+                    succ->left_ = node->left_;
+                    succ->left_->parent_ = succ;
+                    replace_child(node->parent_, node, succ);
+                } else {
+                    fix = node->parent_;
+                    replace_child(node->parent_, node, node->left_ ? node->left_ : node->right_);
+                }
+                node->unhook();
+                retrace(fix);
+            }
+
+        private:
+            static void update(indexed_node_base* node) noexcept {
+                node->count_ = size_of(node->left_) + size_of(node->right_) + 1;
+                node->height_ = std::max(height_of(node->left_), height_of(node->right_)) + 1;
+            }
+
+            static void replace_child(indexed_node_base* parent, indexed_node_base* old_child, indexed_node_base* new_child) noexcept {
+                if (parent->is_header()) {
+                    parent->parent_ = new_child;
+                } else if (parent->left_ == old_child) {
+                    parent->left_ = new_child;
+                } else {
+                    parent->right_ = new_child;
+                }
+                if (new_child) {
+                    new_child->parent_ = parent;
+                }
+            }
+
+            static indexed_node_base* rotate_left(indexed_node_base* node) noexcept {
+                auto pivot = node->right_;
+                node->right_ = pivot->left_;
+                if (pivot->left_) {
+                    pivot->left_->parent_ = node;
+                }
+                replace_child(node->parent_, node, pivot);
+                pivot->left_ = node;
+                node->parent_ = pivot;
+                update(node);
+                update(pivot);
+                return pivot;
+            }
+
+            static indexed_node_base* rotate_right(indexed_node_base* node) noexcept {
+                auto pivot = node->left_;
+                node->left_ = pivot->right_;
+                if (pivot->right_) {
+                    pivot->right_->parent_ = node;
+                }
+                replace_child(node->parent_, node, pivot);
+                pivot->right_ = node;
+                node->parent_ = pivot;
+                update(node);
+                update(pivot);
+                return pivot;
+            }
+
+            /// restores the AVL balance of a subtree, returns its (new) root
+            static indexed_node_base* rebalance(indexed_node_base* node) noexcept {
+                update(node);
+                auto balance = height_of(node->left_) - height_of(node->right_);
+                if (balance > 1) {
+                    if (height_of(node->left_->left_) < height_of(node->left_->right_)) {
+                        rotate_left(node->left_);
+                    }
+                    return rotate_right(node);
+                }
+                if (balance < -1) {
+                    if (height_of(node->right_->right_) < height_of(node->right_->left_)) {
+                        rotate_right(node->right_);
+                    }
+                    return rotate_left(node);
+                }
+                return node;
+            }
+
+            /// updates the sizes and rebalances from node up to the root
+            static void retrace(indexed_node_base* node) noexcept {
+                while (!node->is_header()) {
+                    node = rebalance(node)->parent_;
+                }
+            }
+        };
+
+        /**
+         * @brief Sentinel and tree header of an indexed list
+         */
+        struct indexed_node_header : public indexed_node_base {
+
+            indexed_node_header() noexcept {
+                reset();
+            }
+
+            // the neighbours point to the header, so it can't be copied around
+            indexed_node_header(const indexed_node_header&) = delete;
+            indexed_node_header& operator=(const indexed_node_header&) = delete;
+
+            /**
+             * @brief Makes the header empty again
+             *
+             * @note The nodes linked to the header are not touched.
+             */
+            void reset() noexcept {
+                prev_ = this;
+                next_ = this;
+                parent_ = nullptr;
+                height_ = -1;
+            }
+
+            /**
+             * @brief Swaps the nodes of two headers
+             *
+             * @param other another header
+             */
+            void swap(indexed_node_header& other) noexcept {
+                std::swap(prev_, other.prev_);
+                std::swap(next_, other.next_);
+                std::swap(parent_, other.parent_);
+                relink();
+                other.relink();
+            }
+
+            [[nodiscard]]
+            std::size_t size() const noexcept {
+                return indexed_tree::size_of(parent_);
+            }
+
+        private:
+            /// makes the first, the last and the root node point back at this header (after a swap)
+            void relink() noexcept {
+                if (!parent_) {
+                    prev_ = this;
+                    next_ = this;
+                } else {
+                    next_->prev_ = this;
+                    prev_->next_ = this;
+                    parent_->parent_ = this;
+                }
+            }
+        };
+
+        /**
+         * @brief Node of an indexed list that contains a value
+         *
+         * @tparam T type of the value
+         */
+        template<typename T>
+        struct indexed_node : public indexed_node_base {
+
+            /// the value is constructed and destroyed by the owner of the node
+            union {
+                T value_;
+            };
+
+            /// constructs the links only, the value is left uninitialized
+            indexed_node() noexcept:
+                indexed_node_base{}
+            {}
+
+            indexed_node(const indexed_node&) = delete;
+            indexed_node& operator=(const indexed_node&) = delete;
+
+            ~indexed_node() requires std::is_trivially_destructible_v<T> = default;
+
+            /// doesn't destroy the value
+            ~indexed_node() {}
+
+            [[nodiscard]]
+            T& value() {
+                return value_;
+            }
+
+            [[nodiscard]]
+            T const& value() const {
+                return value_;
+            }
+        };
+
+        /**
+         * @brief Random access iterator of an indexed list
+         *
+         * Incrementing and decrementing follow the list links and are O(1); jumps and distances use the
+         * tree and are O(log n).
+         */
+        template<typename T, typename NodeT>
+        struct indexed_list_iterator {
+            template<typename, typename> friend
+            class ::saxion::indexed_list;
+
+            // the iterator walks the header as well, NodeT is the type of the nodes with a value
+            using node_t = indexed_node_base;
+
+            node_t* current_;
+
+            using value_type = T;
+            using reference = T&;
+            using pointer = T*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            indexed_list_iterator() noexcept:
+                current_{}
+            {}
+
+            explicit indexed_list_iterator(node_t* node) noexcept:
+                current_{node}
+            {}
+
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            indexed_list_iterator& operator++() noexcept {
+                current_ = static_cast<node_t*>(current_->next());
+                return *this;
+            }
+
+            indexed_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            indexed_list_iterator& operator--() noexcept {
+                current_ = static_cast<node_t*>(current_->prev());
+                return *this;
+            }
+
+            indexed_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            indexed_list_iterator& operator+=(difference_type n) noexcept {
+                if (n != 0) {
+                    auto index = static_cast<difference_type>(indexed_tree::index_of(current_)) + n;
+                    current_ = indexed_tree::select(indexed_tree::header_of(current_), static_cast<std::size_t>(index));
+                }
+                return *this;
+            }
+
+            indexed_list_iterator& operator-=(difference_type n) noexcept {
+                return *this += -n;
+            }
+
+            [[nodiscard]]
+            friend indexed_list_iterator operator+(indexed_list_iterator it, difference_type n) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend indexed_list_iterator operator+(difference_type n, indexed_list_iterator it) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend indexed_list_iterator operator-(indexed_list_iterator it, difference_type n) noexcept {
+                return it -= n;
+            }
+
+            [[nodiscard]]
+            friend difference_type operator-(const indexed_list_iterator& lhs, const indexed_list_iterator& rhs) noexcept {
+                return static_cast<difference_type>(indexed_tree::index_of(lhs.current_)) -
+                       static_cast<difference_type>(indexed_tree::index_of(rhs.current_));
+            }
+
+            [[nodiscard]]
+            reference operator[](difference_type n) const noexcept {
+                return *(*this + n);
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<NodeT*>(current_)->value();
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(static_cast<NodeT*>(current_)->value());
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const indexed_list_iterator& lhs, const indexed_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const indexed_list_iterator& lhs, const indexed_list_iterator& rhs) noexcept {
+                return lhs.current_ != rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend auto operator<=>(const indexed_list_iterator& lhs, const indexed_list_iterator& rhs) noexcept {
+                return indexed_tree::index_of(lhs.current_) <=> indexed_tree::index_of(rhs.current_);
+            }
+        };
+
+        template<typename T, typename NodeT>
+        struct const_indexed_list_iterator {
+            template<typename, typename> friend
+            class ::saxion::indexed_list;
+
+            // the iterator walks the header as well, NodeT is the type of the nodes with a value
+            using node_t = indexed_node_base;
+
+            node_t* current_;
+
+            using value_type = T;
+            using reference = T const&;
+            using pointer = T const*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            const_indexed_list_iterator() noexcept:
+                current_{}
+            {}
+
+            explicit const_indexed_list_iterator(node_t* node) noexcept:
+                current_{node}
+            {}
+
+            /// a non-const iterator can always be used where a const one is expected
+            const_indexed_list_iterator(const indexed_list_iterator<T, NodeT>& other) noexcept:
+                current_{other.current_}
+            {}
+
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            const_indexed_list_iterator& operator++() noexcept {
+                current_ = static_cast<node_t*>(current_->next());
+                return *this;
+            }
+
+            const_indexed_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            const_indexed_list_iterator& operator--() noexcept {
+                current_ = static_cast<node_t*>(current_->prev());
+                return *this;
+            }
+
+            const_indexed_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            const_indexed_list_iterator& operator+=(difference_type n) noexcept {
+                if (n != 0) {
+                    auto index = static_cast<difference_type>(indexed_tree::index_of(current_)) + n;
+                    current_ = indexed_tree::select(indexed_tree::header_of(current_), static_cast<std::size_t>(index));
+                }
+                return *this;
+            }
+
+            const_indexed_list_iterator& operator-=(difference_type n) noexcept {
+                return *this += -n;
+            }
+
+            [[nodiscard]]
+            friend const_indexed_list_iterator operator+(const_indexed_list_iterator it, difference_type n) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend const_indexed_list_iterator operator+(difference_type n, const_indexed_list_iterator it) noexcept {
+                return it += n;
+            }
+
+            [[nodiscard]]
+            friend const_indexed_list_iterator operator-(const_indexed_list_iterator it, difference_type n) noexcept {
+                return it -= n;
+            }
+
+            [[nodiscard]]
+            friend difference_type operator-(const const_indexed_list_iterator& lhs, const const_indexed_list_iterator& rhs) noexcept {
+                return static_cast<difference_type>(indexed_tree::index_of(lhs.current_)) -
+                       static_cast<difference_type>(indexed_tree::index_of(rhs.current_));
+            }
+
+            [[nodiscard]]
+            reference operator[](difference_type n) const noexcept {
+                return *(*this + n);
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<const NodeT*>(current_)->value();
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(static_cast<const NodeT*>(current_)->value());
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const const_indexed_list_iterator& lhs, const const_indexed_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const const_indexed_list_iterator& lhs, const const_indexed_list_iterator& rhs) noexcept {
+                return lhs.current_ != rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend auto operator<=>(const const_indexed_list_iterator& lhs, const const_indexed_list_iterator& rhs) noexcept {
+                return indexed_tree::index_of(lhs.current_) <=> indexed_tree::index_of(rhs.current_);
+            }
+        };
+    }
+
+    /**
+     * @brief Doubly-linked list with O(log n) positional access
+     *
+     * The nodes are linked in a list and in a balanced tree ordered by position that keeps the size of every
+     * subtree, so operator[], at(), index_of() and the random access iterator operations (and thus std::advance
+     * and std::distance) are O(log n). Insertion and erasure are O(log n) as well, iteration is O(1) per step.
+     *
+     * The nodes are allocated from a per-list pool, like the nodes of saxion::list.
+     *
+     * @tparam T type of the elements
+     * @tparam Allocator allocator used for the elements (rebound to allocate the nodes)
+     */
+    template<typename T, typename Allocator = std::allocator<T>>
+    class indexed_list {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using reference = T&;
+        using const_reference = T const&;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>,
+                      "Allocator::value_type must be the same as the value_type of the list");
+
+    private:
+        using node_base_t = detail::indexed_node_base;
+        using node_t = detail::indexed_node<T>;
+
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using node_allocator_type = typename alloc_traits::template rebind_alloc<node_t>;
+        using node_alloc_traits = std::allocator_traits<node_allocator_type>;
+
+        static_assert(std::is_same_v<typename node_alloc_traits::pointer, node_t*>,
+                      "Allocators with fancy pointers are not supported");
+
+        using pool_t = detail::node_pool<node_t, node_allocator_type>;
+
+        pool_t pool_;
+        detail::indexed_node_header node_;
+
+    public:
+        using iterator = detail::indexed_list_iterator<T, node_t>;
+        using const_iterator = detail::const_indexed_list_iterator<T, node_t>;
+
+    private:
+        [[nodiscard]]
+        node_base_t* header() const noexcept {
+            return const_cast<detail::indexed_node_header*>(&node_);
+        }
+
+        template<typename... Args>
+        node_t* create_node(Args&&... args) {
+            auto node = pool_.allocate();
+            node_alloc_traits::construct(pool_.allocator(), node);
+            try {
+                allocator_type value_alloc(pool_.allocator());
+                alloc_traits::construct(value_alloc, std::addressof(node->value_), std::forward<Args>(args)...);
+            } catch (...) {
+                node_alloc_traits::destroy(pool_.allocator(), node);
+                pool_.deallocate(node);
+                throw;
+            }
+            return node;
+        }
+
+        void destroy_value(detail::list_node_base* node) noexcept {
+            auto value_node = static_cast<node_t*>(node);
+            allocator_type value_alloc(pool_.allocator());
+            alloc_traits::destroy(value_alloc, std::addressof(value_node->value_));
+            node_alloc_traits::destroy(pool_.allocator(), value_node);
+        }
+
+        void destroy_node(detail::list_node_base* node) noexcept {
+            destroy_value(node);
+            pool_.deallocate(static_cast<node_t*>(node));
+        }
+
+        template<typename... Args>
+        node_t* link_new_node(node_base_t* pos, Args&&... args) {
+            auto node = create_node(std::forward<Args>(args)...);
+            detail::indexed_tree::insert_before(header(), node, pos);
+            return node;
+        }
+
+        template<typename Iter>
+        void append_range(Iter first, Iter last) {
+            for (; first != last; ++first) {
+                link_new_node(header(), *first);
+            }
+        }
+
+    public:
+
+        /**
+         * @brief Construct a new, empty list
+         */
+        indexed_list() noexcept(noexcept(Allocator())) :
+                indexed_list(Allocator())
+        {}
+
+        /**
+         * @brief Construct a new, empty list using the given allocator
+         *
+         * @param alloc allocator used for the nodes
+         */
+        explicit indexed_list(const Allocator& alloc) noexcept :
+                pool_(node_allocator_type(alloc))
+        {}
+
+        /**
+         * @brief Construct a new list from an initializer list
+         *
+         * @param init_list initializer list
+         * @param alloc allocator used for the nodes
+         */
+        indexed_list(std::initializer_list<T> init_list, const Allocator& alloc = Allocator()) :
+                indexed_list(alloc) {
+            pool_.reserve(init_list.size());
+            append_range(init_list.begin(), init_list.end());
+        }
+
+        /**
+         * @brief Construct a new list from a range
+         *
+         * @param first begin of the range
+         * @param last end of the range
+         * @param alloc allocator used for the nodes
+         */
+        template<typename _Iter, typename = std::enable_if_t<
+                std::is_convertible_v<typename std::iterator_traits<_Iter>::iterator_category, std::input_iterator_tag>>>
+        indexed_list(_Iter first, _Iter last, const Allocator& alloc = Allocator()) :
+                indexed_list(alloc) {
+            append_range(first, last);
+        }
+
+        /**
+         * @brief Copy constructor
+         *
+         * @param other list to copy
+         */
+        indexed_list(const indexed_list& other) :
+                indexed_list(alloc_traits::select_on_container_copy_construction(other.get_allocator())) {
+            pool_.reserve(other.size());
+            append_range(other.begin(), other.end());
+        }
+
+        /**
+         * @brief Move constructor
+         *
+         * @param other list to move from
+         */
+        indexed_list(indexed_list&& other) noexcept :
+                pool_(std::move(other.pool_)) {
+            node_.swap(other.node_);
+        }
+
+        /**
+         * @brief Copy assignment operator
+         *
+         * @param other list to copy
+         * @return reference to self
+         */
+        indexed_list& operator=(const indexed_list& other) {
+            if (this != &other) {
+                clear();
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                    if (pool_.allocator() != other.pool_.allocator()) {
+                        pool_.release();
+                    }
+                    pool_.allocator() = other.pool_.allocator();
+                }
+                pool_.reserve(other.size());
+                append_range(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment operator
+         *
+         * @param other list to move from
+         * @return reference to self
+         */
+        indexed_list& operator=(indexed_list&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                               alloc_traits::is_always_equal::value) {
+            if (this != &other) {
+                clear();
+
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                    pool_.release();
+                    pool_.allocator() = other.pool_.allocator();
+                    pool_.take_slabs(other.pool_);
+                    node_.swap(other.node_);
+                } else if (pool_.allocator() == other.pool_.allocator()) {
+                    pool_.take_slabs(other.pool_);
+                    node_.swap(other.node_);
+                } else {
+                    for (auto& value : other) {
+                        link_new_node(header(), std::move(value));
+                    }
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the list, the pool gives the nodes back to the allocator
+         */
+        ~indexed_list() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (auto current = node_.next(); current != &node_; current = current->next()) {
+                    destroy_value(current);
+                }
+            }
+        }
+
+        [[nodiscard]]
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(pool_.allocator());
+        }
+
+        [[nodiscard]]
+        iterator begin() noexcept {
+            return iterator(static_cast<node_base_t*>(node_.next()));
+        }
+
+        [[nodiscard]]
+        iterator end() noexcept {
+            return iterator(header());
+        }
+
+        [[nodiscard]]
+        const_iterator begin() const noexcept {
+            return const_iterator(static_cast<node_base_t*>(node_.next()));
+        }
+
+        [[nodiscard]]
+        const_iterator end() const noexcept {
+            return const_iterator(header());
+        }
+
+        [[nodiscard]]
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        [[nodiscard]]
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        [[nodiscard]]
+        reference front() {
+            return static_cast<node_t*>(node_.next())->value();
+        }
+
+        [[nodiscard]]
+        const_reference front() const {
+            return static_cast<const node_t*>(node_.next())->value();
+        }
+
+        [[nodiscard]]
+        reference back() {
+            return static_cast<node_t*>(node_.prev())->value();
+        }
+
+        [[nodiscard]]
+        const_reference back() const {
+            return static_cast<const node_t*>(node_.prev())->value();
+        }
+
+        /**
+         * @brief Returns a reference to the element at the given index, in O(log n)
+         *
+         * @param index
+         * @return reference to the element
+         */
+        [[nodiscard]]
+        reference operator[](size_type index) {
+            return static_cast<node_t*>(detail::indexed_tree::select(header(), index))->value();
+        }
+
+        /**
+         * @brief Returns a const reference to the element at the given index, in O(log n)
+         *
+         * @param index
+         * @return const reference to the element
+         */
+        [[nodiscard]]
+        const_reference operator[](size_type index) const {
+            return static_cast<const node_t*>(detail::indexed_tree::select(header(), index))->value();
+        }
+
+        /**
+         * @brief Returns a reference to the element at the given index, in O(log n)
+         *
+         * @param index
+         * @return reference to the element
+         * @throw std::length_error if index is out of bounds
+         */
+        [[nodiscard]]
+        reference at(size_type index) {
+            if (index < size()) {
+                return (*this)[index];
+            }
+            throw std::length_error("index out of bounds");
+        }
+
+        /**
+         * @brief Returns a const reference to the element at the given index, in O(log n)
+         *
+         * @param index
+         * @return const reference to the element
+         * @throw std::length_error if index is out of bounds
+         */
+        [[nodiscard]]
+        const_reference at(size_type index) const {
+            if (index < size()) {
+                return (*this)[index];
+            }
+            throw std::length_error("index out of bounds");
+        }
+
+        /**
+         * @brief Returns the position of an element, in O(log n)
+         *
+         * @param pos iterator to the element
+         * @return index of the element, size() for end()
+         */
+        [[nodiscard]]
+        size_type index_of(const_iterator pos) const noexcept {
+            return detail::indexed_tree::index_of(pos.current_);
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return node_.size() == 0;
+        }
+
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return node_.size();
+        }
+
+        /**
+         * @brief Makes sure the list can hold at least n elements without allocating
+         *
+         * @param n requested capacity
+         */
+        void reserve(size_type n) {
+            pool_.reserve(n);
+        }
+
+        /**
+         * @brief Emplaces an element before the given position
+         *
+         * @param pos position to insert before
+         * @param args arguments passed to the constructor of the element
+         * @return iterator to the new element
+         */
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
+            return iterator(link_new_node(pos.current_, std::forward<Args>(args)...));
+        }
+
+        iterator insert(const_iterator pos, const_reference value) {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value) {
+            return emplace(pos, std::move(value));
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args&&... args) {
+            return link_new_node(header(), std::forward<Args>(args)...)->value();
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args&&... args) {
+            return link_new_node(static_cast<node_base_t*>(node_.next()), std::forward<Args>(args)...)->value();
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const_reference value) {
+            emplace_front(value);
+        }
+
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+
+        /**
+         * @brief Erases the element at the given position
+         *
+         * @param pos position of the element to erase
+         * @return iterator to the element after the erased one
+         */
+        iterator erase(const_iterator pos) noexcept {
+            auto node = pos.current_;
+            auto next = static_cast<node_base_t*>(node->next());
+            detail::indexed_tree::erase(node);
+            destroy_node(node);
+            return iterator(next);
+        }
+
+        void pop_front() noexcept {
+            if (!empty()) {
+                erase(begin());
+            }
+        }
+
+        void pop_back() noexcept {
+            if (!empty()) {
+                erase(--end());
+            }
+        }
+
+        /**
+         * @brief Erases all the elements, the nodes stay in the pool
+         */
+        void clear() noexcept {
+            auto current = node_.next();
+            while (current != &node_) {
+                auto next = current->next();
+                destroy_node(current);
+                current = next;
+            }
+            node_.reset();
+        }
+
+        /**
+         * @brief Swaps the contents of two lists
+         *
+         * @param other list to swap with
+         */
+        void swap(indexed_list& other) noexcept {
+            pool_.swap(other.pool_, alloc_traits::propagate_on_container_swap::value);
+            node_.swap(other.node_);
+        }
+    };
+
+    /// Deduction guide for iterator arguments
+    template<typename _Iter, typename _Alloc = std::allocator<typename std::iterator_traits<_Iter>::value_type>>
+    indexed_list(_Iter b, _Iter e, _Alloc = _Alloc()) -> indexed_list<typename std::iterator_traits<_Iter>::value_type, _Alloc>;
+
+    namespace pmr {
+        /// saxion::indexed_list using a polymorphic allocator
+        template<typename T>
+        using indexed_list = saxion::indexed_list<T, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+#endif
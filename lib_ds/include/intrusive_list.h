@@ -0,0 +1,615 @@
+#ifndef INCLUDE_INTRUSIVE_LIST_H
+#define INCLUDE_INTRUSIVE_LIST_H
+
+/**
+ * @file intrusive_list.h
+ * @brief Intrusive doubly-linked list, linking objects through a hook embedded in them
+ */
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+#include "list.h"
+
+namespace saxion {
+
+    template<typename T, typename HookTraits>
+    class intrusive_list_impl;
+
+    /**
+     * @brief Hook that makes an object linkable into an intrusive_list
+     *
+     * The hook contains the links of the node and the sentinel of the list it is linked into, so
+     * the object can be unlinked from anywhere in O(1). A hook unlinks itself when it is destroyed.
+     *
+     * @note Copying an object doesn't copy its list membership, the copy starts unlinked.
+     */
+    class intrusive_list_hook : public detail::list_node_base {
+        template<typename T, typename HookTraits>
+        friend class intrusive_list_impl;
+
+        /// sentinel of the list this hook is linked into, nullptr if not linked
+        detail::list_node_sentinel* owner_{};
+
+        void link_before(detail::list_node_base* pos, detail::list_node_sentinel* owner) noexcept {
+            unlink();
+            hook_before(pos);
+            owner_ = owner;
+            owner_->inc_size();
+        }
+
+    public:
+        intrusive_list_hook() noexcept = default;
+
+        intrusive_list_hook(const intrusive_list_hook&) noexcept:
+            intrusive_list_hook()
+        {}
+
+        intrusive_list_hook& operator=(const intrusive_list_hook&) noexcept {
+            return *this;
+        }
+
+        ~intrusive_list_hook() noexcept {
+            unlink();
+        }
+
+        /**
+         * @brief Returns true if the hook is linked into a list
+         */
+        [[nodiscard]]
+        bool is_linked() const noexcept {
+            return owner_ != nullptr;
+        }
+
+        /**
+         * @brief Unlinks the hook from the list it is in, does nothing if it isn't linked
+         */
+        void unlink() noexcept {
+            if (owner_) {
+                unhook();
+                owner_->dec_size();
+                owner_ = nullptr;
+                prev_ = next_ = nullptr;
+            }
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Returns the offset of a data member in its class, from a pointer to the member
+         *
+         * The Itanium C++ ABI (GCC, Clang) and MSVC store a pointer to a data member as the offset of the member,
+         * with MSVC adding a virtual base index only for classes with virtual bases, so the offset is read from the
+         * pointer instead of being measured on an object. A member of a virtual base, whose offset isn't fixed,
+         * can't be converted to a pointer to a member of the derived class. With the member pointer a template
+         * argument this folds to a constant.
+         */
+        template<typename T, typename M>
+        [[nodiscard]]
+        std::ptrdiff_t member_offset(M T::* member) noexcept {
+            if constexpr (sizeof(member) == sizeof(std::int32_t)) {
+                return std::bit_cast<std::int32_t>(member);
+            } else {
+                static_assert(sizeof(member) == sizeof(std::ptrdiff_t), "unknown representation of pointers to members");
+                return std::bit_cast<std::ptrdiff_t>(member);
+            }
+        }
+
+        /**
+         * @brief Conversions between an object and its hook member
+         *
+         * @tparam T type of the objects
+         * @tparam Hook pointer to the hook member of T
+         */
+        template<typename T, intrusive_list_hook T::* Hook>
+        struct member_hook_traits {
+            [[nodiscard]]
+            static std::ptrdiff_t offset() noexcept {
+                return member_offset(Hook);
+            }
+
+            [[nodiscard]]
+            static intrusive_list_hook* to_hook(T& value) noexcept {
+                return std::addressof(value.*Hook);
+            }
+
+            [[nodiscard]]
+            static T* to_value(list_node_base* node) noexcept {
+                return reinterpret_cast<T*>(reinterpret_cast<char*>(static_cast<intrusive_list_hook*>(node)) - offset());
+            }
+        };
+
+        /**
+         * @brief Conversions between an object and the hook it derives from
+         *
+         * @tparam T type of the objects, derives publicly (and not virtually) from intrusive_list_hook
+         */
+        template<typename T>
+        struct base_hook_traits {
+            [[nodiscard]]
+            static intrusive_list_hook* to_hook(T& value) noexcept {
+                return static_cast<intrusive_list_hook*>(std::addressof(value));
+            }
+
+            [[nodiscard]]
+            static T* to_value(list_node_base* node) noexcept {
+                return static_cast<T*>(static_cast<intrusive_list_hook*>(node));
+            }
+        };
+
+        template<typename T, typename HookTraits>
+        struct const_intrusive_list_iterator;
+
+        template<typename T, typename HookTraits>
+        struct intrusive_list_iterator {
+            template<typename T_, typename H_> friend
+            class ::saxion::intrusive_list_impl;
+
+            // use node_t as the node type for the iterator
+            using node_t = list_node_base;
+
+            node_t* current_;
+
+            using value_type = T;
+            using reference = T&;
+            using pointer = T*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            intrusive_list_iterator() noexcept:
+                current_{}
+            {}
+
+            explicit intrusive_list_iterator(node_t* node) noexcept:
+                current_{node}
+            {}
+
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            intrusive_list_iterator& operator++() noexcept {
+                current_ = current_->next();
+                return *this;
+            }
+
+            intrusive_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            intrusive_list_iterator& operator--() noexcept {
+                current_ = current_->prev();
+                return *this;
+            }
+
+            intrusive_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return *HookTraits::to_value(current_);
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return HookTraits::to_value(current_);
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const intrusive_list_iterator& lhs, const intrusive_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const intrusive_list_iterator& lhs, const intrusive_list_iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+        };
+
+        template<typename T, typename HookTraits>
+        struct const_intrusive_list_iterator {
+            template<typename T_, typename H_> friend
+            class ::saxion::intrusive_list_impl;
+
+            // use node_t as the node type for the iterator
+            using node_t = list_node_base;
+
+            node_t* current_;
+
+            using value_type = T;
+            using reference = T const&;
+            using pointer = T const*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            const_intrusive_list_iterator() noexcept:
+                current_{}
+            {}
+
+            explicit const_intrusive_list_iterator(node_t* node) noexcept:
+                current_{node}
+            {}
+
+            /// a non-const iterator can always be used where a const one is expected
+            const_intrusive_list_iterator(const intrusive_list_iterator<T, HookTraits>& other) noexcept:
+                current_{other.current_}
+            {}
+
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            const_intrusive_list_iterator& operator++() noexcept {
+                current_ = current_->next();
+                return *this;
+            }
+
+            const_intrusive_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            const_intrusive_list_iterator& operator--() noexcept {
+                current_ = current_->prev();
+                return *this;
+            }
+
+            const_intrusive_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return *HookTraits::to_value(current_);
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return HookTraits::to_value(current_);
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const const_intrusive_list_iterator& lhs, const const_intrusive_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const const_intrusive_list_iterator& lhs, const const_intrusive_list_iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+        };
+
+        template <typename T, typename HookTraits>
+        [[nodiscard]]
+        inline bool operator==(const intrusive_list_iterator<T, HookTraits>& lhs, const const_intrusive_list_iterator<T, HookTraits>& rhs) {
+            return lhs.current_ == rhs.current_;
+        }
+
+        template <typename T, typename HookTraits>
+        [[nodiscard]]
+        inline bool operator!=(const intrusive_list_iterator<T, HookTraits>& lhs, const const_intrusive_list_iterator<T, HookTraits>& rhs) {
+            return !(lhs == rhs);
+        }
+    }
+
+    /**
+     * @brief Intrusive doubly-linked list
+     *
+     * The list doesn't own nor allocate anything: it links existing objects through the intrusive_list_hook
+     * they contain. The objects must outlive their membership, but a hook unlinks itself when destroyed.
+     * Linking an object that is already in a list moves it over, so an object is in at most one list per hook.
+     *
+     * @note Moving or swapping lists is O(n), every hook records the list it belongs to.
+     *
+     * @tparam T type of the elements
+     * @tparam HookTraits conversions between T and its hook
+     */
+    template<typename T, typename HookTraits>
+    class intrusive_list_impl {
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = T const&;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        using iterator = detail::intrusive_list_iterator<T, HookTraits>;
+        using const_iterator = detail::const_intrusive_list_iterator<T, HookTraits>;
+
+    private:
+        detail::list_node_sentinel node_{};
+
+        [[nodiscard]]
+        static intrusive_list_hook* hook_of(detail::list_node_base* node) noexcept {
+            return static_cast<intrusive_list_hook*>(node);
+        }
+
+        /// makes every hook in this list point to its sentinel (after the nodes were moved over)
+        void adopt_all() noexcept {
+            for (auto current = node_.next(); current != &node_; current = current->next()) {
+                hook_of(current)->owner_ = &node_;
+            }
+        }
+
+    public:
+
+        /**
+         * @brief Construct a new, empty list
+         */
+        intrusive_list_impl() noexcept = default;
+
+        intrusive_list_impl(const intrusive_list_impl&) = delete;
+        intrusive_list_impl& operator=(const intrusive_list_impl&) = delete;
+
+        /**
+         * @brief Move constructor, takes over all the objects of other
+         *
+         * @param other list to move from
+         */
+        intrusive_list_impl(intrusive_list_impl&& other) noexcept {
+            swap(other);
+        }
+
+        /**
+         * @brief Move assignment, the objects of this list are unlinked first
+         *
+         * @param other list to move from
+         * @return reference to self
+         */
+        intrusive_list_impl& operator=(intrusive_list_impl&& other) noexcept {
+            if (this != &other) {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the list, unlinking all the objects
+         */
+        ~intrusive_list_impl() noexcept {
+            clear();
+        }
+
+        [[nodiscard]]
+        iterator begin() noexcept {
+            return iterator(node_.next());
+        }
+
+        [[nodiscard]]
+        iterator end() noexcept {
+            return iterator(&node_);
+        }
+
+        [[nodiscard]]
+        const_iterator begin() const noexcept {
+            return const_iterator(node_.next());
+        }
+
+        [[nodiscard]]
+        const_iterator end() const noexcept {
+            return const_iterator(const_cast<detail::list_node_sentinel*>(&node_));
+        }
+
+        [[nodiscard]]
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        [[nodiscard]]
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        /**
+         * @brief Returns an iterator to an object linked into this list, in O(1)
+         *
+         * @param value object in this list
+         * @return iterator
+         */
+        [[nodiscard]]
+        iterator iterator_to(reference value) noexcept {
+            return iterator(HookTraits::to_hook(value));
+        }
+
+        [[nodiscard]]
+        const_iterator iterator_to(const_reference value) const noexcept {
+            return const_iterator(HookTraits::to_hook(const_cast<reference>(value)));
+        }
+
+        /**
+         * @brief Returns true if the object is linked into this list
+         */
+        [[nodiscard]]
+        bool contains(const_reference value) const noexcept {
+            return HookTraits::to_hook(const_cast<reference>(value))->owner_ == &node_;
+        }
+
+        [[nodiscard]]
+        reference front() noexcept {
+            return *begin();
+        }
+
+        [[nodiscard]]
+        const_reference front() const noexcept {
+            return *begin();
+        }
+
+        [[nodiscard]]
+        reference back() noexcept {
+            return *iterator(node_.prev());
+        }
+
+        [[nodiscard]]
+        const_reference back() const noexcept {
+            return *const_iterator(node_.prev());
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return node_.size() == 0;
+        }
+
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return node_.size();
+        }
+
+        /**
+         * @brief Links an object before the given position
+         *
+         * @note If the object is already in a list, it is unlinked from it first.
+         *
+         * @param pos position to insert before
+         * @param value object to link
+         * @return iterator to the linked object
+         */
+        iterator insert(const_iterator pos, reference value) noexcept {
+            auto hook = HookTraits::to_hook(value);
+            if (hook == pos.current_) {
+                return iterator(hook);
+            }
+            hook->link_before(pos.current_, &node_);
+            return iterator(hook);
+        }
+
+        /**
+         * @brief Links an object at the end of the list
+         *
+         * @param value object to link
+         * @return iterator to the linked object
+         */
+        iterator push_back(reference value) noexcept {
+            return insert(end(), value);
+        }
+
+        /**
+         * @brief Links an object at the front of the list
+         *
+         * @param value object to link
+         * @return iterator to the linked object
+         */
+        iterator push_front(reference value) noexcept {
+            return insert(begin(), value);
+        }
+
+        /**
+         * @brief Unlinks the first object
+         */
+        void pop_front() noexcept {
+            if (!empty()) {
+                hook_of(node_.next())->unlink();
+            }
+        }
+
+        /**
+         * @brief Unlinks the last object
+         */
+        void pop_back() noexcept {
+            if (!empty()) {
+                hook_of(node_.prev())->unlink();
+            }
+        }
+
+        /**
+         * @brief Unlinks the object at the given position
+         *
+         * @param pos position of the object to unlink
+         * @return iterator to the next object
+         */
+        iterator erase(const_iterator pos) noexcept {
+            auto next = pos.current_->next();
+            hook_of(pos.current_)->unlink();
+            return iterator(next);
+        }
+
+        /**
+         * @brief Unlinks an object if it is in this list
+         *
+         * @param value object to unlink
+         * @return true if the object was unlinked
+         */
+        bool remove(reference value) noexcept {
+            if (contains(value)) {
+                HookTraits::to_hook(value)->unlink();
+                return true;
+            }
+            return false;
+        }
+
+        /**
+         * @brief Unlinks all the objects
+         */
+        void clear() noexcept {
+            auto current = node_.next();
+            while (current != &node_) {
+                auto hook = hook_of(current);
+                current = current->next();
+                hook->owner_ = nullptr;
+                hook->prev_ = hook->next_ = nullptr;
+            }
+            node_.reset();
+        }
+
+        /**
+         * @brief Swaps the contents of two lists
+         *
+         * @param other list to swap with
+         */
+        void swap(intrusive_list_impl& other) noexcept {
+            node_.swap(other.node_);
+            adopt_all();
+            other.adopt_all();
+        }
+    };
+
+    /**
+     * @brief Intrusive list of T, linked through the hook member Hook of T
+     *
+     * @code
+     * struct task {
+     *     int id;
+     *     saxion::intrusive_list_hook hook;
+     * };
+     * saxion::intrusive_list<task, &task::hook> ready_queue;
+     * @endcode
+     */
+    template<typename T, intrusive_list_hook T::* Hook>
+    using intrusive_list = intrusive_list_impl<T, detail::member_hook_traits<T, Hook>>;
+
+    /**
+     * @brief Intrusive list of T, linked through the intrusive_list_hook T derives from
+     *
+     * The object is found from its hook with a static_cast, T has a single hook.
+     *
+     * @code
+     * struct task : saxion::intrusive_list_hook {
+     *     virtual ~task() = default;
+     * };
+     * saxion::intrusive_base_list<task> ready_queue;
+     * @endcode
+     */
+    template<typename T>
+    using intrusive_base_list = intrusive_list_impl<T, detail::base_hook_traits<T>>;
+}
+
+#endif
@@ -9,12 +9,154 @@
 #include <type_traits>
 #include <iterator>
 #include <initializer_list>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <vector>
 #include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
 
 namespace saxion {
 
+    /**
+     * @brief Default observer of saxion::list, all its hooks do nothing
+     *
+     * The observer is the third template parameter of saxion::list. The list calls the hooks of its observer on
+     * the mutating operations: an observer derives from this class and hides the hooks it is interested in. The
+     * calls are resolved at compile time, so the empty hooks of this class cost nothing.
+     *
+     * Every list object has its own observer, default constructed: observers are not copied, moved or swapped
+     * together with the elements. The hooks must not throw, some of them are called from noexcept operations.
+     *
+     * @note Of the operations on the elements only the ones below are reported, splice, merge, sort, reverse,
+     *       remove_if and unique are not (the nodes they destroy are reported by on_node_free).
+     */
+    struct list_observer {
+        /// count elements were inserted, first is the first of them (push_*, emplace*, insert*, *_range)
+        template<typename List>
+        void on_insert(const List&, typename List::const_iterator, std::size_t) noexcept {}
+
+        /// push_back() or emplace_back() appended an element, called after on_insert
+        template<typename List>
+        void on_push_back(const List&) noexcept {}
+
+        /// count elements starting at first are about to be erased (pop_*, erase)
+        template<typename List>
+        void on_erase(const List&, typename List::const_iterator, std::size_t) noexcept {}
+
+        /// the list is about to be cleared
+        template<typename List>
+        void on_clear(const List&) noexcept {}
+
+        /// the list is about to be replaced by a copy of other (copy assignment)
+        template<typename List>
+        void on_copy_assign(const List&, const List&) noexcept {}
+
+        /// the list is about to take the elements of other (move assignment)
+        template<typename List>
+        void on_move_assign(const List&, const List&) noexcept {}
+
+        /// the list is about to be copied into another list (copy construction or assignment)
+        template<typename List>
+        void on_copied(const List&) noexcept {}
+
+        /// the elements of the list are about to be moved to another list (move construction or assignment)
+        template<typename List>
+        void on_moved(const List&) noexcept {}
+
+        /// operator[] or at() is about to walk steps nodes from the head
+        template<typename List>
+        void on_walk(const List&, std::size_t) noexcept {}
+
+        /// a node was taken from the pool for a new element
+        template<typename List>
+        void on_node_allocate(const List&) noexcept {}
+
+        /// count nodes were destroyed (given back to the pool, or released with the list)
+        template<typename List>
+        void on_node_free(const List&, std::size_t) noexcept {}
+
+        /// a new element was copy constructed from another element
+        template<typename List>
+        void on_element_copy(const List&) noexcept {}
+
+        /// a new element was move constructed from another element
+        template<typename List>
+        void on_element_move(const List&) noexcept {}
+    };
+
+    /**
+     * @brief Memory used by a saxion::list, returned by list::memory_usage()
+     *
+     * The nodes in use are split into their links, their values and the padding between them. The node slots of the
+     * pool that hold no element and the slab headers are the slack of the pool. The bookkeeping of the allocator
+     * itself (e.g. the malloc headers of the slabs) isn't included.
+     */
+    struct list_memory_usage {
+        std::size_t elements{};
+        std::size_t slabs{};
+        std::size_t link_bytes{};     ///< prev and next pointers of the nodes in use
+        std::size_t value_bytes{};    ///< sizeof(T) for every element
+        std::size_t padding_bytes{};  ///< bytes of the nodes in use that are neither links nor value
+        std::size_t heap_bytes{};     ///< memory the elements own outside of their node (strings, vectors), by capacity()
+        std::size_t slack_bytes{};    ///< unused node slots and slab headers
+        std::size_t list_bytes{};     ///< the list object itself
+
+        /// bytes of the nodes in use
+        [[nodiscard]]
+        std::size_t node_bytes() const noexcept {
+            return link_bytes + value_bytes + padding_bytes;
+        }
+
+        /// bytes obtained from the allocator for the nodes
+        [[nodiscard]]
+        std::size_t allocated_bytes() const noexcept {
+            return node_bytes() + slack_bytes;
+        }
+
+        [[nodiscard]]
+        std::size_t total_bytes() const noexcept {
+            return allocated_bytes() + heap_bytes + list_bytes;
+        }
+    };
+
+    /**
+     * @brief How far apart successive nodes of a list are in memory, returned by list::locality_report()
+     *
+     * A list filled in one go has its nodes in consecutive slots, a walk over it reads memory in order. Erasing and
+     * inserting, sorting and splicing scatter the nodes, and every jump to another cache line or page is a likely
+     * miss. Copying the list (or copying it in a new list and swapping) puts the nodes back in order.
+     */
+    struct list_locality {
+        static constexpr std::size_t page_size = 4096;
+
+        std::size_t links{};         ///< pairs of successive nodes
+        std::size_t sequential{};    ///< the next node is in the next slot of memory
+        std::size_t same_page{};     ///< the next node is on the same page (sequential ones included)
+        std::size_t backward{};      ///< the next node is at a lower address
+        std::size_t max_distance{};  ///< largest distance in bytes between successive nodes
+        double mean_log2_distance{}; ///< mean of log2 of the distance in bytes between successive nodes
+
+        /// share of the links that don't lead to the next slot: 0 in allocation order, close to 1 when shuffled
+        [[nodiscard]]
+        double fragmentation() const noexcept {
+            return links ? 1.0 - static_cast<double>(sequential) / static_cast<double>(links) : 0;
+        }
+
+        /// share of the links that lead to another page, each is likely a cache and a TLB miss
+        [[nodiscard]]
+        double page_jumps() const noexcept {
+            return links ? 1.0 - static_cast<double>(same_page) / static_cast<double>(links) : 0;
+        }
+    };
+
     //forward declaration of the class list
-    template<typename T>
+    template<typename T, typename Allocator = std::allocator<T>, typename Observer = list_observer>
     class list;
 
     /**
@@ -31,11 +173,15 @@ namespace saxion {
         /**
          * @brief Base class for list nodes
          *
-         * This class contains only the pointers to the next and previous nodes. The previous pointers is non-owning. The next pointer is owning.
+         * This class contains only the pointers to the next and previous nodes. Both pointers are non-owning,
+         * the nodes are owned (allocated and destroyed) by the list they are linked into.
+         *
+         * @note The node types are not polymorphic, a list node is just the two links followed by the value.
+         *       Nodes are always destroyed through their most derived type.
          */
         struct list_node_base {
             list_node_base* prev_{};
-            std::unique_ptr<list_node_base> next_{};
+            list_node_base* next_{};
 
             list_node_base() noexcept:
                 prev_{},
@@ -49,7 +195,7 @@ namespace saxion {
 
             [[nodiscard]]
             list_node_base* next() const noexcept {
-                return next_.get();
+                return next_;
             }
 
 
@@ -58,12 +204,34 @@ namespace saxion {
                 return prev_;
             }
 
-            virtual ~list_node_base() noexcept = default;
+            /**
+             * @brief Links this node into a chain, just before @p pos
+             *
+             * @param pos node to link before
+             */
+            void hook_before(list_node_base* pos) noexcept {
+                prev_ = pos->prev_;
+                next_ = pos;
+                prev_->next_ = this;
+                pos->prev_ = this;
+            }
+
+            /**
+             * @brief Unlinks this node from its neighbours
+             *
+             * @note The links of this node are left dangling.
+             */
+            void unhook() noexcept {
+                prev_->next_ = next_;
+                next_->prev_ = prev_;
+            }
         };
 
+        static_assert(sizeof(list_node_base) == 2 * sizeof(list_node_base*), "a node base should be just the two links");
+
         /**
          * @brief Sentinel node
-         * 
+         *
          * Node type used as sentinel.
          */
         struct list_node_sentinel : public list_node_base {
@@ -73,46 +241,49 @@ namespace saxion {
 
             /**
              * @brief Construct a new list node sentinel object
-             * 
-             * @note An empty sentinel owns itself.
-             * 
+             *
+             * @note An empty sentinel points to itself.
+             *
              */
             list_node_sentinel():
                 list_node_base(),
                 size_{}
             {
-                prev_ = this;
-                next_.reset(this);
+                reset();
             }
 
+            // the neighbours point to the sentinel, so it can't be copied around
+            list_node_sentinel(const list_node_sentinel&) = delete;
+            list_node_sentinel& operator=(const list_node_sentinel&) = delete;
+
             /**
-             * @brief Destroy the list node sentinel object
-             * 
-             * @note If the sentinel is empty it release itself to prevent recursive destruction.
-             * 
+             * @brief Makes the sentinel empty again
+             *
+             * @note The nodes linked to the sentinel are not touched.
              */
-            virtual ~list_node_sentinel() noexcept {
-
-                if (next() == this){
-                    next_.release();
-                }
+            void reset() noexcept {
+                prev_ = this;
+                next_ = this;
+                size_ = 0;
             }
 
             /**
              * @brief Swaps this node with another sentinel
-             * 
+             *
              * @param other another sentinel
              */
             void swap(list_node_sentinel& other) noexcept {
                 std::swap(prev_, other.prev_);
                 std::swap(next_, other.next_);
                 std::swap(size_, other.size_);
+                relink();
+                other.relink();
             }
 
             /**
              * @brief Increment the size of the list
-             * 
-             * @return std::size_t 
+             *
+             * @return std::size_t
              */
             std::size_t inc_size() noexcept {
                 return ++size_;
@@ -120,14 +291,32 @@ namespace saxion {
 
             /**
              * @brief Decrement the size of the list
-             * 
-             * @return std::size_t 
+             *
+             * @return std::size_t
              */
 
             std::size_t dec_size() noexcept {
                 return --size_;
             }
 
+            /**
+             * @brief Increase the size of the list by n (nodes linked in one block)
+             *
+             * @return std::size_t
+             */
+            std::size_t inc_size(std::size_t n) noexcept {
+                return size_ += n;
+            }
+
+            /**
+             * @brief Decrease the size of the list by n (nodes unlinked in one block)
+             *
+             * @return std::size_t
+             */
+            std::size_t dec_size(std::size_t n) noexcept {
+                return size_ -= n;
+            }
+
             [[nodiscard]]
             std::size_t size() const noexcept {
                 return size_;
@@ -138,37 +327,50 @@ namespace saxion {
                 return this;
             }
 
+        private:
+            /// makes the first and the last node point back at this sentinel (after a swap)
+            void relink() noexcept {
+                if (size_ == 0) {
+                    prev_ = this;
+                    next_ = this;
+                } else {
+                    next_->prev_ = this;
+                    prev_->next_ = this;
+                }
+            }
+
         };
 
         /**
          * @brief Node that contains a value
-         * 
+         *
+         * The node is constructed in two steps: the node itself (the links) and then the value, in place,
+         * with the element allocator. This way the value never has to be moved or copied into the node.
+         *
          * @tparam T type of the value
          */
         template<typename T>
         struct list_node : public list_node_base {
-            template<typename T_> friend
+            template<typename T_, typename A_, typename O_> friend
             class ::saxion::list;
 
-            T value_;
+            /// the value is constructed and destroyed by the owner of the node
+            union {
+                T value_;
+            };
 
-            list_node() = delete;
+            /// constructs the links only, the value is left uninitialized
+            list_node() noexcept:
+                list_node_base{}
+            {}
 
-            void swap(list_node& other) noexcept {
-                std::swap(prev_, other.prev_);
-                std::swap(next_, other.next_);
-                std::swap(value_, other.value_);
-            }
+            list_node(const list_node&) = delete;
+            list_node& operator=(const list_node&) = delete;
 
-            list_node(T&& v, list_node_base* prev, list_node_base* next) :
-                list_node_base{ prev, next },
-                value_{ std::move(v) }
-            {}
+            ~list_node() requires std::is_trivially_destructible_v<T> = default;
 
-            list_node(T const& v, list_node_base* prev, list_node_base* next) :
-                list_node_base{ prev, next },
-                value_{v}
-            {}
+            /// doesn't destroy the value
+            ~list_node() {}
 
             [[nodiscard]]
             T& value() {
@@ -179,14 +381,640 @@ namespace saxion {
             T const& value() const {
                 return value_;
             }
+        };
+
+        /**
+         * @brief Merges two sorted chains of nodes, linked through next_ and terminated by nullptr
+         *
+         * The merge is stable: of two equivalent nodes the one from @p first comes first. Only the next_ links
+         * are updated. If less throws, @p first is set to a chain that still contains all the nodes.
+         *
+         * @param first first sorted chain, receives the merged chain
+         * @param second second sorted chain
+         * @param less compares two nodes
+         */
+        template<typename Less>
+        void merge_chains(list_node_base*& first, list_node_base* second, Less& less) {
+            list_node_base* head = nullptr;
+            list_node_base** tail = &head;
+            auto current = first;
+            try {
+                while (current && second) {
+                    if (less(second, current)) {
+                        *tail = second;
+                        second = second->next_;
+                    } else {
+                        *tail = current;
+                        current = current->next_;
+                    }
+                    tail = &(*tail)->next_;
+                }
+            } catch (...) {
+                *tail = current;
+                while (*tail) {
+                    tail = &(*tail)->next_;
+                }
+                *tail = second;
+                first = head;
+                throw;
+            }
+            *tail = current ? current : second;
+            first = head;
+        }
+
+        /**
+         * @brief Appends the chain @p second to the chain @p first, both terminated by nullptr
+         *
+         * @return the concatenated chain
+         */
+        [[nodiscard]]
+        inline list_node_base* concat_chains(list_node_base* first, list_node_base* second) noexcept {
+            if (!first) {
+                return second;
+            }
+            auto last = first;
+            while (last->next_) {
+                last = last->next_;
+            }
+            last->next_ = second;
+            return first;
+        }
+
+        /**
+         * @brief Links a chain (linked through next_ and terminated by nullptr) between the sentinel and itself
+         *
+         * @param sentinel sentinel of the list
+         * @param chain first node of the chain
+         */
+        inline void relink_chain(list_node_base* sentinel, list_node_base* chain) noexcept {
+            auto prev = sentinel;
+            for (auto node = chain; node; node = node->next_) {
+                prev->next_ = node;
+                node->prev_ = prev;
+                prev = node;
+            }
+            prev->next_ = sentinel;
+            sentinel->prev_ = prev;
+        }
+
+        /**
+         * @brief Stable bottom-up merge sort of the nodes linked to a sentinel
+         *
+         * The nodes are only relinked, nothing is allocated: bins[i] holds a sorted run of 2^i nodes, like the
+         * digits of a binary counter. If less throws, all nodes are still linked to the sentinel, in an
+         * unspecified order.
+         *
+         * @param sentinel sentinel of the list
+         * @param less compares two nodes
+         */
+        template<typename Less>
+        void sort_nodes(list_node_base* sentinel, Less less) {
+            if (sentinel->next_ == sentinel->prev_) {
+                return;
+            }
+
+            constexpr std::size_t n_bins = 64;
+            list_node_base* bins[n_bins]{};
+            list_node_base* pending = nullptr;   // the run that isn't stored in a bin
+            auto chain = sentinel->next_;
+            sentinel->prev_->next_ = nullptr;
+
+            try {
+                while (chain) {
+                    pending = chain;
+                    chain = chain->next_;
+                    pending->next_ = nullptr;
+
+                    std::size_t ind = 0;
+                    // the runs in the bins hold earlier elements than pending, so they go first
+                    for (; bins[ind]; ++ind) {
+                        merge_chains(bins[ind], std::exchange(pending, nullptr), less);
+                        pending = std::exchange(bins[ind], nullptr);
+                    }
+                    bins[ind] = std::exchange(pending, nullptr);
+                }
+
+                for (auto& bin : bins) {
+                    if (bin) {
+                        if (pending) {
+                            merge_chains(bin, std::exchange(pending, nullptr), less);
+                        }
+                        pending = std::exchange(bin, nullptr);
+                    }
+                }
+            } catch (...) {
+                // put every node back into the list
+                auto all = concat_chains(pending, chain);
+                for (auto run : bins) {
+                    all = concat_chains(run, all);
+                }
+                relink_chain(sentinel, all);
+                throw;
+            }
+            relink_chain(sentinel, pending);
+        }
+
+        /**
+         * @brief Slab allocator for the nodes of a single list
+         *
+         * Storage for the nodes is obtained from the node allocator in slabs holding many nodes at once.
+         * Nodes given back to the pool are kept in an intrusive free list and are handed out again before
+         * any new slab is allocated, so a list that doesn't grow beyond its capacity doesn't allocate at all.
+         * Slabs are returned to the allocator only by shrink_to_fit() and release().
+         *
+         * The first slot of every slab stores the slab header; the free list is threaded through the unused slots.
+         *
+         * Nodes can move to the pool of another list (see share_slabs()): such a node stays in the slab it was
+         * allocated in, and goes to the free list of the pool that holds it when it's freed.
+         *
+         * @tparam NodeT type of the nodes
+         * @tparam NodeAllocator allocator of NodeT used to obtain the slabs
+         */
+        template<typename NodeT, typename NodeAllocator>
+        class node_pool {
+            using alloc_traits = std::allocator_traits<NodeAllocator>;
+
+            struct slab_header {
+                slab_header* next_;
+                std::size_t count_;   // number of node slots, excluding the one used by the header
+            };
+
+            struct free_slot {
+                free_slot* next_;
+            };
+
+            /**
+             * @brief Owner of the slabs of pools that exchanged nodes
+             *
+             * A node that moved to another pool still lives in its slab, so the slabs of pools that exchanged nodes
+             * are only returned to the allocator when all those pools are gone. Such pools join one tree of stores
+             * (a union-find, where a store only points to a store at a lower address so there are no cycles). A
+             * pool hands its slabs to its store when it's released, a store hands them to its parent when its last
+             * reference goes, and the root returns them all to the allocator.
+             *
+             * References and released slabs are atomic: lists that share a store can still be used from different
+             * threads, like any two lists.
+             */
+            struct slab_store {
+                std::atomic<std::size_t> refs_;
+                std::atomic<slab_store*> parent_;
+                std::atomic<slab_header*> released_;
+                [[no_unique_address]]
+                NodeAllocator alloc_;
+            };
+
+            using store_allocator = typename alloc_traits::template rebind_alloc<slab_store>;
+            using store_alloc_traits = std::allocator_traits<store_allocator>;
+
+            static_assert(sizeof(NodeT) >= sizeof(slab_header) && alignof(NodeT) >= alignof(slab_header),
+                          "a node slot must be able to hold a slab header");
+
+            /// smallest and largest number of nodes allocated at once when the pool grows by itself
+            static constexpr std::size_t min_slab_nodes = 8;
+            static constexpr std::size_t max_slab_nodes = std::max<std::size_t>(min_slab_nodes, (64 * 1024) / sizeof(NodeT));
+
+            [[no_unique_address]]
+            NodeAllocator alloc_;
+
+            slab_header* slabs_{};
+            free_slot* free_{};
+
+            // oldest slab and oldest free slot, the ends of the two chains, so a pool can adopt another in O(1)
+            slab_header* last_slab_{};
+            free_slot* last_free_{};
+
+            // slots of the newest slab that were never handed out
+            NodeT* bump_{};
+            NodeT* bump_end_{};
+
+            std::size_t capacity_{};
+
+            // only created when nodes move between pools, see share_slabs()
+            slab_store* store_{};
+
+            [[nodiscard]]
+            static NodeT* first_slot(slab_header* slab) noexcept {
+                return reinterpret_cast<NodeT*>(slab) + 1;
+            }
+
+            [[nodiscard]]
+            slab_store* make_store(std::size_t refs) {
+                store_allocator store_alloc(alloc_);
+                auto store = store_alloc_traits::allocate(store_alloc, 1);
+                return ::new(static_cast<void*>(store)) slab_store{{refs}, {nullptr}, {nullptr}, alloc_};
+            }
+
+            [[nodiscard]]
+            static slab_store* root_of(slab_store* store) noexcept {
+                while (auto parent = store->parent_.load(std::memory_order_acquire)) {
+                    store = parent;
+                }
+                return store;
+            }
+
+            /// adds the slabs [first, last], linked through next_, to the released slabs of store
+            static void push_released(slab_store* store, slab_header* first, slab_header* last) noexcept {
+                auto top = store->released_.load(std::memory_order_relaxed);
+                do {
+                    last->next_ = top;
+                } while (!store->released_.compare_exchange_weak(top, first, std::memory_order_release,
+                                                                 std::memory_order_relaxed));
+            }
+
+            /// drops a reference to store, the last one passes the released slabs up or frees them at the root
+            static void unref(slab_store* store) noexcept {
+                while (store && store->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    auto parent = store->parent_.load(std::memory_order_acquire);
+                    auto slabs = store->released_.load(std::memory_order_acquire);
+                    NodeAllocator alloc(store->alloc_);
+                    if (parent && slabs) {
+                        auto last = slabs;
+                        while (last->next_) {
+                            last = last->next_;
+                        }
+                        push_released(parent, slabs, last);
+                    } else if (!parent) {
+                        while (slabs) {
+                            auto slab = std::exchange(slabs, slabs->next_);
+                            alloc_traits::deallocate(alloc, reinterpret_cast<NodeT*>(slab), slab->count_ + 1);
+                        }
+                    }
+                    store_allocator store_alloc(alloc);
+                    std::destroy_at(store);
+                    store_alloc_traits::deallocate(store_alloc, store, 1);
+                    store = parent;
+                }
+            }
+
+            /// makes two pools that already have a store share one tree
+            void join_stores(node_pool& other) noexcept {
+                auto lhs = root_of(store_);
+                auto rhs = root_of(other.store_);
+                while (lhs != rhs) {
+                    if (std::less<>{}(rhs, lhs)) {
+                        std::swap(lhs, rhs);
+                    }
+                    // lhs can't go away meanwhile: it's reachable from the store of one of the two pools
+                    lhs->refs_.fetch_add(1, std::memory_order_relaxed);
+                    slab_store* expected = nullptr;
+                    if (rhs->parent_.compare_exchange_strong(expected, lhs, std::memory_order_acq_rel)) {
+                        return;
+                    }
+                    lhs->refs_.fetch_sub(1, std::memory_order_relaxed);
+                    lhs = root_of(store_);
+                    rhs = root_of(other.store_);
+                }
+            }
+
+            void push_free(NodeT* slot) noexcept {
+                auto was_empty = !free_;
+                free_ = ::new(static_cast<void*>(slot)) free_slot{free_};
+                if (was_empty) {
+                    last_free_ = free_;
+                }
+            }
+
+            /// moves the never used slots of the newest slab to the free list
+            void flush_bump() noexcept {
+                while (bump_ != bump_end_) {
+                    push_free(bump_++);
+                }
+            }
+
+            void add_slab(std::size_t count) {
+                auto raw = alloc_traits::allocate(alloc_, count + 1);
+                flush_bump();
+                slabs_ = ::new(static_cast<void*>(raw)) slab_header{slabs_, count};
+                if (!slabs_->next_) {
+                    last_slab_ = slabs_;
+                }
+                bump_ = first_slot(slabs_);
+                bump_end_ = bump_ + count;
+                capacity_ += count;
+            }
+
+            void deallocate_slab(slab_header* slab) noexcept {
+                capacity_ -= slab->count_;
+                alloc_traits::deallocate(alloc_, reinterpret_cast<NodeT*>(slab), slab->count_ + 1);
+            }
+
+            void steal(node_pool& other) noexcept {
+                slabs_ = std::exchange(other.slabs_, nullptr);
+                free_ = std::exchange(other.free_, nullptr);
+                last_slab_ = std::exchange(other.last_slab_, nullptr);
+                last_free_ = std::exchange(other.last_free_, nullptr);
+                bump_ = std::exchange(other.bump_, nullptr);
+                bump_end_ = std::exchange(other.bump_end_, nullptr);
+                capacity_ = std::exchange(other.capacity_, 0);
+                store_ = std::exchange(other.store_, nullptr);
+            }
+
+        public:
+            explicit node_pool(const NodeAllocator& alloc) noexcept:
+                alloc_(alloc)
+            {}
+
+            node_pool(const node_pool&) = delete;
+            node_pool& operator=(const node_pool&) = delete;
+
+            /// takes over the slabs and a copy of the allocator of other
+            node_pool(node_pool&& other) noexcept:
+                alloc_(other.alloc_) {
+                steal(other);
+            }
+
+            ~node_pool() noexcept {
+                release();
+            }
+
+            [[nodiscard]]
+            const NodeAllocator& allocator() const noexcept {
+                return alloc_;
+            }
 
-            virtual ~list_node() noexcept = default;
+            [[nodiscard]]
+            NodeAllocator& allocator() noexcept {
+                return alloc_;
+            }
+
+            /**
+             * @brief Returns storage for one node
+             *
+             * @return pointer to uninitialized storage for a node
+             */
+            [[nodiscard]]
+            NodeT* allocate() {
+                if (free_) {
+                    auto slot = reinterpret_cast<NodeT*>(free_);
+                    free_ = free_->next_;
+                    return slot;
+                }
+                if (bump_ == bump_end_) {
+                    add_slab(std::clamp(capacity_, min_slab_nodes, max_slab_nodes));
+                }
+                return bump_++;
+            }
+
+            /**
+             * @brief Gives the storage of a (destroyed) node back to the pool
+             *
+             * @param node storage obtained from allocate()
+             */
+            void deallocate(NodeT* node) noexcept {
+                push_free(node);
+            }
+
+            /**
+             * @brief Number of nodes the pool can hold without allocating a new slab, including the ones in use
+             *
+             * @return std::size_t
+             */
+            [[nodiscard]]
+            std::size_t capacity() const noexcept {
+                return capacity_;
+            }
+
+            /// number of slabs, O(slabs)
+            [[nodiscard]]
+            std::size_t slab_count() const noexcept {
+                std::size_t count = 0;
+                for (auto slab = slabs_; slab; slab = slab->next_) {
+                    ++count;
+                }
+                return count;
+            }
+
+            /**
+             * @brief Makes sure the pool can hold at least n nodes, allocating at most one slab
+             *
+             * @param n requested capacity
+             */
+            void reserve(std::size_t n) {
+                if (n > capacity_) {
+                    add_slab(n - capacity_);
+                }
+            }
+
+            /**
+             * @brief Makes sure the pool can hold at least n nodes, growing by at least the step allocate() uses
+             *
+             * Unlike reserve(), repeated small requests still grow the pool geometrically, one slab at a time.
+             *
+             * @param n required capacity
+             */
+            void grow_to(std::size_t n) {
+                if (n > capacity_) {
+                    add_slab(std::max(n - capacity_, std::clamp(capacity_, min_slab_nodes, max_slab_nodes)));
+                }
+            }
+
+            /**
+             * @brief Returns the slabs without any node in use to the allocator
+             *
+             * @note The scratch space used to find the unused slabs is allocated with the node allocator.
+             */
+            void shrink_to_fit() {
+                if (!slabs_) {
+                    return;
+                }
+
+                using slab_allocator = typename alloc_traits::template rebind_alloc<slab_header*>;
+                using count_allocator = typename alloc_traits::template rebind_alloc<std::size_t>;
+
+                std::vector<slab_header*, slab_allocator> slabs{slab_allocator(alloc_)};
+                for (auto slab = slabs_; slab; slab = slab->next_) {
+                    slabs.push_back(slab);
+                }
+                std::vector<std::size_t, count_allocator> free_count(slabs.size(), 0, count_allocator(alloc_));
+
+                std::sort(slabs.begin(), slabs.end(), std::less<>{});
+
+                // index of the slab the slot belongs to, or slabs.size() for a slot of a slab of another pool
+                auto slab_of = [&slabs](const void* slot) {
+                    auto it = std::upper_bound(slabs.begin(), slabs.end(), slot,
+                                               [](const void* p, slab_header* s) { return std::less<>{}(p, s); });
+                    if (it == slabs.begin() || !std::less<>{}(slot, first_slot(*(it - 1)) + (*(it - 1))->count_)) {
+                        return slabs.size();
+                    }
+                    return static_cast<std::size_t>(it - slabs.begin()) - 1;
+                };
+
+                flush_bump();
+                bump_ = bump_end_ = nullptr;
+
+                for (auto slot = free_; slot; slot = slot->next_) {
+                    if (auto ind = slab_of(slot); ind != slabs.size()) {
+                        ++free_count[ind];
+                    }
+                }
+
+                // drop the slots of the slabs that are about to be released from the free list
+                free_slot* kept{};
+                for (auto slot = free_; slot;) {
+                    auto next = slot->next_;
+                    auto ind = slab_of(slot);
+                    if (ind == slabs.size() || free_count[ind] != slabs[ind]->count_) {
+                        if (!kept) {
+                            last_free_ = slot;
+                        }
+                        slot->next_ = kept;
+                        kept = slot;
+                    }
+                    slot = next;
+                }
+                free_ = kept;
+
+                slabs_ = nullptr;
+                for (std::size_t ind = 0; ind < slabs.size(); ++ind) {
+                    if (free_count[ind] == slabs[ind]->count_) {
+                        deallocate_slab(slabs[ind]);
+                    } else {
+                        if (!slabs_) {
+                            last_slab_ = slabs[ind];
+                        }
+                        slabs[ind]->next_ = slabs_;
+                        slabs_ = slabs[ind];
+                    }
+                }
+            }
+
+            /**
+             * @brief Returns all the slabs to the allocator
+             *
+             * If nodes moved between this pool and others, the slabs go to the shared store instead and are
+             * returned when the last of those pools is released.
+             *
+             * @note None of the nodes of this pool can be in use anymore.
+             */
+            void release() noexcept {
+                if (store_) {
+                    if (slabs_) {
+                        push_released(store_, slabs_, last_slab_);
+                    }
+                    unref(std::exchange(store_, nullptr));
+                } else {
+                    while (slabs_) {
+                        deallocate_slab(std::exchange(slabs_, slabs_->next_));
+                    }
+                }
+                slabs_ = last_slab_ = nullptr;
+                free_ = last_free_ = nullptr;
+                bump_ = bump_end_ = nullptr;
+                capacity_ = 0;
+            }
+
+            /**
+             * @brief Lets nodes move between this pool and other, both must use equal allocators
+             *
+             * Afterwards the slabs of both pools are only returned to the allocator when both pools are released.
+             * The first time two pools without a store share their slabs, a small store is allocated for them.
+             *
+             * @param other pool to share the slabs with
+             */
+            void share_slabs(node_pool& other) {
+                if (this == &other) {
+                    return;
+                }
+                if (!store_ && !other.store_) {
+                    store_ = other.store_ = make_store(2);
+                } else if (!store_) {
+                    other.store_->refs_.fetch_add(1, std::memory_order_relaxed);
+                    store_ = other.store_;
+                } else if (!other.store_) {
+                    store_->refs_.fetch_add(1, std::memory_order_relaxed);
+                    other.store_ = store_;
+                } else {
+                    join_stores(other);
+                }
+            }
+
+            /**
+             * @brief Moves count nodes in use from other to this pool, after share_slabs()
+             *
+             * The nodes are not touched, only the capacities change.
+             */
+            void take_nodes(node_pool& other, std::size_t count) noexcept {
+                capacity_ += count;
+                other.capacity_ -= count;
+            }
+
+            /**
+             * @brief Releases the slabs of this pool and takes over the slabs of other
+             *
+             * @param other pool to take the slabs from, it must use an allocator equal to this one
+             */
+            void take_slabs(node_pool& other) noexcept {
+                release();
+                steal(other);
+            }
+
+            /**
+             * @brief Adds the slabs of other to this pool, keeping the slabs of this pool
+             *
+             * Afterwards the nodes allocated from other belong to this pool. The slab chains and the free lists
+             * are concatenated in O(1); at most one slab worth of never used slots is moved to the free list.
+             *
+             * @param other pool to take the slabs from, it must use an allocator equal to this one
+             */
+            void adopt(node_pool& other) noexcept {
+                if (other.store_) {
+                    // nodes of the slabs of other may be in use by other pools, the slabs have to stay in its store
+                    share_slabs(other);
+                }
+                if (bump_ == bump_end_) {
+                    bump_ = other.bump_;
+                    bump_end_ = other.bump_end_;
+                } else {
+                    other.flush_bump();
+                }
+                if (other.free_) {
+                    other.last_free_->next_ = free_;
+                    if (!free_) {
+                        last_free_ = other.last_free_;
+                    }
+                    free_ = other.free_;
+                }
+                if (other.slabs_) {
+                    other.last_slab_->next_ = slabs_;
+                    if (!slabs_) {
+                        last_slab_ = other.last_slab_;
+                    }
+                    slabs_ = other.slabs_;
+                }
+                capacity_ += other.capacity_;
+
+                other.slabs_ = other.last_slab_ = nullptr;
+                other.free_ = other.last_free_ = nullptr;
+                other.bump_ = other.bump_end_ = nullptr;
+                other.capacity_ = 0;
+            }
+
+            /**
+             * @brief Swaps the slabs of two pools
+             *
+             * @param other pool to swap with
+             * @param swap_allocators if true the allocators are swapped as well
+             */
+            void swap(node_pool& other, bool swap_allocators) noexcept {
+                if (swap_allocators) {
+                    using std::swap;
+                    swap(alloc_, other.alloc_);
+                }
+                std::swap(slabs_, other.slabs_);
+                std::swap(free_, other.free_);
+                std::swap(last_slab_, other.last_slab_);
+                std::swap(last_free_, other.last_free_);
+                std::swap(bump_, other.bump_);
+                std::swap(bump_end_, other.bump_end_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(store_, other.store_);
+            }
         };
 
         template<typename T, typename NodeT = list_node_base>
         struct list_iterator {
             // list is a friend of the iterator
-            template<typename> friend
+            template<typename, typename, typename> friend
             class ::saxion::list;
 
             // use node_t as the node type for the iterator
@@ -194,30 +1022,73 @@ namespace saxion {
 
             node_t* current_;
 
-            // TODO: define the type aliases
-            // Remark: the type aliases are the same as for the const_iterator with the exception of the `reference` and `pointer` types
-            //         there are no other differences between the const and non-const iterator classes!
+            using value_type = T;
+            using reference = T&;
+            using pointer = T*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            list_iterator() noexcept:
+                current_{}
+            {}
+
+            explicit list_iterator(node_t* node) noexcept:
+                current_{node}
+            {}
+
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
 
-            // TODO: constructor that takes a node as an argument and initialized current_ with it
+            list_iterator& operator++() noexcept {
+                current_ = current_->next();
+                return *this;
+            }
 
-            // TODO: node() function
+            list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
 
-            // TODO: pre- and post- increment operators
+            list_iterator& operator--() noexcept {
+                current_ = current_->prev();
+                return *this;
+            }
 
-            // TODO: pre- and post- decrement operators
+            list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
 
-            // TODO: dereference operator (*)
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<list_node<T>*>(current_)->value();
+            }
 
-            // TODO: member access operator (->)
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(**this);
+            }
 
-            // TODO: equality and inequality operators, they can be member or friend functions
+            [[nodiscard]]
+            friend bool operator==(const list_iterator& lhs, const list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
 
+            [[nodiscard]]
+            friend bool operator!=(const list_iterator& lhs, const list_iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
         };
 
         template<typename T, typename NodeT = list_node_base>
         struct const_list_iterator {
             // list is a friend of the iterator
-            template<typename> friend
+            template<typename, typename, typename> friend
             class ::saxion::list;
 
             // use node_t as the node type for the iterator
@@ -225,23 +1096,72 @@ namespace saxion {
 
             node_t* current_;
 
-            // TODO: define the type aliases
-            // Remark: the type aliases are the same as for the non-const iterator with the exception of the `reference` and `pointer` types
-            //         there are no other differences between the const and non-const iterator classes!
+            using value_type = T;
+            using reference = T const&;
+            using pointer = T const*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
 
-            // TODO: constructor that takes a node as an argument and initialized current_ with it
+            const_list_iterator() noexcept:
+                current_{}
+            {}
 
-            // TODO: node() function
+            explicit const_list_iterator(node_t* node) noexcept:
+                current_{node}
+            {}
 
-            // TODO: pre- and post- increment operators
+            /// a non-const iterator can always be used where a const one is expected
+            const_list_iterator(const list_iterator<T, NodeT>& other) noexcept:
+                current_{other.current_}
+            {}
+
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            const_list_iterator& operator++() noexcept {
+                current_ = current_->next();
+                return *this;
+            }
 
-            // TODO: pre- and post- decrement operators
+            const_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            const_list_iterator& operator--() noexcept {
+                current_ = current_->prev();
+                return *this;
+            }
 
-            // TODO: dereference operator (*)
+            const_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
 
-            // TODO: member access operator (->)
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<const list_node<T>*>(current_)->value();
+            }
 
-            // TODO: equality and inequality operators, they can be member or friend functions
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(**this);
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const const_list_iterator& lhs, const const_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const const_list_iterator& lhs, const const_list_iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
         };
 
         template <typename T, typename NodeT>
@@ -257,28 +1177,85 @@ namespace saxion {
         }
     }
 
+    namespace detail {
+
+        /**
+         * @brief Estimates the memory an element owns outside of itself
+         *
+         * For types with data() and capacity() (std::string, std::vector, ...) it's the capacity, unless the data
+         * is inside the object (small string optimization). Other types are assumed to own nothing.
+         */
+        template<typename T>
+        [[nodiscard]]
+        std::size_t owned_heap_bytes(const T& value) noexcept {
+            if constexpr (requires { value.data(); value.capacity(); }) {
+                auto data = reinterpret_cast<const std::byte*>(std::to_address(value.data()));
+                auto self = reinterpret_cast<const std::byte*>(std::addressof(value));
+                if (value.capacity() == 0 || (!std::less<>{}(data, self) && std::less<>{}(data, self + sizeof(T)))) {
+                    return 0;
+                }
+                // strings keep a terminator after their capacity
+                std::size_t terminator = requires { value.c_str(); } ? 1 : 0;
+                return (value.capacity() + terminator) * sizeof(*value.data());
+            } else {
+                return 0;
+            }
+        }
+    }
+
     /**
      * @brief Doubly-linked list
-     * 
+     *
+     * All the nodes are allocated with (a rebound copy of) the allocator, using std::allocator_traits.
+     * The allocator is propagated on copy, move and swap according to its propagate_on_container_* traits.
+     *
+     * The nodes are taken from a per-list pool of slabs (see detail::node_pool). Erased nodes are recycled,
+     * so once the list reached its capacity pushing and popping elements doesn't allocate anymore. A splice
+     * between two lists relinks the nodes, the pools of the two lists share their slabs from then on.
+     *
      * @tparam T type of the elements
+     * @tparam Allocator allocator used for the elements (rebound to allocate the nodes)
+     * @tparam Observer hooks called on the mutating operations (see list_observer)
      */
-    template<typename T>
+    template<typename T, typename Allocator, typename Observer>
     class list {
     public:
         using value_type = T;
+        using allocator_type = Allocator;
         using reference = T&;
         using const_reference = T const&;
         using pointer = T*;
         using const_pointer = T const*;
         using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>,
+                      "Allocator::value_type must be the same as the value_type of the list");
 
     private:
+        // lists with other observers splice their nodes into this one
+        template<typename, typename, typename> friend
+        class list;
 
         using node_t = detail::list_node<T>;
         using sentinel_node_t = detail::list_node_sentinel;
 
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using node_allocator_type = typename alloc_traits::template rebind_alloc<node_t>;
+        using node_alloc_traits = std::allocator_traits<node_allocator_type>;
+
+        static_assert(std::is_same_v<typename node_alloc_traits::pointer, node_t*>,
+                      "Allocators with fancy pointers are not supported");
+
+        using pool_t = detail::node_pool<node_t, node_allocator_type>;
+
+        pool_t pool_;
+
         sentinel_node_t node_{};
 
+        // mutable: copying a const list is reported to the observer of that list too
+        [[no_unique_address]] mutable Observer observer_{};
+
         [[nodiscard]]
         detail::list_node_base* tail() const noexcept{
             return node_.prev();
@@ -289,6 +1266,270 @@ namespace saxion {
             return node_.next();
         }
 
+        /**
+         * @brief Allocates and constructs a new node, the node is not linked
+         *
+         * The value is constructed in place with the element allocator (uses-allocator construction for
+         * allocators such as std::pmr::polymorphic_allocator).
+         *
+         * @param args arguments passed to the constructor of the value
+         * @return pointer to the new node
+         */
+        template<typename... Args>
+        node_t* create_node(Args&&... args) {
+            auto node = pool_.allocate();
+            node_alloc_traits::construct(pool_.allocator(), node);
+            try {
+                allocator_type value_alloc(pool_.allocator());
+                alloc_traits::construct(value_alloc, std::addressof(node->value_), std::forward<Args>(args)...);
+            } catch (...) {
+                node_alloc_traits::destroy(pool_.allocator(), node);
+                pool_.deallocate(node);
+                throw;
+            }
+            observer_.on_node_allocate(*this);
+            if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...)) {
+                if constexpr ((std::is_rvalue_reference_v<Args&&> && ...) && !(std::is_const_v<std::remove_reference_t<Args>> && ...)) {
+                    observer_.on_element_move(*this);
+                } else {
+                    observer_.on_element_copy(*this);
+                }
+            }
+            return node;
+        }
+
+        /// destroys the value stored in a node and the node itself, the storage is not released
+        void destroy_value(detail::list_node_base* node) noexcept {
+            auto value_node = static_cast<node_t*>(node);
+            allocator_type value_alloc(pool_.allocator());
+            alloc_traits::destroy(value_alloc, std::addressof(value_node->value_));
+            node_alloc_traits::destroy(pool_.allocator(), value_node);
+        }
+
+        /**
+         * @brief Destroys and deallocates a node, the node must be already unlinked
+         *
+         * @param node node to destroy
+         */
+        void destroy_node(detail::list_node_base* node) noexcept {
+            destroy_value(node);
+            pool_.deallocate(static_cast<node_t*>(node));
+            observer_.on_node_free(*this, 1);
+        }
+
+        /**
+         * @brief Creates a node and links it before the given position
+         *
+         * @param pos node to link before
+         * @param args arguments passed to the constructor of the value
+         * @return pointer to the new node
+         */
+        template<typename... Args>
+        node_t* link_new_node(detail::list_node_base* pos, Args&&... args) {
+            auto node = create_node(std::forward<Args>(args)...);
+            node->hook_before(pos);
+            node_.inc_size();
+            return node;
+        }
+
+        /**
+         * @brief Creates nodes for the elements [first, last) and links them before pos in one step
+         *
+         * The new nodes are first linked to each other only, then the whole chain is linked into the list with
+         * a single relink and size update. For forward ranges the pool grows at most once, by one slab that holds
+         * the whole range or the pool's usual growth step, whichever is larger. If constructing an element throws, the new nodes are destroyed and the list is unchanged.
+         *
+         * @param pos node to link before
+         * @param first begin of the range
+         * @param last end of the range
+         * @return the first new node, or pos if the range is empty
+         */
+        template<typename Iter, typename Sentinel>
+        detail::list_node_base* link_new_chain(detail::list_node_base* pos, Iter first, Sentinel last) {
+            if constexpr (std::forward_iterator<Iter>) {
+                pool_.grow_to(size() + static_cast<size_type>(std::ranges::distance(first, last)));
+            }
+
+            detail::list_node_base* chain_first = nullptr;
+            detail::list_node_base* chain_last = nullptr;
+            size_type n = 0;
+            try {
+                for (; first != last; ++first, ++n) {
+                    auto node = create_node(*first);
+                    node->prev_ = chain_last;
+                    if (chain_last) {
+                        chain_last->next_ = node;
+                    } else {
+                        chain_first = node;
+                    }
+                    chain_last = node;
+                }
+            } catch (...) {
+                while (chain_last) {
+                    destroy_node(std::exchange(chain_last, chain_last->prev_));
+                }
+                throw;
+            }
+
+            if (!chain_first) {
+                return pos;
+            }
+            link_block(pos, chain_first, chain_last);
+            node_.inc_size(n);
+            return chain_first;
+        }
+
+        /// destroys all the nodes, the clear() that isn't reported to the observer
+        void clear_nodes() noexcept {
+            auto current = head();
+            while (current != &node_) {
+                auto next = current->next();
+                destroy_node(current);
+                current = next;
+            }
+            node_.reset();
+        }
+
+        /// reports the insertion of the count elements starting at first, returns first
+        detail::list_node_base* inserted(detail::list_node_base* first, size_type count) noexcept {
+            if (count) {
+                observer_.on_insert(*this, const_iterator(first), count);
+            }
+            return first;
+        }
+
+        /// reports the append of node by push_back() or emplace_back(), returns node
+        detail::list_node_base* pushed_back(detail::list_node_base* node) noexcept {
+            inserted(node, 1);
+            observer_.on_push_back(*this);
+            return node;
+        }
+
+        /// link_new_chain() for the public inserts, reported to the observer
+        template<typename Iter, typename Sentinel>
+        detail::list_node_base* link_new_chain_reported(detail::list_node_base* pos, Iter first, Sentinel last) {
+            auto old_size = size();
+            auto chain = link_new_chain(pos, std::move(first), std::move(last));
+            return inserted(chain, size() - old_size);
+        }
+
+        /// appends copies of all the elements of other
+        void append_copies(const list& other) {
+            link_new_chain(&node_, other.begin(), other.end());
+        }
+
+        /// appends all the elements of other by moving them, other keeps its (moved-from) elements
+        void append_moved(list& other) {
+            link_new_chain(&node_, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        }
+
+        /// destroys the nodes of a chain linked through next_ and terminated by nullptr, in one pass
+        void destroy_chain(detail::list_node_base* chain) noexcept {
+            while (chain) {
+                destroy_node(std::exchange(chain, chain->next()));
+            }
+        }
+
+        /**
+         * @brief Links the unhooked block of nodes [first, last] before pos
+         *
+         * @param pos node to link before
+         * @param first first node of the block
+         * @param last last node of the block (inclusive)
+         */
+        static void link_block(detail::list_node_base* pos, detail::list_node_base* first, detail::list_node_base* last) noexcept {
+            first->prev_ = pos->prev_;
+            last->next_ = pos;
+            pos->prev_->next_ = first;
+            pos->prev_ = last;
+        }
+
+        /**
+         * @brief Unhooks the nodes [first, last) as one block
+         *
+         * @return the last node of the block, its next_ still points to last
+         */
+        static detail::list_node_base* unhook_block(detail::list_node_base* first, detail::list_node_base* last) noexcept {
+            auto block_last = last->prev_;
+            first->prev_->next_ = last;
+            last->prev_ = first->prev_;
+            return block_last;
+        }
+
+        /**
+         * @brief Moves all the elements of other before pos
+         *
+         * With equal allocators the nodes are relinked and the pool of other is adopted, in O(1).
+         * Otherwise the values are moved to new nodes and other is cleared.
+         */
+        template<typename OtherObserver>
+        void splice_all(detail::list_node_base* pos, list<T, Allocator, OtherObserver>& other) {
+            if (static_cast<const void*>(this) == &other || other.empty()) {
+                return;
+            }
+            if (pool_.allocator() == other.pool_.allocator()) {
+                auto n = other.size();
+                auto first = other.head();
+                auto last = other.tail();
+                other.node_.reset();
+                link_block(pos, first, last);
+                node_.inc_size(n);
+                pool_.adopt(other.pool_);
+            } else {
+                link_new_chain(pos, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear_nodes();
+            }
+        }
+
+        /**
+         * @brief Moves the elements [first, last) of other before pos
+         *
+         * The nodes are relinked. The nodes of another list stay in the slabs of its pool: the two pools share
+         * their slabs from then on (see detail::node_pool::share_slabs()).
+         *
+         * @throws std::invalid_argument if other is another list with an allocator that isn't equal to this one
+         */
+        void splice_range(detail::list_node_base* pos, list& other, detail::list_node_base* first, detail::list_node_base* last) {
+            if (first == last) {
+                return;
+            }
+            if (this == &other) {
+                if (pos != last) {
+                    link_block(pos, first, unhook_block(first, last));
+                }
+                return;
+            }
+            if (pool_.allocator() != other.pool_.allocator()) {
+                throw std::invalid_argument("saxion::list::splice: the lists have different allocators");
+            }
+            auto n = static_cast<size_type>(std::distance(iterator(first), iterator(last)));
+            pool_.share_slabs(other.pool_);
+            link_block(pos, first, unhook_block(first, last));
+            other.node_.dec_size(n);
+            node_.inc_size(n);
+            pool_.take_nodes(other.pool_, n);
+        }
+
+        /**
+         * @brief Merges the sorted run starting at second into the sorted run before it
+         *
+         * @param second first node of the second run
+         * @param less compares two nodes
+         */
+        template<typename Less>
+        void merge_runs(detail::list_node_base* second, Less less) {
+            detail::list_node_base* first = head();
+            second->prev_->next_ = nullptr;
+            tail()->next_ = nullptr;
+            try {
+                detail::merge_chains(first, second, less);
+            } catch (...) {
+                detail::relink_chain(&node_, first);
+                throw;
+            }
+            detail::relink_chain(&node_, first);
+        }
+
     public:
 
         using iterator = detail::list_iterator<T, detail::list_node_base>;
@@ -296,107 +1537,188 @@ namespace saxion {
 
         /**
          * @brief Construct a new, empty list object
-         * 
+         *
          */
-        list() :
+        list() noexcept(noexcept(Allocator())) :
+                list(Allocator())
+                 { }
+
+        /**
+         * @brief Construct a new, empty list object using the given allocator
+         *
+         * @param alloc allocator used for the nodes
+         */
+        explicit list(const Allocator& alloc) noexcept :
+                pool_(node_allocator_type(alloc)),
                 node_{}
                  { }
 
         /**
          * @brief Construct a new list object from an initializer list
-         * 
+         *
          * @tparam U type of the elements in the initializer list
          * @param init_list initializer list
+         * @param alloc allocator used for the nodes
          */
-        template<class U>
-        list(std::initializer_list<U> init_list) :
-                list{} {
-            for (auto item : init_list) {
-                push_back(std::move(item));
-            }
+        template<class U, typename = std::enable_if_t<std::is_constructible_v<T, const U&>>>
+        list(std::initializer_list<U> init_list, const Allocator& alloc = Allocator()) :
+                list(alloc) {
+            link_new_chain(&node_, init_list.begin(), init_list.end());
         }
 
         /**
          * @brief Copy constructor
-         * 
+         *
+         * @note The allocator is obtained with select_on_container_copy_construction.
+         *
          * @param list to create a copy of
          */
         list(const list& other) :
-                list{} {
-            for (auto othernext_{other.head()};
-                 othernext_->next() != other.head();
-                 othernext_ = othernext_->next()) {
+                list(alloc_traits::select_on_container_copy_construction(other.get_allocator())) {
+            other.observer_.on_copied(other);
+            append_copies(other);
+        }
 
-                push_back(static_cast<node_t*>(othernext_)->value());
-            }
+        /**
+         * @brief Copy constructor using the given allocator
+         *
+         * @param list to create a copy of
+         * @param alloc allocator used for the nodes
+         */
+        list(const list& other, const std::type_identity_t<Allocator>& alloc) :
+                list(alloc) {
+            other.observer_.on_copied(other);
+            append_copies(other);
         }
 
         /**
          * @brief Copy assignment operator
-         * 
+         *
          * @param other list to copy
          * @return reference to self
          */
         list& operator=(const list& other) {
             if (this != &other) {
-                clear();
-
-                for (auto othernext_{other.head()};
-                     othernext_->next() != other.head();
-                     othernext_ = othernext_->next()) {
-
-                    push_back(static_cast<node_t*>(othernext_)->value());
+                observer_.on_copy_assign(*this, other);
+                other.observer_.on_copied(other);
+                clear_nodes();
+
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                    if (pool_.allocator() != other.pool_.allocator()) {
+                        pool_.release();
+                    }
+                    pool_.allocator() = other.pool_.allocator();
                 }
+
+                append_copies(other);
             }
             return *this;
         }
 
         /**
          * @brief Move constructor
-         * 
-         * @param other list to move from 
+         *
+         * @param other list to move from
          */
         list(list&& other) noexcept :
-                list{} {
-            swap(other);
+                pool_(std::move(other.pool_)),
+                node_{} {
+            other.observer_.on_moved(other);
+            node_.swap(other.node_);
+        }
+
+        /**
+         * @brief Move constructor using the given allocator
+         *
+         * @note If the allocators differ, the elements are moved one by one into new nodes.
+         *
+         * @param other list to move from
+         * @param alloc allocator used for the nodes
+         */
+        list(list&& other, const std::type_identity_t<Allocator>& alloc) :
+                list(alloc) {
+            other.observer_.on_moved(other);
+            if (pool_.allocator() == other.pool_.allocator()) {
+                pool_.take_slabs(other.pool_);
+                node_.swap(other.node_);
+            } else {
+                append_moved(other);
+                other.clear_nodes();
+            }
         }
 
         /**
          * @brief Move assignment operator
-         * 
+         *
+         * @note If the allocator doesn't propagate and the allocators differ, the elements are moved one by one.
+         *
          * @param other list to move from
          * @return return reference to self
          */
-        list& operator=(list&& other) noexcept {
+        list& operator=(list&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                               alloc_traits::is_always_equal::value) {
             if (this != &other) {
-                clear();
-                swap(other);
+                observer_.on_move_assign(*this, other);
+                other.observer_.on_moved(other);
+                clear_nodes();
+
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                    pool_.release();
+                    pool_.allocator() = other.pool_.allocator();
+                    pool_.take_slabs(other.pool_);
+                    node_.swap(other.node_);
+                } else if (pool_.allocator() == other.pool_.allocator()) {
+                    pool_.take_slabs(other.pool_);
+                    node_.swap(other.node_);
+                } else {
+                    append_moved(other);
+                    other.clear_nodes();
+                }
             }
             return *this;
         }
 
         /**
          * @brief Construct a new list object from a range
-         * 
+         *
          * @tparam _Iter type of the iterator
          * @param begin begin of the range
          * @param end end of the range
+         * @param alloc allocator used for the nodes
          */
         template<typename _Iter, typename = std::enable_if_t<
                 std::is_same_v<
                         typename std::iterator_traits<_Iter>::value_type,
                         value_type >>>
-        list(_Iter begin, _Iter end):
-                list() {
-            for (; begin != end; ++begin) {
-                push_back(*begin);
-            }
+        list(_Iter begin, _Iter end, const Allocator& alloc = Allocator()):
+                list(alloc) {
+            link_new_chain(&node_, begin, end);
+        }
+
+        /**
+         * @brief Returns a copy of the allocator used by the list
+         *
+         * @return allocator_type
+         */
+        [[nodiscard]]
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(pool_.allocator());
+        }
+
+        /**
+         * @brief Returns the observer of the list, e.g. to attach a trace to a trace_recorder
+         *
+         * @return reference to the observer
+         */
+        [[nodiscard]]
+        Observer& observer() const noexcept {
+            return observer_;
         }
 
         /**
          * @brief Returns an iterator to the first element of the list
-         * 
-         * @return iterator 
+         *
+         * @return iterator
          */
         [[nodiscard]]
         iterator begin() noexcept {
@@ -405,8 +1727,8 @@ namespace saxion {
 
         /**
          * @brief Returns an iterator to the end of the list
-         * 
-         * @return iterator 
+         *
+         * @return iterator
          */
         [[nodiscard]]
         iterator end() noexcept {
@@ -415,8 +1737,8 @@ namespace saxion {
 
         /**
          * @brief Returns a const iterator to the first element of the list
-         * 
-         * @return const_iterator 
+         *
+         * @return const_iterator
          */
         [[nodiscard]]
         const_iterator begin() const noexcept {
@@ -425,45 +1747,51 @@ namespace saxion {
 
         /**
          * @brief Returns a const iterator to the end of the list
-         * 
-         * @return const_iterator 
+         *
+         * @return const_iterator
          */
         [[nodiscard]]
         const_iterator end() const noexcept {
-            return const_iterator(&node_);
+            return const_iterator(const_cast<sentinel_node_t*>(&node_));
         }
 
         /**
          * @brief Returns a const iterator to the first element of the list
-         * 
-         * @return const_iterator 
+         *
+         * @return const_iterator
          */
         [[nodiscard]]
         const_iterator cbegin() const noexcept {
-            return const_iterator(node_.next());
+            return begin();
         }
 
         /**
          * @brief Returns a const iterator to the end of the list
-         * 
-         * @return const_iterator 
+         *
+         * @return const_iterator
          */
         [[nodiscard]]
         const_iterator cend() const noexcept {
-            return const_iterator(&node_);
+            return end();
         }
 
+        /**
+         * @brief Swaps the contents of two lists
+         *
+         * @note The allocators are swapped only if they propagate on swap.
+         *
+         * @param other list to swap with
+         */
         void swap(list& other) noexcept {
-            std::swap(head()->prev_, other.head()->prev_);
+            pool_.swap(other.pool_, alloc_traits::propagate_on_container_swap::value);
             node_.swap(other.node_);
-            std::swap(tail()->next_, other.tail()->next_);
         }
 
 
         /**
          * @brief Returns a reference to the first element of the list
-         * 
-         * @return reference 
+         *
+         * @return reference
          */
         [[nodiscard]]
         reference front() {
@@ -472,8 +1800,8 @@ namespace saxion {
 
         /**
          * @brief Returns a const reference to the first element of the list
-         * 
-         * @return const_reference 
+         *
+         * @return const_reference
          */
         [[nodiscard]]
         const_reference front() const {
@@ -482,8 +1810,8 @@ namespace saxion {
 
         /**
          * @brief Returns a reference to the last element of the list
-         * 
-         * @return reference 
+         *
+         * @return reference
          */
         [[nodiscard]]
         reference back() {
@@ -492,8 +1820,8 @@ namespace saxion {
 
         /**
          * @brief Returns a const reference to the last element of the list
-         * 
-         * @return const_reference 
+         *
+         * @return const_reference
          */
         [[nodiscard]]
         const_reference back() const {
@@ -502,13 +1830,14 @@ namespace saxion {
 
         /**
          * @brief Returns a reference to the element at the given index
-         * 
-         * @param index 
+         *
+         * @param index
          * @return reference to the element
-         * @note This function is slow. Do not use it.
+         * @note This function is O(n), saxion::indexed_list provides O(log n) positional access.
          */
         [[nodiscard]]
         reference operator[](size_type index) {
+            observer_.on_walk(*this, index);
             auto current = head();
             while (index--) { current = current->next(); }
             return static_cast<node_t*>(current)->value();
@@ -516,13 +1845,14 @@ namespace saxion {
 
         /**
          * @brief Returns a const reference to the element at the given index
-         * 
-         * @param index 
+         *
+         * @param index
          * @return const reference to the element
-         * @note This function is slow. Do not use it.
+         * @note This function is O(n), saxion::indexed_list provides O(log n) positional access.
          */
         [[nodiscard]]
         const_reference operator[](size_type index) const {
+            observer_.on_walk(*this, index);
             auto current = head();
             while (index--) { current = current->next(); }
             return static_cast<node_t*>(current)->value();
@@ -530,15 +1860,16 @@ namespace saxion {
 
         /**
          * @brief Returns a reference to the element at the given index
-         * 
-         * @param index 
+         *
+         * @param index
          * @return reference to the element
          * @throw std::length_error if index is out of bounds
-         * @note This function is slow. Do not use it.
+         * @note This function is O(n), saxion::indexed_list provides O(log n) positional access.
          */
         [[nodiscard]]
         reference at(size_type index) {
             if (index < node_.size()) {
+                observer_.on_walk(*this, index);
                 auto current = head();
                 while (index--) { current = current->next(); }
                 return static_cast<node_t*>(current)->value();
@@ -548,15 +1879,16 @@ namespace saxion {
 
         /**
          * @brief Returns a const reference to the element at the given index
-         * 
-         * @param index 
+         *
+         * @param index
          * @return const reference to the element
          * @throw std::length_error if index is out of bounds
-         * @note This function is slow. Do not use it.
+         * @note This function is O(n), saxion::indexed_list provides O(log n) positional access.
          */
         [[nodiscard]]
         const_reference at(size_type index) const {
             if (index < node_.size()) {
+                observer_.on_walk(*this, index);
                 auto current = head();
                 while (index--) { current = current->next(); }
                 return static_cast<node_t*>(current)->value();
@@ -566,31 +1898,35 @@ namespace saxion {
 
         /**
          * @brief Removes the first element of the list
-         * 
+         *
          */
         void pop_front() noexcept {
             if (node_.prev_ != std::addressof(node_)) {
-                node_.next_ = std::move(node_.next_->next_);
-                head()->prev_ = &node_;
+                auto node = head();
+                observer_.on_erase(*this, const_iterator(node), 1);
+                node->unhook();
+                destroy_node(node);
                 node_.dec_size();
             }
         }
 
         /**
          * @brief Removes the last element of the list
-         * 
+         *
          */
         void pop_back() noexcept {
             if (node_.prev_ != std::addressof(node_)) {
-                node_.prev_ = node_.prev()->prev();
-                tail()->next_ = std::move(tail()->next()->next_);
+                auto node = tail();
+                observer_.on_erase(*this, const_iterator(node), 1);
+                node->unhook();
+                destroy_node(node);
                 node_.dec_size();
             }
         }
 
         /**
          * @brief Returns true if the list is empty
-         * 
+         *
          * @return true if list is empty
          * @return false if list is not empty
          */
@@ -601,8 +1937,8 @@ namespace saxion {
 
         /**
          * @brief Returns the size of the list
-         * 
-         * @return size_type 
+         *
+         * @return size_type
          */
         [[nodiscard]]
         size_type size() const {
@@ -610,101 +1946,182 @@ namespace saxion {
         }
 
         /**
-         * @brief Clears the list
-         * 
-         * @note This function might be slow. Do not use it;).
+         * @brief Returns the number of elements the list can hold without allocating
+         *
+         * @return size_type
          */
-        void clear() noexcept {
-            if (node_.prev_ != std::addressof(node_)) {
-                // unlink the nodes iteratively
-                while (head() != &node_) {
-                    node_.next_ = std::move(node_.next_->next_);
-                    node_.next_->prev_ = &node_;
-                    node_.dec_size();
+        [[nodiscard]]
+        size_type capacity() const noexcept {
+            return pool_.capacity();
+        }
+
+        /**
+         * @brief Makes sure the list can hold at least n elements without allocating
+         *
+         * @note All the missing nodes are allocated at once.
+         *
+         * @param n requested capacity
+         */
+        void reserve(size_type n) {
+            pool_.reserve(n);
+        }
+
+        /**
+         * @brief Returns the memory of the unused nodes to the allocator
+         *
+         * @note Only the slabs without any element in them can be released. Slabs shared with other lists by
+         *       splices are kept until the last of those lists is destroyed.
+         */
+        void shrink_to_fit() {
+            pool_.shrink_to_fit();
+        }
+
+        /**
+         * @brief Returns the memory used by the list: its nodes split into links, values and padding, the memory
+         *        owned by the elements and the slack of the node pool
+         *
+         * @note O(1) for elements that own no memory, otherwise the list is walked to add up their capacities.
+         */
+        [[nodiscard]]
+        list_memory_usage memory_usage() const noexcept {
+            list_memory_usage usage;
+            usage.elements = size();
+            usage.slabs = pool_.slab_count();
+            usage.link_bytes = size() * sizeof(detail::list_node_base);
+            usage.value_bytes = size() * sizeof(T);
+            usage.padding_bytes = size() * (sizeof(node_t) - sizeof(detail::list_node_base) - sizeof(T));
+            usage.slack_bytes = (pool_.capacity() - size() + usage.slabs) * sizeof(node_t);
+            usage.list_bytes = sizeof(list);
+            if constexpr (requires (const T& v) { v.data(); v.capacity(); }) {
+                for (const auto& value : *this) {
+                    usage.heap_bytes += detail::owned_heap_bytes(value);
                 }
             }
+            return usage;
+        }
+
+        /**
+         * @brief Walks the list and measures how far apart successive nodes are in memory
+         *
+         * A diagnostic for deciding when a long-lived list has become scattered enough to be worth copying into
+         * a fresh one, O(n).
+         */
+        [[nodiscard]]
+        list_locality locality_report() const noexcept {
+            list_locality report;
+            double log_sum = 0;
+            for (auto node = head(); node != &node_ && node->next() != &node_; node = node->next()) {
+                auto from = reinterpret_cast<std::uintptr_t>(node);
+                auto to = reinterpret_cast<std::uintptr_t>(node->next());
+                auto distance = to > from ? to - from : from - to;
+                ++report.links;
+                report.sequential += to == from + sizeof(node_t);
+                report.same_page += to / list_locality::page_size == from / list_locality::page_size;
+                report.backward += to < from;
+                report.max_distance = std::max<std::size_t>(report.max_distance, distance);
+                log_sum += std::log2(static_cast<double>(distance));
+            }
+            report.mean_log2_distance = report.links ? log_sum / static_cast<double>(report.links) : 0;
+            return report;
+        }
+
+        /**
+         * @brief Clears the list
+         *
+         * @note The nodes are kept for reuse, call shrink_to_fit() to release them.
+         */
+        void clear() noexcept {
+            observer_.on_clear(*this);
+            clear_nodes();
         }
 
         /**
          * @brief Destroy the list object
-         * 
+         *
+         * @note The slabs are released as a whole, the nodes are visited only to destroy their values.
          */
         ~list() noexcept {
-          tail()->next_.release();
-          auto iter = tail();
-
-          while(iter != &node_){
-              iter->next_.reset();
-              iter = iter->prev();
-          }
+            observer_.on_node_free(*this, size());
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (auto current = head(); current != &node_; current = current->next()) {
+                    destroy_value(current);
+                }
+            }
         }
 
         /**
          * @brief Appends an element to the end of the list
-         * 
+         *
          * @param rvalue reference to the object to append
          * @return iterator to the appended element
          */
         iterator push_back(T&& value) {
-            tail()->next_ = std::make_unique<node_t>(std::move(value), tail(), tail()->next_.release());
-            node_.prev_ = node_.prev_->next();
-            node_.inc_size();
-            return iterator{tail()};
+            return iterator{pushed_back(link_new_node(&node_, std::move(value)))};
         }
 
         /**
          * @brief Appends an element to the end of the list
-         * 
+         *
          * @param lvalue reference to the value to append
          * @return iterator to the appended element
          */
         iterator push_back(const_reference value) {
-            tail()->next_ = std::make_unique<node_t>(value, tail(), tail()->next_.release());
-            node_.prev_ = node_.prev_->next();
-            node_.inc_size();
-            return iterator{tail()};
+            return iterator{pushed_back(link_new_node(&node_, value))};
         }
 
         /**
          * @brief Emplaces an element to the end of the list by constructing it in-place
-         * 
+         *
          * @tparam Args types of the arguments
          * @param args arguments passed to the constructor of the element
-         * @return iterator to the appended element
+         * @return reference to the appended element
          */
         template<typename... Args>
-        iterator emplace_back(Args&& ... args) {
-            tail()->next_ = std::make_unique<node_t>(T(std::forward<Args>(args)...), tail(), tail()->next_.release());
-            node_.prev_ = node_.prev_->next();
-            node_.inc_size();
-            return iterator{tail()};
+        reference emplace_back(Args&& ... args) {
+            auto node = link_new_node(&node_, std::forward<Args>(args)...);
+            pushed_back(node);
+            return node->value();
+        }
+
+        /**
+         * @brief Emplaces an element to the front of the list by constructing it in-place
+         *
+         * @tparam Args types of the arguments
+         * @param args arguments passed to the constructor of the element
+         * @return reference to the prepended element
+         */
+        template<typename... Args>
+        reference emplace_front(Args&& ... args) {
+            auto node = link_new_node(head(), std::forward<Args>(args)...);
+            inserted(node, 1);
+            return node->value();
         }
 
         /**
          * @brief Appends an element to the front of the list
-         * 
-         * @param rvalue reference to the object to append
+         *
+         * @note The element is constructed in-place from value.
+         *
+         * @param value object to append, or the argument to construct it from
          * @return iterator to the appended element
          */
         template<typename V>
         iterator push_front(V&& value) {
-            node_.next_ = std::make_unique<node_t>(std::forward<V>(value), &node_, node_.next_.release());
-            head()->next_->prev_ = node_.next_.get();
-            node_.inc_size();
-            return iterator{head()};
+            return iterator{inserted(link_new_node(head(), std::forward<V>(value)), 1)};
         }
 
         /**
          * @brief Erases an element from the list
-         * 
+         *
          * @param pos iterator to the element to erase
          * @return iterator to the next element after the erased one
          */
         iterator erase(iterator pos) {
             if (begin() != end()){
                 auto res(pos.current_->next());
-                pos.current_->next_->prev_ = pos.current_->prev_;
-                pos.current_->prev_->next_ = std::move(pos.current_->next_);
+                observer_.on_erase(*this, const_iterator(pos.current_), 1);
+                pos.current_->unhook();
+                destroy_node(pos.current_);
                 node_.dec_size();
                 return iterator(res);
             }
@@ -713,37 +2130,29 @@ namespace saxion {
 
         /**
          * @brief Inserts an element before the given position
-         * 
+         *
          * @param pos iterator position to insert before
          * @param value an lvalue reference to the value to insert
          * @return iterator iterator to the inserted element
          */
         iterator insert(iterator pos, const_reference value) {
-            // grab previous element?
-            pos.current_->prev_->next_ = std::make_unique<node_t>(value, pos.current_->prev_, pos.current_->prev_->next_.release());
-            pos.current_->prev_ = pos.current_->prev()->next();
-            node_.inc_size();
-            return iterator(pos.current_->prev());
+            return iterator(inserted(link_new_node(pos.current_, value), 1));
         }
 
         /**
          * @brief Inserts an element before the given position
-         * 
+         *
          * @param pos iterator position to insert before
          * @param value an rvalue reference to the value to insert
          * @return iterator iterator to the inserted element
          */
         iterator insert(iterator pos, T&& value) {
-            // grab previous element?
-            pos.current_->prev_->next_ = std::make_unique<node_t>(std::move(value), pos.current_->prev_, pos.current_->prev_->next_.release());
-            pos.current_->prev_ = pos.current_->prev()->next();
-            node_.inc_size();
-            return iterator(pos.current_->prev());
+            return iterator(inserted(link_new_node(pos.current_, std::move(value)), 1));
         }
 
         /**
          * @brief Emplaces an element before the given position
-         * 
+         *
          * @tparam Args types of the arguments
          * @param pos iterator position to insert before
          * @param args arguments passed to the constructor of the element
@@ -751,30 +2160,354 @@ namespace saxion {
          */
         template<typename... Args>
         iterator emplace(iterator pos, Args&& ... args) {
-            // grab previous element?
-            pos.current_->prev_->next_ = std::make_unique<node_t>(T(std::forward<Args>(args)...), pos.current_->prev_, pos.current_->prev_->next_.release());
-            pos.current_->prev_ = pos.current_->prev()->next();
-            node_.inc_size();
-            return iterator(pos.current_->prev());
+            return iterator(inserted(link_new_node(pos.current_, std::forward<Args>(args)...), 1));
+        }
+
+        /**
+         * @brief Inserts copies of the elements [first, last) before the given position
+         *
+         * The nodes are created as one chain that is linked into the list at once. If an element can't be
+         * constructed, the list is left unchanged.
+         *
+         * @tparam _Iter type of the iterators
+         * @param pos iterator position to insert before
+         * @param first begin of the range
+         * @param last end of the range
+         * @return iterator to the first inserted element, or pos if the range is empty
+         */
+        template<typename _Iter, typename = std::enable_if_t<
+                std::is_convertible_v<typename std::iterator_traits<_Iter>::iterator_category, std::input_iterator_tag>>>
+        iterator insert(iterator pos, _Iter first, _Iter last) {
+            return iterator(link_new_chain_reported(pos.current_, first, last));
+        }
+
+        /**
+         * @brief Inserts n copies of value before the given position
+         *
+         * @param pos iterator position to insert before
+         * @param n number of copies
+         * @param value value to copy
+         * @return iterator to the first inserted element, or pos if n is 0
+         */
+        iterator insert(iterator pos, size_type n, const_reference value) {
+            auto copies = std::views::iota(size_type{}, n) |
+                          std::views::transform([&value](size_type) -> const_reference { return value; });
+            return iterator(link_new_chain_reported(pos.current_, copies.begin(), copies.end()));
+        }
+
+        /**
+         * @brief Inserts the elements of an initializer list before the given position
+         *
+         * @param pos iterator position to insert before
+         * @param init_list elements to insert
+         * @return iterator to the first inserted element, or pos if the list is empty
+         */
+        iterator insert(iterator pos, std::initializer_list<T> init_list) {
+            return iterator(link_new_chain_reported(pos.current_, init_list.begin(), init_list.end()));
+        }
+
+        /**
+         * @brief Inserts the elements of a range before the given position, in one relink
+         *
+         * @param pos iterator position to insert before
+         * @param range range of elements T can be constructed from
+         * @return iterator to the first inserted element, or pos if the range is empty
+         */
+        template<std::ranges::input_range R>
+            requires std::is_constructible_v<T, std::ranges::range_reference_t<R>>
+        iterator insert_range(iterator pos, R&& range) {
+            return iterator(link_new_chain_reported(pos.current_, std::ranges::begin(range), std::ranges::end(range)));
+        }
+
+        /**
+         * @brief Appends the elements of a range, in one relink
+         *
+         * @param range range of elements T can be constructed from
+         */
+        template<std::ranges::input_range R>
+            requires std::is_constructible_v<T, std::ranges::range_reference_t<R>>
+        void append_range(R&& range) {
+            link_new_chain_reported(&node_, std::ranges::begin(range), std::ranges::end(range));
+        }
+
+        /**
+         * @brief Prepends the elements of a range, in one relink
+         *
+         * @param range range of elements T can be constructed from
+         */
+        template<std::ranges::input_range R>
+            requires std::is_constructible_v<T, std::ranges::range_reference_t<R>>
+        void prepend_range(R&& range) {
+            link_new_chain_reported(head(), std::ranges::begin(range), std::ranges::end(range));
+        }
+
+        /**
+         * @brief Sorts the elements in ascending order
+         *
+         * The sort is stable and doesn't allocate: the nodes are relinked, the elements are never moved or
+         * copied, so iterators and references stay valid. O(n log n) comparisons.
+         */
+        void sort() {
+            sort(std::less<>{});
+        }
+
+        /**
+         * @brief Sorts the elements with the given comparator
+         *
+         * @param comp strict weak ordering of the elements
+         * @note If comp throws, all elements are still in the list, in an unspecified order.
+         */
+        template<typename Compare>
+        void sort(Compare comp) {
+            sort(std::move(comp), std::identity{});
+        }
+
+        /**
+         * @brief Sorts the elements with the given comparator applied to the projected elements
+         *
+         * @param comp strict weak ordering of the projected elements
+         * @param proj projection applied to the elements before comparing them, e.g. a pointer to member
+         * @note If comp or proj throws, all elements are still in the list, in an unspecified order.
+         */
+        template<typename Compare, typename Projection>
+        void sort(Compare comp, Projection proj) {
+            detail::sort_nodes(&node_, [&comp, &proj](detail::list_node_base* lhs, detail::list_node_base* rhs) {
+                return std::invoke(comp, std::invoke(proj, static_cast<node_t*>(lhs)->value()),
+                                   std::invoke(proj, static_cast<node_t*>(rhs)->value()));
+            });
+        }
+
+        /**
+         * @brief Moves all the elements of other before pos
+         *
+         * If the allocators are equal no element is moved or copied: the nodes are relinked and this list takes
+         * over the node pool of other, in O(1). Otherwise the values are moved to new nodes.
+         *
+         * @param pos position to insert before
+         * @param other list to take the elements from, it is empty afterwards
+         */
+        void splice(iterator pos, list& other) {
+            splice_all(pos.current_, other);
+        }
+
+        void splice(iterator pos, list&& other) {
+            splice_all(pos.current_, other);
+        }
+
+        /**
+         * @brief Moves all the elements of a list with another observer before pos, like splice(pos, other)
+         *
+         * Neither observer is told about the moved elements, as for every splice.
+         */
+        template<typename OtherObserver>
+        requires (!std::is_same_v<OtherObserver, Observer>)
+        void splice(iterator pos, list<T, Allocator, OtherObserver>& other) {
+            splice_all(pos.current_, other);
+        }
+
+        template<typename OtherObserver>
+        requires (!std::is_same_v<OtherObserver, Observer>)
+        void splice(iterator pos, list<T, Allocator, OtherObserver>&& other) {
+            splice_all(pos.current_, other);
+        }
+
+        /**
+         * @brief Moves the element it of other before pos
+         *
+         * The node is relinked, the element isn't moved: iterators and references to it stay valid and refer
+         * to this list afterwards.
+         *
+         * @param pos position to insert before
+         * @param other list that contains it, can be this list
+         * @param it element to move
+         * @throws std::invalid_argument if other is another list with an allocator that isn't equal to this one
+         * @note The first splice between two lists allocates a small store for the slabs they share from then
+         *       on: a node keeps living in the slab of the list it was created in.
+         */
+        void splice(iterator pos, list& other, iterator it) {
+            if (this == &other && pos.current_ == it.current_) {
+                return;
+            }
+            splice_range(pos.current_, other, it.current_, it.current_->next());
+        }
+
+        void splice(iterator pos, list&& other, iterator it) {
+            splice(pos, other, it);
+        }
+
+        /**
+         * @brief Moves the elements [first, last) of other before pos
+         *
+         * The nodes are relinked, iterators and references to the elements stay valid. Within a list this is
+         * O(1), from another list O(last - first) to count the elements.
+         *
+         * @param pos position to insert before, not in [first, last)
+         * @param other list that contains the range, can be this list
+         * @param first begin of the range
+         * @param last end of the range
+         * @throws std::invalid_argument if other is another list with an allocator that isn't equal to this one
+         * @note Like splice(pos, other, it), the first splice between two lists allocates a store for their slabs.
+         */
+        void splice(iterator pos, list& other, iterator first, iterator last) {
+            splice_range(pos.current_, other, first.current_, last.current_);
+        }
+
+        void splice(iterator pos, list&& other, iterator first, iterator last) {
+            splice_range(pos.current_, other, first.current_, last.current_);
+        }
+
+        /**
+         * @brief Merges the sorted list other into this sorted list
+         *
+         * The merge is stable: of two equivalent elements the one of this list comes first. The nodes are
+         * relinked like in splice(), other is empty afterwards.
+         *
+         * @param other sorted list to merge
+         * @param comp strict weak ordering used to sort both lists
+         * @note If comp throws, all elements are in this list, in an unspecified order.
+         */
+        template<typename Compare>
+        void merge(list& other, Compare comp) {
+            if (this == &other || other.empty()) {
+                return;
+            }
+            if (empty()) {
+                splice_all(&node_, other);
+                return;
+            }
+            auto last = tail();
+            splice_all(&node_, other);
+            merge_runs(last->next(), [&comp](detail::list_node_base* lhs, detail::list_node_base* rhs) {
+                return std::invoke(comp, static_cast<node_t*>(lhs)->value(), static_cast<node_t*>(rhs)->value());
+            });
+        }
+
+        template<typename Compare>
+        void merge(list&& other, Compare comp) {
+            merge(other, std::move(comp));
+        }
+
+        void merge(list& other) {
+            merge(other, std::less<>{});
+        }
+
+        void merge(list&& other) {
+            merge(other, std::less<>{});
+        }
+
+        /**
+         * @brief Reverses the order of the elements by swapping the links of every node
+         */
+        void reverse() noexcept {
+            detail::list_node_base* node = &node_;
+            do {
+                std::swap(node->prev_, node->next_);
+                node = node->prev_;
+            } while (node != &node_);
+        }
+
+        /**
+         * @brief Erases all the elements for which pred returns true
+         *
+         * The nodes are unlinked first and destroyed together at the end, so pred never sees a destroyed element.
+         *
+         * @param pred unary predicate
+         * @return number of erased elements
+         */
+        template<typename Predicate>
+        size_type remove_if(Predicate pred) {
+            detail::list_node_base* removed = nullptr;
+            size_type count = 0;
+            try {
+                for (auto node = head(); node != &node_;) {
+                    auto next = node->next();
+                    if (pred(static_cast<node_t*>(node)->value())) {
+                        node->unhook();
+                        node->next_ = std::exchange(removed, node);
+                        ++count;
+                    }
+                    node = next;
+                }
+            } catch (...) {
+                node_.dec_size(count);
+                destroy_chain(removed);
+                throw;
+            }
+            node_.dec_size(count);
+            destroy_chain(removed);
+            return count;
+        }
+
+        /**
+         * @brief Erases all the elements equal to value
+         *
+         * @param value value to compare with, it can be an element of this list
+         * @return number of erased elements
+         */
+        size_type remove(const_reference value) {
+            return remove_if([&value](const_reference element) { return element == value; });
+        }
+
+        /**
+         * @brief Erases all but the first element of every group of consecutive equivalent elements
+         *
+         * @param pred binary predicate that returns true for equivalent elements
+         * @return number of erased elements
+         */
+        template<typename BinaryPredicate>
+        size_type unique(BinaryPredicate pred) {
+            detail::list_node_base* removed = nullptr;
+            size_type count = 0;
+            try {
+                auto kept = head();
+                for (auto node = kept->next(); kept != &node_ && node != &node_;) {
+                    auto next = node->next();
+                    if (pred(static_cast<node_t*>(kept)->value(), static_cast<node_t*>(node)->value())) {
+                        node->unhook();
+                        node->next_ = std::exchange(removed, node);
+                        ++count;
+                    } else {
+                        kept = node;
+                    }
+                    node = next;
+                }
+            } catch (...) {
+                node_.dec_size(count);
+                destroy_chain(removed);
+                throw;
+            }
+            node_.dec_size(count);
+            destroy_chain(removed);
+            return count;
+        }
+
+        size_type unique() {
+            return unique(std::equal_to<>{});
         }
 
     };
 
     /// Deduction guide for iterator arguments
-    template<typename _Iter>
-    list(_Iter b, _Iter e) -> list<typename std::iterator_traits<_Iter>::value_type>;
+    template<typename _Iter, typename _Alloc = std::allocator<typename std::iterator_traits<_Iter>::value_type>>
+    list(_Iter b, _Iter e, _Alloc = _Alloc()) -> list<typename std::iterator_traits<_Iter>::value_type, _Alloc>;
 
     /// Deduction guide for initializer list arguments
-    template<typename _V>
-    list(std::initializer_list<_V>) -> list<_V>;
+    template<typename _V, typename _Alloc = std::allocator<_V>>
+    list(std::initializer_list<_V>, _Alloc = _Alloc()) -> list<_V, _Alloc>;
+
+    namespace pmr {
+        /// saxion::list using a polymorphic allocator, the nodes are allocated from a std::pmr::memory_resource
+        template<typename T>
+        using list = saxion::list<T, std::pmr::polymorphic_allocator<T>>;
+    }
 }
 
 namespace std{
-    template<typename T>
-    inline void swap(saxion::list<T>& x, saxion::list<T>& y) noexcept {
+    template<typename T, typename Allocator, typename Observer>
+    inline void swap(saxion::list<T, Allocator, Observer>& x, saxion::list<T, Allocator, Observer>& y) noexcept {
         x.swap(y);
     }
 }
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,206 @@
+#ifndef INCLUDE_LIST_STATS_H
+#define INCLUDE_LIST_STATS_H
+
+/**
+ * @file list_stats.h
+ * @brief Counters of the slow paths of saxion::list, and optional USDT probes, as list observers
+ *
+ * Lists declared as saxion::counted_list<T> count when SAXION_LIST_STATS is defined, and are plain saxion::list
+ * otherwise, so the instrumentation costs nothing in a build without it. stats(lst) returns the counters of a
+ * list either way (all zeros without instrumentation). Like NDEBUG, SAXION_LIST_STATS should be defined (or not) for
+ * the whole program, e.g. with add_compile_definitions(SAXION_LIST_STATS).
+ *
+ * When SAXION_LIST_USDT is defined and <sys/sdt.h> is available (systemtap-sdt-dev), the counting observers also
+ * fire the USDT probes saxion_list:push_back, saxion_list:erase and saxion_list:clear, that perf or bpftrace can
+ * attach to, e.g. bpftrace -e 'usdt:./app:saxion_list:clear { @[arg1] = count(); }'.
+ */
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "list.h"
+
+#if defined(SAXION_LIST_USDT) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+/// fires the USDT probe saxion_list:name with the address of the list and a number
+#define SAXION_LIST_PROBE(name, lst, value) DTRACE_PROBE2(saxion_list, name, (lst), (value))
+#else
+#define SAXION_LIST_PROBE(name, lst, value) ((void) 0)
+#endif
+
+namespace saxion {
+
+    /**
+     * @brief Snapshot of the counters of a list (or of all the lists sharing global counters)
+     */
+    struct list_stats {
+        std::uint64_t walks{};          ///< calls of operator[] and at() that walked at least one node
+        std::uint64_t nodes_visited{};  ///< nodes walked by operator[] and at()
+        std::uint64_t node_allocations{};
+        std::uint64_t node_frees{};
+        std::uint64_t element_copies{};
+        std::uint64_t element_moves{};
+    };
+
+    namespace detail {
+
+        /// the counters behind list_stats, relaxed atomics: the const operator[] can run on several threads
+        struct list_counters {
+            std::atomic<std::uint64_t> walks{};
+            std::atomic<std::uint64_t> nodes_visited{};
+            std::atomic<std::uint64_t> node_allocations{};
+            std::atomic<std::uint64_t> node_frees{};
+            std::atomic<std::uint64_t> element_copies{};
+            std::atomic<std::uint64_t> element_moves{};
+
+            static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n) noexcept {
+                counter.fetch_add(n, std::memory_order_relaxed);
+            }
+
+            [[nodiscard]]
+            list_stats snapshot() const noexcept {
+                return {walks.load(std::memory_order_relaxed), nodes_visited.load(std::memory_order_relaxed),
+                        node_allocations.load(std::memory_order_relaxed), node_frees.load(std::memory_order_relaxed),
+                        element_copies.load(std::memory_order_relaxed), element_moves.load(std::memory_order_relaxed)};
+            }
+
+            void reset() noexcept {
+                for (auto* counter : {&walks, &nodes_visited, &node_allocations, &node_frees, &element_copies, &element_moves}) {
+                    counter->store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        /**
+         * @brief Observer that updates the counters returned by Derived::counters()
+         *
+         * @tparam Derived the observer, gives the counters to update
+         */
+        template<typename Derived>
+        class counting_observer_base : public list_observer {
+            detail::list_counters& counters() noexcept {
+                return static_cast<Derived*>(this)->counters();
+            }
+
+        public:
+            template<typename List>
+            void on_walk(const List&, std::size_t steps) noexcept {
+                if (steps) {
+                    list_counters::add(counters().walks, 1);
+                    list_counters::add(counters().nodes_visited, steps);
+                }
+            }
+
+            template<typename List>
+            void on_node_allocate(const List&) noexcept {
+                list_counters::add(counters().node_allocations, 1);
+            }
+
+            template<typename List>
+            void on_node_free(const List&, std::size_t count) noexcept {
+                list_counters::add(counters().node_frees, count);
+            }
+
+            template<typename List>
+            void on_element_copy(const List&) noexcept {
+                list_counters::add(counters().element_copies, 1);
+            }
+
+            template<typename List>
+            void on_element_move(const List&) noexcept {
+                list_counters::add(counters().element_moves, 1);
+            }
+
+            template<typename List>
+            void on_push_back([[maybe_unused]] const List& lst) noexcept {
+                SAXION_LIST_PROBE(push_back, &lst, lst.size());
+            }
+
+            template<typename List>
+            void on_erase([[maybe_unused]] const List& lst, typename List::const_iterator, [[maybe_unused]] std::size_t count) noexcept {
+                SAXION_LIST_PROBE(erase, &lst, count);
+            }
+
+            template<typename List>
+            void on_clear([[maybe_unused]] const List& lst) noexcept {
+                SAXION_LIST_PROBE(clear, &lst, lst.size());
+            }
+        };
+    }
+
+    /**
+     * @brief List observer with counters of its own list
+     */
+    class stats_observer : public detail::counting_observer_base<stats_observer> {
+        friend class detail::counting_observer_base<stats_observer>;
+
+        detail::list_counters counters_{};
+
+        detail::list_counters& counters() noexcept {
+            return counters_;
+        }
+
+    public:
+        [[nodiscard]]
+        list_stats stats() const noexcept {
+            return counters_.snapshot();
+        }
+
+        void reset() noexcept {
+            counters_.reset();
+        }
+    };
+
+    /**
+     * @brief List observer that adds to counters shared by all the lists using it, whatever their type
+     */
+    class global_stats_observer : public detail::counting_observer_base<global_stats_observer> {
+        friend class detail::counting_observer_base<global_stats_observer>;
+
+        static detail::list_counters& counters() noexcept {
+            static detail::list_counters global;
+            return global;
+        }
+
+    public:
+        /// the sum over all the lists with this observer, including the destroyed ones
+        [[nodiscard]]
+        static list_stats stats() noexcept {
+            return counters().snapshot();
+        }
+
+        static void reset() noexcept {
+            counters().reset();
+        }
+    };
+
+#ifdef SAXION_LIST_STATS
+    /// saxion::list with counters, see stats_observer (SAXION_LIST_STATS is defined)
+    template<typename T, typename Allocator = std::allocator<T>>
+    using counted_list = list<T, Allocator, stats_observer>;
+#else
+    /// saxion::list without counters (SAXION_LIST_STATS isn't defined)
+    template<typename T, typename Allocator = std::allocator<T>>
+    using counted_list = list<T, Allocator>;
+#endif
+
+    /**
+     * @brief Returns the counters of a list
+     *
+     * @return the counters of the observer of the list, or all zeros if it doesn't count
+     */
+    template<typename T, typename Allocator, typename Observer>
+    [[nodiscard]]
+    list_stats stats(const list<T, Allocator, Observer>& lst) noexcept {
+        if constexpr (requires { { lst.observer().stats() } -> std::convertible_to<list_stats>; }) {
+            return lst.observer().stats();
+        } else {
+            return {};
+        }
+    }
+}
+
+#endif //INCLUDE_LIST_STATS_H
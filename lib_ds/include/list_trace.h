@@ -0,0 +1,481 @@
+#ifndef INCLUDE_LIST_TRACE_H
+#define INCLUDE_LIST_TRACE_H
+
+/**
+ * @file list_trace.h
+ * @brief Recording the mutating operations of a saxion::list into a compact binary trace, and replaying it
+ *
+ * A trace keeps the shape of a workload (which operation, at which position, on a list of which size) without
+ * any of the values, so it can be shared where the data can't. Recording is opt-in: only a list with the
+ * trace_recorder observer (saxion::recorded_list) records, and only while a trace is attached to it.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "list.h"
+
+namespace saxion {
+
+    /**
+     * @brief Operations recorded in a trace
+     */
+    enum class trace_op : std::uint8_t {
+        push_back,
+        push_front,
+        insert,
+        pop_back,
+        pop_front,
+        erase,
+        clear,
+        copy_assign,
+        move_assign,
+        copied,
+        moved,
+    };
+
+    /**
+     * @brief One operation of a trace
+     *
+     * For every operation size is the size of the list before it. position and count are the index of the first
+     * inserted or erased element and the number of them. For copy_assign and move_assign count is the size of the
+     * source, for clear, copied and moved it's the size of the list.
+     */
+    struct trace_record {
+        trace_op op{};
+        std::uint64_t position{};
+        std::uint64_t count{};
+        std::uint64_t size{};
+
+        [[nodiscard]]
+        bool operator==(const trace_record&) const = default;
+    };
+
+    /**
+     * @brief A sequence of trace records, encoded compactly in memory and in files
+     *
+     * Every record is its operation (one byte) followed by the numbers it needs as LEB128 varints, so a push or
+     * pop on a list of less than 2^14 elements takes 3 bytes. A file is the magic "SXLT", the version byte and
+     * the records.
+     */
+    class list_trace {
+        static constexpr char magic[4] = {'S', 'X', 'L', 'T'};
+        static constexpr std::uint8_t version = 1;
+
+        std::vector<std::uint8_t> bytes_{};
+        std::size_t records_{};
+        std::size_t dropped_{};
+
+        void put(std::uint64_t value) {
+            while (value >= 0x80) {
+                bytes_.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            bytes_.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        static std::uint64_t get(const std::uint8_t*& in, const std::uint8_t* end) {
+            std::uint64_t value = 0;
+            for (unsigned shift = 0; in != end && shift < 64; shift += 7) {
+                auto byte = *in++;
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) {
+                    return value;
+                }
+            }
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument), "list_trace: truncated record");
+        }
+
+    public:
+        /**
+         * @brief Appends a record
+         *
+         * @note Never throws: if the trace can't grow the record is dropped and counted by dropped().
+         */
+        void append(const trace_record& record) noexcept {
+            auto old_size = bytes_.size();
+            try {
+                bytes_.push_back(static_cast<std::uint8_t>(record.op));
+                put(record.size);
+                switch (record.op) {
+                    case trace_op::insert:
+                    case trace_op::erase:
+                        put(record.position);
+                        put(record.count);
+                        break;
+                    case trace_op::copy_assign:
+                    case trace_op::move_assign:
+                        put(record.count);
+                        break;
+                    default:
+                        break;
+                }
+                ++records_;
+            } catch (...) {
+                bytes_.resize(old_size);
+                ++dropped_;
+            }
+        }
+
+        /**
+         * @brief Calls fn with every record, in order
+         *
+         * @throw std::system_error if the trace is corrupted
+         */
+        template<typename Fn>
+        void for_each(Fn&& fn) const {
+            auto in = bytes_.data();
+            auto end = in + bytes_.size();
+            while (in != end) {
+                trace_record record;
+                record.op = static_cast<trace_op>(*in++);
+                record.size = get(in, end);
+                switch (record.op) {
+                    case trace_op::push_back:
+                        record.position = record.size;
+                        record.count = 1;
+                        break;
+                    case trace_op::push_front:
+                    case trace_op::pop_front:
+                        record.count = 1;
+                        break;
+                    case trace_op::pop_back:
+                        record.position = record.size ? record.size - 1 : 0;
+                        record.count = 1;
+                        break;
+                    case trace_op::insert:
+                    case trace_op::erase:
+                        record.position = get(in, end);
+                        record.count = get(in, end);
+                        break;
+                    case trace_op::copy_assign:
+                    case trace_op::move_assign:
+                        record.count = get(in, end);
+                        break;
+                    case trace_op::clear:
+                    case trace_op::copied:
+                    case trace_op::moved:
+                        record.count = record.size;
+                        break;
+                    default:
+                        throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                                "list_trace: unknown operation");
+                }
+                fn(record);
+            }
+        }
+
+        /// decodes all the records
+        [[nodiscard]]
+        std::vector<trace_record> records() const {
+            std::vector<trace_record> out;
+            out.reserve(records_);
+            for_each([&out](const trace_record& record) { out.push_back(record); });
+            return out;
+        }
+
+        /// number of records
+        [[nodiscard]]
+        std::size_t size() const noexcept {
+            return records_;
+        }
+
+        /// number of records that were lost because the trace couldn't grow
+        [[nodiscard]]
+        std::size_t dropped() const noexcept {
+            return dropped_;
+        }
+
+        /// size of the encoded records in bytes
+        [[nodiscard]]
+        std::size_t bytes() const noexcept {
+            return bytes_.size();
+        }
+
+        void clear() noexcept {
+            bytes_.clear();
+            records_ = 0;
+            dropped_ = 0;
+        }
+
+        /**
+         * @brief Writes the trace to a file
+         *
+         * @throw std::system_error if the file can't be written
+         */
+        void save(const std::filesystem::path& path) const {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(magic, sizeof(magic));
+            out.put(static_cast<char>(version));
+            out.write(reinterpret_cast<const char*>(bytes_.data()), static_cast<std::streamsize>(bytes_.size()));
+            if (!out.flush()) {
+                throw std::system_error(std::make_error_code(std::errc::io_error), "list_trace: can't write " + path.string());
+            }
+        }
+
+        /**
+         * @brief Reads a trace written by save()
+         *
+         * @throw std::system_error if the file can't be read or isn't a valid trace
+         */
+        [[nodiscard]]
+        static list_trace load(const std::filesystem::path& path) {
+            std::ifstream in(path, std::ios::binary);
+            char header[sizeof(magic) + 1]{};
+            if (!in.read(header, sizeof(header))) {
+                throw std::system_error(std::make_error_code(std::errc::io_error), "list_trace: can't read " + path.string());
+            }
+            if (!std::equal(magic, magic + sizeof(magic), header) || static_cast<std::uint8_t>(header[sizeof(magic)]) != version) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument), "list_trace: not a trace file");
+            }
+
+            list_trace trace;
+            trace.bytes_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            // counts the records, and checks that all of them can be decoded
+            trace.for_each([&trace](const trace_record&) { ++trace.records_; });
+            return trace;
+        }
+    };
+
+    /**
+     * @brief List observer that appends the operations of the list to a list_trace
+     *
+     * Nothing is recorded until a trace is attached. The position of an insert or erase is found by walking from
+     * both ends of the list at once, so recording costs O(1) at the ends and up to n/2 steps in the middle.
+     */
+    class trace_recorder : public list_observer {
+        list_trace* trace_{};
+
+        template<typename List>
+        static std::uint64_t position(const List& lst, typename List::const_iterator it) noexcept {
+            auto forward = lst.begin();
+            auto backward = lst.end();
+            for (std::uint64_t steps = 0;; ++steps) {
+                if (forward == it) {
+                    return steps;
+                }
+                if (backward == it) {
+                    return lst.size() - steps;
+                }
+                ++forward;
+                --backward;
+            }
+        }
+
+        void record(trace_op op, std::uint64_t size, std::uint64_t position = 0, std::uint64_t count = 0) noexcept {
+            trace_->append({op, position, count, size});
+        }
+
+    public:
+        trace_recorder() = default;
+
+        // a copy would record the operations of another list in the same trace
+        trace_recorder(const trace_recorder&) = delete;
+        trace_recorder& operator=(const trace_recorder&) = delete;
+
+        /// starts recording into trace, which must outlive the recording
+        void attach(list_trace& trace) noexcept {
+            trace_ = &trace;
+        }
+
+        /// stops recording
+        void detach() noexcept {
+            trace_ = nullptr;
+        }
+
+        [[nodiscard]]
+        list_trace* trace() const noexcept {
+            return trace_;
+        }
+
+        template<typename List>
+        void on_insert(const List& lst, typename List::const_iterator first, std::size_t count) noexcept {
+            if (!trace_) {
+                return;
+            }
+            auto size = lst.size() - count;
+            auto pos = position(lst, first);
+            if (count == 1 && pos == size) {
+                record(trace_op::push_back, size);
+            } else if (count == 1 && pos == 0) {
+                record(trace_op::push_front, size);
+            } else {
+                record(trace_op::insert, size, pos, count);
+            }
+        }
+
+        template<typename List>
+        void on_erase(const List& lst, typename List::const_iterator first, std::size_t count) noexcept {
+            if (!trace_) {
+                return;
+            }
+            auto pos = position(lst, first);
+            if (count == 1 && pos == 0) {
+                record(trace_op::pop_front, lst.size());
+            } else if (count == 1 && pos + 1 == lst.size()) {
+                record(trace_op::pop_back, lst.size());
+            } else {
+                record(trace_op::erase, lst.size(), pos, count);
+            }
+        }
+
+        template<typename List>
+        void on_clear(const List& lst) noexcept {
+            if (trace_) {
+                record(trace_op::clear, lst.size());
+            }
+        }
+
+        template<typename List>
+        void on_copy_assign(const List& lst, const List& other) noexcept {
+            if (trace_) {
+                record(trace_op::copy_assign, lst.size(), 0, other.size());
+            }
+        }
+
+        template<typename List>
+        void on_move_assign(const List& lst, const List& other) noexcept {
+            if (trace_) {
+                record(trace_op::move_assign, lst.size(), 0, other.size());
+            }
+        }
+
+        template<typename List>
+        void on_copied(const List& lst) noexcept {
+            if (trace_) {
+                record(trace_op::copied, lst.size());
+            }
+        }
+
+        template<typename List>
+        void on_moved(const List& lst) noexcept {
+            if (trace_) {
+                record(trace_op::moved, lst.size());
+            }
+        }
+    };
+
+    /// saxion::list that records its operations, see trace_recorder
+    template<typename T, typename Allocator = std::allocator<T>>
+    using recorded_list = list<T, Allocator, trace_recorder>;
+
+    namespace detail {
+
+        /// resizes c to n elements with push_back and pop_back, the sequence containers don't agree on resize()
+        template<typename Container, typename MakeValue>
+        void replay_resize(Container& c, std::size_t n, MakeValue& make_value) {
+            while (c.size() > n) {
+                c.pop_back();
+            }
+            while (c.size() < n) {
+                c.push_back(make_value(c.size()));
+            }
+        }
+    }
+
+    /**
+     * @brief Replays a trace on a sequence container
+     *
+     * Works with saxion::list, std::list, std::deque and std::vector (and any container with their common
+     * interface). The elements are made by make_value(n), n counting the inserted elements. A copy_assign or
+     * move_assign takes its source from a second container of the same type, that is first resized to the
+     * recorded size; copied and moved copy or move the container into that second container.
+     *
+     * The trace is replayed as it is, even if the container and the recorded list don't have the same size
+     * (e.g. because the recorded list was spliced or sorted, which isn't recorded): positions are clamped to the
+     * size of the container, and erasing from an empty container does nothing.
+     *
+     * @param trace trace to replay
+     * @param c container to replay on, usually empty
+     * @param make_value makes the inserted elements
+     */
+    template<typename Container, typename MakeValue>
+    void replay(const list_trace& trace, Container& c, MakeValue make_value) {
+        Container other;
+        std::size_t made = 0;
+        auto at = [&c](std::uint64_t position) {
+            return std::next(c.begin(), static_cast<std::ptrdiff_t>(std::min<std::uint64_t>(position, c.size())));
+        };
+
+        trace.for_each([&](const trace_record& r) {
+            switch (r.op) {
+                case trace_op::push_back:
+                    c.push_back(make_value(made++));
+                    break;
+                case trace_op::push_front:
+                    if constexpr (requires { c.push_front(make_value(made)); }) {
+                        c.push_front(make_value(made++));
+                    } else {
+                        c.insert(c.begin(), make_value(made++));
+                    }
+                    break;
+                case trace_op::insert:
+                    c.insert(at(r.position), static_cast<typename Container::size_type>(r.count), make_value(made));
+                    made += r.count;
+                    break;
+                case trace_op::pop_back:
+                    if (!c.empty()) {
+                        c.pop_back();
+                    }
+                    break;
+                case trace_op::pop_front:
+                    if (!c.empty()) {
+                        if constexpr (requires { c.pop_front(); }) {
+                            c.pop_front();
+                        } else {
+                            c.erase(c.begin());
+                        }
+                    }
+                    break;
+                case trace_op::erase: {
+                    auto first = at(r.position);
+                    auto count = std::min<std::uint64_t>(r.count, static_cast<std::uint64_t>(std::distance(first, c.end())));
+                    if constexpr (requires { c.erase(first, first); }) {
+                        c.erase(first, std::next(first, static_cast<std::ptrdiff_t>(count)));
+                    } else {
+                        for (; count; --count) {
+                            first = c.erase(first);
+                        }
+                    }
+                    break;
+                }
+                case trace_op::clear:
+                    c.clear();
+                    break;
+                case trace_op::copy_assign:
+                    detail::replay_resize(other, r.count, make_value);
+                    c = other;
+                    break;
+                case trace_op::move_assign:
+                    detail::replay_resize(other, r.count, make_value);
+                    c = std::move(other);
+                    other.clear();
+                    break;
+                case trace_op::copied:
+                    other = c;
+                    break;
+                case trace_op::moved:
+                    other = std::move(c);
+                    c.clear();
+                    break;
+            }
+        });
+    }
+
+    /// replays a trace with value-initialized elements
+    template<typename Container>
+    void replay(const list_trace& trace, Container& c) {
+        replay(trace, c, [](std::size_t) { return typename Container::value_type{}; });
+    }
+}
+
+#endif //INCLUDE_LIST_TRACE_H
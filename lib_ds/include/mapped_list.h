@@ -0,0 +1,603 @@
+#ifndef INCLUDE_MAPPED_LIST_H
+#define INCLUDE_MAPPED_LIST_H
+
+/**
+ * @file mapped_list.h
+ * @brief Doubly linked list persisted in a memory-mapped file, reopened without walking its nodes
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "shm_list.h"
+
+namespace saxion {
+
+    template<typename T>
+    class mapped_list;
+
+    namespace detail {
+
+        /**
+         * @brief Bidirectional iterator of a mapped_list
+         *
+         * The iterator keeps the offset of its node and a pointer to the base address of the mapping, so it stays
+         * valid when the file is remapped to grow.
+         */
+        template<typename T, bool Const>
+        struct mapped_list_iterator {
+            template<typename> friend
+            class ::saxion::mapped_list;
+
+            std::byte* const* base_;
+            shm_offset current_;
+
+            using value_type = T;
+            using reference = std::conditional_t<Const, const T&, T&>;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            mapped_list_iterator() noexcept :
+                base_{},
+                current_{}
+            {}
+
+            mapped_list_iterator(std::byte* const* base, shm_offset current) noexcept :
+                base_{base},
+                current_{current}
+            {}
+
+            /// a non-const iterator can always be used where a const one is expected
+            template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            mapped_list_iterator(const mapped_list_iterator<T, OtherConst>& other) noexcept :
+                base_{other.base_},
+                current_{other.current_}
+            {}
+
+            [[nodiscard]]
+            shm_node_base& links() const noexcept {
+                return *reinterpret_cast<shm_node_base*>(*base_ + current_);
+            }
+
+            mapped_list_iterator& operator++() noexcept {
+                current_ = links().next_;
+                return *this;
+            }
+
+            mapped_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            mapped_list_iterator& operator--() noexcept {
+                current_ = links().prev_;
+                return *this;
+            }
+
+            mapped_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<shm_node<T>&>(links()).value_;
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(**this);
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const mapped_list_iterator& lhs, const mapped_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_;
+            }
+        };
+    }
+
+    /**
+     * @brief Doubly linked list whose nodes live in a memory-mapped file
+     *
+     * The file holds a header (sentinel, size, free list) followed by the node slots, linked by offsets from the
+     * start of the file. Opening an existing file maps it and the list is there: nothing is walked, allocated or
+     * copied, whatever the number of elements. The file grows by doubling when it runs out of slots; erased nodes
+     * go to a free list in the file.
+     *
+     * Every change of the links is first written to a redo log in the header, which is then marked valid, applied
+     * and marked invalid. If the process is killed in the middle of a change, the next open() finishes it (the log
+     * is valid) or the change never happened (it isn't): the list in the file is always consistent. The values are
+     * written to their node before the node is linked; assigning to an element in place isn't logged.
+     *
+     * The operating system writes the dirty pages back whenever it likes; checkpoint() waits until everything
+     * changed so far is on disk, which is what survives a crash of the machine.
+     *
+     * The file is locked while it is open, so one process at a time uses the list; the list itself isn't
+     * thread-safe, like saxion::list.
+     *
+     * @tparam T type of the elements; trivially copyable since they are stored as bytes in the file
+     */
+    template<typename T>
+    class mapped_list {
+        static_assert(std::is_trivially_copyable_v<T>, "the elements are stored byte-wise in the file");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = detail::mapped_list_iterator<T, false>;
+        using const_iterator = detail::mapped_list_iterator<T, true>;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+        using node_t = detail::shm_node<T>;
+        using offset = detail::shm_offset;
+
+        static constexpr std::uint64_t magic = 0x7361786c6d617031;  // "saxlmap1"
+        static constexpr size_type min_capacity = 16;
+        /// most link words a single change writes
+        static constexpr std::size_t max_writes = 6;
+
+        /// one word to write at an offset of the file
+        struct log_entry {
+            offset where_;
+            std::uint64_t value_;
+        };
+
+        struct header {
+            std::uint64_t magic_;
+            std::uint64_t value_size_;
+            std::uint64_t value_align_;
+
+            detail::shm_node_base sentinel_;
+            std::uint64_t size_;
+            std::uint64_t capacity_;
+            /// number of slots ever used: the slots behind it were never linked in the free list
+            std::uint64_t used_;
+            offset free_;
+
+            /// the redo log of the change in progress, applied again on open if it is valid
+            std::uint64_t log_valid_;
+            std::uint64_t log_count_;
+            log_entry log_[max_writes];
+        };
+
+        static constexpr std::size_t nodes_offset = (sizeof(header) + alignof(node_t) - 1) / alignof(node_t) * alignof(node_t);
+        static constexpr offset sentinel_offset = offsetof(header, sentinel_);
+
+        int fd_{-1};
+        std::byte* base_{};
+        std::size_t bytes_{};
+        bool recovered_{};
+
+        [[nodiscard]]
+        static std::size_t file_bytes(size_type capacity) noexcept {
+            return nodes_offset + capacity * sizeof(node_t);
+        }
+
+        [[nodiscard]]
+        header& head() const noexcept {
+            return *reinterpret_cast<header*>(base_);
+        }
+
+        [[nodiscard]]
+        detail::shm_node_base& links(offset off) const noexcept {
+            return *reinterpret_cast<detail::shm_node_base*>(base_ + off);
+        }
+
+        [[nodiscard]]
+        node_t& node(offset off) const noexcept {
+            return *static_cast<node_t*>(&links(off));
+        }
+
+        /// offset of a word of the mapping, for the redo log
+        [[nodiscard]]
+        offset where(const std::uint64_t& word) const noexcept {
+            return static_cast<offset>(reinterpret_cast<const std::byte*>(&word) - base_);
+        }
+
+        void map(std::size_t bytes) {
+            void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (base == MAP_FAILED) {
+                detail::throw_errno("mmap");
+            }
+            base_ = static_cast<std::byte*>(base);
+            bytes_ = bytes;
+        }
+
+        void unmap() noexcept {
+            if (base_) {
+                ::munmap(base_, bytes_);
+                base_ = nullptr;
+            }
+        }
+
+        void close() noexcept {
+            unmap();
+            if (fd_ >= 0) {
+                // closing the file releases the lock
+                ::close(fd_);
+                fd_ = -1;
+            }
+        }
+
+        /// writes an empty list to a new (or never initialized) file, the header is marked initialized last
+        void initialize(size_type capacity) {
+            capacity = std::max(capacity, min_capacity);
+            if (::ftruncate(fd_, static_cast<off_t>(file_bytes(capacity))) != 0) {
+                detail::throw_errno("ftruncate");
+            }
+            map(file_bytes(capacity));
+            auto* h = new (base_) header{};
+            h->value_size_ = sizeof(T);
+            h->value_align_ = alignof(T);
+            h->sentinel_ = {sentinel_offset, sentinel_offset};
+            h->capacity_ = capacity;
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            h->magic_ = magic;
+        }
+
+        /**
+         * @brief Applies the writes of the redo log
+         *
+         * The writes are idempotent (they store values, they don't update them), so a log may be applied again.
+         */
+        void apply_log() noexcept {
+            auto& h = head();
+            for (std::size_t i = 0; i < h.log_count_; ++i) {
+                *reinterpret_cast<std::uint64_t*>(base_ + h.log_[i].where_) = h.log_[i].value_;
+            }
+        }
+
+        /**
+         * @brief Writes words of the mapping as one change that a crash can't tear
+         *
+         * The compiler barriers keep the stores in program order, which is the order a killed process leaves them
+         * in the page cache.
+         *
+         * @param writes the words to write and their new values
+         */
+        void commit(std::initializer_list<std::pair<std::uint64_t*, std::uint64_t>> writes) noexcept {
+            auto& h = head();
+            std::size_t count = 0;
+            for (auto [word, value] : writes) {
+                h.log_[count++] = {where(*word), value};
+            }
+            h.log_count_ = count;
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            h.log_valid_ = 1;
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            apply_log();
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            h.log_valid_ = 0;
+        }
+
+        /// doubles the number of slots
+        void grow() {
+            auto capacity = std::max<size_type>(min_capacity, 2 * head().capacity_);
+            if (::ftruncate(fd_, static_cast<off_t>(file_bytes(capacity))) != 0) {
+                detail::throw_errno("ftruncate");
+            }
+            // the file is longer than the capacity in its header until the new capacity is written, which is fine
+            unmap();
+            map(file_bytes(capacity));
+            head().capacity_ = capacity;
+        }
+
+        /**
+         * @brief Links a new node holding value before pos
+         *
+         * The slot is taken from the free list or behind the used ones; its value is written while it isn't
+         * reachable yet, the slot is taken and linked in one change. The value is taken by copy: it may be an
+         * element of this list, which moves when the file grows.
+         */
+        offset link_new(offset pos, T value) {
+            if (head().free_ == 0 && head().used_ == head().capacity_) {
+                grow();
+            }
+            auto& h = head();
+            offset off;
+            std::uint64_t* alloc_word;
+            std::uint64_t alloc_value;
+            if (h.free_ != 0) {
+                off = h.free_;
+                alloc_word = &h.free_;
+                alloc_value = links(off).next_;
+            } else {
+                off = nodes_offset + h.used_ * sizeof(node_t);
+                alloc_word = &h.used_;
+                alloc_value = h.used_ + 1;
+            }
+            auto& n = node(off);
+            n.value_ = value;
+            offset prev = links(pos).prev_;
+            commit({{alloc_word, alloc_value},
+                    {&n.prev_, prev},
+                    {&n.next_, pos},
+                    {&links(prev).next_, off},
+                    {&links(pos).prev_, off},
+                    {&h.size_, h.size_ + 1}});
+            return off;
+        }
+
+        /// unlinks the node at off and puts it on the free list
+        offset unlink(offset off) noexcept {
+            auto& h = head();
+            auto& n = links(off);
+            offset next = n.next_;
+            commit({{&links(n.prev_).next_, next},
+                    {&links(next).prev_, n.prev_},
+                    {&n.next_, h.free_},
+                    {&h.free_, off},
+                    {&h.size_, h.size_ - 1}});
+            return next;
+        }
+
+    public:
+
+        /**
+         * @brief Opens the list stored in a file, or creates an empty one
+         *
+         * Reopening is O(1): the file is mapped and, if the process that used it last was killed in the middle of a
+         * change, that change is finished.
+         *
+         * @param path file of the list
+         * @param capacity number of slots of a new file
+         * @throw std::system_error if the file can't be opened, is used by another process or holds another type
+         */
+        explicit mapped_list(const std::filesystem::path& path, size_type capacity = 1024) {
+            fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+            if (fd_ < 0) {
+                detail::throw_errno("open");
+            }
+            try {
+                if (::flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+                    detail::throw_errno("flock");
+                }
+                struct stat st{};
+                if (::fstat(fd_, &st) != 0) {
+                    detail::throw_errno("fstat");
+                }
+                auto bytes = static_cast<std::size_t>(st.st_size);
+                if (bytes < sizeof(header)) {
+                    initialize(capacity);
+                    return;
+                }
+                map(bytes);
+                auto& h = head();
+                if (h.magic_ == 0) {
+                    // a file whose creation was interrupted
+                    unmap();
+                    initialize(capacity);
+                    return;
+                }
+                if (h.magic_ != magic) {
+                    throw std::system_error(std::make_error_code(std::errc::invalid_argument), "mapped_list: not a list file");
+                }
+                if (h.value_size_ != sizeof(T) || h.value_align_ != alignof(T) || file_bytes(h.capacity_) > bytes_) {
+                    throw std::system_error(std::make_error_code(std::errc::invalid_argument), "mapped_list: file holds another type");
+                }
+                if (h.log_valid_ != 0) {
+                    apply_log();
+                    std::atomic_signal_fence(std::memory_order_seq_cst);
+                    h.log_valid_ = 0;
+                    recovered_ = true;
+                }
+            } catch (...) {
+                close();
+                throw;
+            }
+        }
+
+        // the iterators refer to the base address kept in this object
+        mapped_list(const mapped_list&) = delete;
+        mapped_list& operator=(const mapped_list&) = delete;
+
+        /**
+         * @brief Unmaps and unlocks the file, the list stays in it
+         */
+        ~mapped_list() {
+            close();
+        }
+
+        /**
+         * @brief Whether opening the file finished a change interrupted by a crash
+         *
+         * @return bool
+         */
+        [[nodiscard]]
+        bool recovered() const noexcept {
+            return recovered_;
+        }
+
+        /**
+         * @brief Writes the changes made so far to the disk and waits for it
+         */
+        void checkpoint() {
+            if (::msync(base_, bytes_, MS_SYNC) != 0) {
+                detail::throw_errno("msync");
+            }
+        }
+
+        [[nodiscard]]
+        iterator begin() noexcept {
+            return {&base_, head().sentinel_.next_};
+        }
+
+        [[nodiscard]]
+        const_iterator begin() const noexcept {
+            return {&base_, head().sentinel_.next_};
+        }
+
+        [[nodiscard]]
+        iterator end() noexcept {
+            return {&base_, sentinel_offset};
+        }
+
+        [[nodiscard]]
+        const_iterator end() const noexcept {
+            return {&base_, sentinel_offset};
+        }
+
+        [[nodiscard]]
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        [[nodiscard]]
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        [[nodiscard]]
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator{end()};
+        }
+
+        [[nodiscard]]
+        reverse_iterator rend() noexcept {
+            return reverse_iterator{begin()};
+        }
+
+        [[nodiscard]]
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{end()};
+        }
+
+        [[nodiscard]]
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{begin()};
+        }
+
+        [[nodiscard]]
+        reference front() noexcept {
+            return *begin();
+        }
+
+        [[nodiscard]]
+        const_reference front() const noexcept {
+            return *begin();
+        }
+
+        [[nodiscard]]
+        reference back() noexcept {
+            return *std::prev(end());
+        }
+
+        [[nodiscard]]
+        const_reference back() const noexcept {
+            return *std::prev(end());
+        }
+
+        /**
+         * @brief Inserts an element before pos
+         *
+         * @param pos position of the new element
+         * @param value element to copy into the file
+         * @return iterator to the new element
+         */
+        iterator insert(const_iterator pos, const T& value) {
+            return {&base_, link_new(pos.current_, value)};
+        }
+
+        void push_back(const T& value) {
+            link_new(sentinel_offset, value);
+        }
+
+        void push_front(const T& value) {
+            link_new(head().sentinel_.next_, value);
+        }
+
+        /**
+         * @brief Erases the element at pos
+         *
+         * @param pos position of the element, not end()
+         * @return iterator to the element after the erased one
+         */
+        iterator erase(const_iterator pos) noexcept {
+            return {&base_, unlink(pos.current_)};
+        }
+
+        void pop_front() noexcept {
+            unlink(head().sentinel_.next_);
+        }
+
+        void pop_back() noexcept {
+            unlink(head().sentinel_.prev_);
+        }
+
+        /**
+         * @brief Erases all the elements in O(1): the whole chain goes to the free list in one change
+         */
+        void clear() noexcept {
+            auto& h = head();
+            if (h.size_ == 0) {
+                return;
+            }
+            offset first = h.sentinel_.next_;
+            offset last = h.sentinel_.prev_;
+            commit({{&links(last).next_, h.free_},
+                    {&h.free_, first},
+                    {&h.sentinel_.next_, sentinel_offset},
+                    {&h.sentinel_.prev_, sentinel_offset},
+                    {&h.size_, 0}});
+        }
+
+        /**
+         * @brief Makes room for at least capacity elements without growing the file again
+         *
+         * @param capacity number of slots
+         */
+        void reserve(size_type capacity) {
+            while (head().capacity_ < capacity) {
+                grow();
+            }
+        }
+
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return head().size_;
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Number of node slots in the file
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type capacity() const noexcept {
+            return head().capacity_;
+        }
+    };
+}
+
+#endif
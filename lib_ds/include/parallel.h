@@ -0,0 +1,653 @@
+#ifndef INCLUDE_PARALLEL_H
+#define INCLUDE_PARALLEL_H
+
+/**
+ * @file parallel.h
+ * @brief Parallel algorithms over saxion::list and other sized ranges
+ *
+ * Every algorithm takes an execution policy first:
+ *  - saxion::execution::seq runs the sequential algorithm,
+ *  - saxion::execution::par runs on one thread per hardware thread, par(n) on n threads,
+ *  - saxion::execution::on(exec) runs the segments as tasks of an executor (e.g. a thread_pool_executor).
+ *
+ * The standard policies are accepted too when <execution> is included before this header.
+ *
+ * The range is split in one segment per thread: the split points are found by one walk over the links, using the
+ * size stored in the list, then every segment is processed on its own thread and the results are combined in
+ * order. The walk is sequential, so the speedup depends on the work done per element. Exceptions thrown by the
+ * functions are rethrown to the caller (the one of the first segment that threw).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <latch>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __cpp_lib_execution
+#include <execution>
+#endif
+
+#include "executor.h"
+#include "list.h"
+
+namespace saxion {
+
+    namespace execution {
+
+        /// runs the sequential algorithms
+        struct sequenced_policy {};
+
+        /// runs on a number of threads started for the call
+        struct parallel_policy {
+            /// number of threads, 0 for one per hardware thread
+            std::size_t threads_{};
+
+            /**
+             * @brief The same policy with a given number of threads
+             *
+             * @param threads number of threads, 0 for one per hardware thread
+             * @return parallel_policy
+             */
+            [[nodiscard]]
+            constexpr parallel_policy operator()(std::size_t threads) const noexcept {
+                return parallel_policy{threads};
+            }
+
+            [[nodiscard]]
+            std::size_t threads() const noexcept {
+                return threads_ != 0 ? threads_ : std::max(1U, std::thread::hardware_concurrency());
+            }
+        };
+
+        /// runs the segments as tasks of an executor
+        struct executor_policy {
+            executor* executor_;
+            std::size_t tasks_;
+
+            [[nodiscard]]
+            std::size_t threads() const noexcept {
+                return std::max<std::size_t>(1, tasks_);
+            }
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+
+        /**
+         * @brief Policy running the segments on an executor
+         *
+         * The caller blocks until all the segments ran, so the executor must have threads of its own (a
+         * thread_pool_executor, not a manual_executor) and the algorithm must not be called from one of them.
+         *
+         * @param exec executor running the segments
+         * @param tasks number of segments, 0 for one per hardware thread
+         * @return executor_policy
+         */
+        [[nodiscard]]
+        inline executor_policy on(executor& exec, std::size_t tasks = 0) noexcept {
+            return executor_policy{&exec, tasks != 0 ? tasks : std::max(1U, std::thread::hardware_concurrency())};
+        }
+
+        template<typename P>
+        inline constexpr bool is_execution_policy_v =
+#ifdef __cpp_lib_execution
+                std::is_execution_policy_v<std::remove_cvref_t<P>> ||
+#endif
+                std::is_same_v<std::remove_cvref_t<P>, sequenced_policy> ||
+                std::is_same_v<std::remove_cvref_t<P>, parallel_policy> ||
+                std::is_same_v<std::remove_cvref_t<P>, executor_policy>;
+    }
+
+    namespace detail {
+
+        /// whether P runs the sequential algorithms: saxion::execution::seq or std::execution::seq
+        template<typename P>
+        [[nodiscard]]
+        constexpr bool is_sequenced() noexcept {
+#ifdef __cpp_lib_execution
+            if constexpr (std::is_same_v<std::remove_cvref_t<P>, std::execution::sequenced_policy>) {
+                return true;
+            }
+#endif
+            return std::is_same_v<std::remove_cvref_t<P>, execution::sequenced_policy>;
+        }
+
+        /// number of segments a parallel policy asks for
+        template<typename P>
+        [[nodiscard]]
+        std::size_t policy_threads(const P& policy) noexcept {
+            if constexpr (std::is_same_v<P, execution::parallel_policy> || std::is_same_v<P, execution::executor_policy>) {
+                return policy.threads();
+            } else {
+                // a standard parallel policy
+                return execution::par.threads();
+            }
+        }
+
+        template<typename Fn>
+        detached_task run_segment_task(Fn& fn, std::size_t index, std::exception_ptr& error, std::latch& done) {
+            try {
+                fn(index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            done.count_down();
+            co_return;
+        }
+
+        /**
+         * @brief Calls fn(0), ..., fn(count - 1) concurrently and waits for all of them
+         *
+         * fn(0) runs on the calling thread.
+         *
+         * @throw the exception of the first index that threw
+         */
+        template<typename P, typename Fn>
+        void run_segments(const P& policy, std::size_t count, Fn fn) {
+            std::vector<std::exception_ptr> errors(count);
+            if constexpr (std::is_same_v<P, execution::executor_policy>) {
+                std::latch done(static_cast<std::ptrdiff_t>(count - 1));
+                for (std::size_t i = 1; i < count; ++i) {
+                    spawn(*policy.executor_, run_segment_task(fn, i, errors[i], done));
+                }
+                try {
+                    fn(0);
+                } catch (...) {
+                    errors[0] = std::current_exception();
+                }
+                done.wait();
+            } else {
+                std::vector<std::thread> threads;
+                threads.reserve(count - 1);
+                for (std::size_t i = 1; i < count; ++i) {
+                    threads.emplace_back([&fn, &errors, i] {
+                        try {
+                            fn(i);
+                        } catch (...) {
+                            errors[i] = std::current_exception();
+                        }
+                    });
+                }
+                try {
+                    fn(0);
+                } catch (...) {
+                    errors[0] = std::current_exception();
+                }
+                for (auto& thread : threads) {
+                    thread.join();
+                }
+            }
+            for (auto& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        /**
+         * @brief Splits [first, first + n) in parts segments of (almost) equal length
+         *
+         * @return the parts + 1 bounds of the segments
+         */
+        template<typename It>
+        [[nodiscard]]
+        std::vector<It> split_points(It first, std::size_t n, std::size_t parts) {
+            std::vector<It> bounds;
+            bounds.reserve(parts + 1);
+            bounds.push_back(first);
+            for (std::size_t i = 0; i < parts; ++i) {
+                auto length = n / parts + (i < n % parts ? 1 : 0);
+                first = std::next(first, static_cast<std::ptrdiff_t>(length));
+                bounds.push_back(first);
+            }
+            return bounds;
+        }
+
+        /// number of segments to use for n elements
+        template<typename P>
+        [[nodiscard]]
+        std::size_t segment_count(const P& policy, std::size_t n) noexcept {
+            return std::max<std::size_t>(1, std::min(n, policy_threads(policy)));
+        }
+    }
+
+    /**
+     * @brief Calls fn on every element of r
+     *
+     * @param policy execution policy
+     * @param r sized forward range, e.g. a saxion::list
+     * @param fn function called on every element, concurrently for elements of different segments
+     */
+    template<typename P, std::ranges::forward_range R, typename Fn>
+    requires execution::is_execution_policy_v<P> && std::ranges::sized_range<R>
+    void for_each(P&& policy, R&& r, Fn fn) {
+        if constexpr (detail::is_sequenced<P>()) {
+            std::ranges::for_each(r, fn);
+        } else {
+            auto n = static_cast<std::size_t>(std::ranges::size(r));
+            auto parts = detail::segment_count(policy, n);
+            if (parts < 2) {
+                std::ranges::for_each(r, fn);
+                return;
+            }
+            auto bounds = detail::split_points(std::ranges::begin(r), n, parts);
+            detail::run_segments(policy, parts, [&](std::size_t i) {
+                std::for_each(bounds[i], bounds[i + 1], fn);
+            });
+        }
+    }
+
+    /**
+     * @brief Writes op(x) for every element x of r to the range starting at out
+     *
+     * @param policy execution policy
+     * @param r sized forward range
+     * @param out forward iterator to a range at least as long as r, it may be the begin of r
+     * @param op unary operation
+     * @return iterator past the last element written
+     */
+    template<typename P, std::ranges::forward_range R, std::forward_iterator Out, typename Op>
+    requires execution::is_execution_policy_v<P> && std::ranges::sized_range<R>
+    Out transform(P&& policy, R&& r, Out out, Op op) {
+        if constexpr (detail::is_sequenced<P>()) {
+            return std::ranges::transform(r, out, op).out;
+        } else {
+            auto n = static_cast<std::size_t>(std::ranges::size(r));
+            auto parts = detail::segment_count(policy, n);
+            if (parts < 2) {
+                return std::ranges::transform(r, out, op).out;
+            }
+            auto bounds = detail::split_points(std::ranges::begin(r), n, parts);
+            auto out_bounds = detail::split_points(out, n, parts);
+            detail::run_segments(policy, parts, [&](std::size_t i) {
+                std::transform(bounds[i], bounds[i + 1], out_bounds[i], op);
+            });
+            return out_bounds.back();
+        }
+    }
+
+    /**
+     * @brief Reduces the transformed elements of r
+     *
+     * Every segment is reduced on its own, then the results are reduced in order, so reduce must be associative
+     * (like for std::transform_reduce); it doesn't need to be commutative.
+     *
+     * @param policy execution policy
+     * @param r sized forward range
+     * @param init initial value
+     * @param reduce binary operation combining two results
+     * @param transform unary operation applied to every element
+     * @return T
+     */
+    template<typename P, std::ranges::forward_range R, typename T, typename Reduce, typename Transform>
+    requires execution::is_execution_policy_v<P> && std::ranges::sized_range<R>
+    [[nodiscard]]
+    T transform_reduce(P&& policy, R&& r, T init, Reduce reduce, Transform transform) {
+        if constexpr (detail::is_sequenced<P>()) {
+            for (auto&& x : r) {
+                init = std::invoke(reduce, std::move(init), std::invoke(transform, x));
+            }
+            return init;
+        } else {
+            auto n = static_cast<std::size_t>(std::ranges::size(r));
+            auto parts = detail::segment_count(policy, n);
+            if (parts < 2) {
+                return saxion::transform_reduce(execution::seq, r, std::move(init), std::move(reduce), std::move(transform));
+            }
+            auto bounds = detail::split_points(std::ranges::begin(r), n, parts);
+            std::vector<std::optional<T>> results(parts);
+            detail::run_segments(policy, parts, [&](std::size_t i) {
+                auto it = bounds[i];
+                T result = std::invoke(transform, *it);
+                for (++it; it != bounds[i + 1]; ++it) {
+                    result = std::invoke(reduce, std::move(result), std::invoke(transform, *it));
+                }
+                results[i].emplace(std::move(result));
+            });
+            for (auto& result : results) {
+                init = std::invoke(reduce, std::move(init), std::move(*result));
+            }
+            return init;
+        }
+    }
+
+    /**
+     * @brief Counts the elements of r satisfying pred
+     *
+     * @param policy execution policy
+     * @param r sized forward range
+     * @param pred unary predicate
+     * @return std::size_t
+     */
+    template<typename P, std::ranges::forward_range R, typename Pred>
+    requires execution::is_execution_policy_v<P> && std::ranges::sized_range<R>
+    [[nodiscard]]
+    std::size_t count_if(P&& policy, R&& r, Pred pred) {
+        return transform_reduce(std::forward<P>(policy), r, std::size_t{0}, std::plus<>{}, [&pred](const auto& x) {
+            return std::invoke(pred, x) ? std::size_t{1} : std::size_t{0};
+        });
+    }
+
+    /**
+     * @brief Finds the first element of r satisfying pred
+     *
+     * The segments after one where an element was found stop early.
+     *
+     * @param policy execution policy
+     * @param r sized forward range
+     * @param pred unary predicate
+     * @return iterator to the first such element, or the end of r
+     */
+    template<typename P, std::ranges::forward_range R, typename Pred>
+    requires execution::is_execution_policy_v<P> && std::ranges::sized_range<R>
+    [[nodiscard]]
+    std::ranges::iterator_t<R> find_if(P&& policy, R&& r, Pred pred) {
+        if constexpr (detail::is_sequenced<P>()) {
+            return std::ranges::find_if(r, pred);
+        } else {
+            auto n = static_cast<std::size_t>(std::ranges::size(r));
+            auto parts = detail::segment_count(policy, n);
+            if (parts < 2) {
+                return std::ranges::find_if(r, pred);
+            }
+            auto bounds = detail::split_points(std::ranges::begin(r), n, parts);
+            // index of the first segment with a match so far
+            std::atomic<std::size_t> found{parts};
+            std::vector<std::ranges::iterator_t<R>> matches(parts);
+            detail::run_segments(policy, parts, [&](std::size_t i) {
+                std::size_t checked = 0;
+                for (auto it = bounds[i]; it != bounds[i + 1]; ++it) {
+                    // an earlier segment has a match: this one can't have the first one
+                    if (++checked % 64 == 0 && found.load(std::memory_order_relaxed) < i) {
+                        return;
+                    }
+                    if (std::invoke(pred, *it)) {
+                        matches[i] = it;
+                        auto current = found.load(std::memory_order_relaxed);
+                        while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+                        return;
+                    }
+                }
+            });
+            auto first = found.load(std::memory_order_relaxed);
+            return first < parts ? matches[first] : std::ranges::end(r);
+        }
+    }
+
+    /**
+     * @brief Sorts a list, stable
+     *
+     * Every segment is cut out of the list and sorted on its own thread like list::sort(), then the sorted chains
+     * are merged pairwise, the independent merges in parallel. Only the links change: nothing is allocated, moved
+     * or copied and the iterators stay valid.
+     *
+     * @param policy execution policy
+     * @param lst list to sort
+     * @param comp strict weak ordering of the projected elements
+     * @param proj projection applied to the elements
+     * @note If comp or proj throws, all elements are still in the list, in an unspecified order.
+     */
+    template<typename P, typename T, typename Allocator, typename Observer, typename Compare = std::less<>,
+             typename Projection = std::identity>
+    requires execution::is_execution_policy_v<P>
+    void sort(P&& policy, list<T, Allocator, Observer>& lst, Compare comp = {}, Projection proj = {}) {
+        if constexpr (detail::is_sequenced<P>()) {
+            lst.sort(std::move(comp), std::move(proj));
+        } else {
+            using node_t = detail::list_node<T>;
+            using detail::list_node_base;
+
+            auto less = [&comp, &proj](list_node_base* lhs, list_node_base* rhs) {
+                return std::invoke(comp, std::invoke(proj, static_cast<node_t*>(lhs)->value()),
+                                   std::invoke(proj, static_cast<node_t*>(rhs)->value()));
+            };
+
+            auto n = lst.size();
+            auto parts = detail::segment_count(policy, n);
+            if (parts < 2) {
+                lst.sort(std::move(comp), std::move(proj));
+                return;
+            }
+            auto bounds = detail::split_points(lst.begin(), n, parts);
+            list_node_base* sentinel = lst.end().node();
+
+            // every segment is linked to a sentinel of its own while it is sorted
+            std::vector<list_node_base> sentinels(parts);
+            for (std::size_t i = 0; i < parts; ++i) {
+                auto first = bounds[i].node();
+                auto last = bounds[i + 1].node()->prev_;
+                sentinels[i].next_ = first;
+                sentinels[i].prev_ = last;
+                first->prev_ = &sentinels[i];
+                last->next_ = &sentinels[i];
+            }
+            sentinel->next_ = sentinel;
+            sentinel->prev_ = sentinel;
+
+            // turns the ring of a segment sentinel into a chain terminated by nullptr
+            std::vector<list_node_base*> chains(parts);
+            auto take_chains = [&] {
+                for (std::size_t i = 0; i < parts; ++i) {
+                    if (sentinels[i].next_ != &sentinels[i]) {
+                        sentinels[i].prev_->next_ = nullptr;
+                        chains[i] = sentinels[i].next_;
+                        sentinels[i].next_ = sentinels[i].prev_ = &sentinels[i];
+                    }
+                }
+            };
+            // puts every node back into the list
+            auto restore = [&] {
+                list_node_base* all = nullptr;
+                for (auto chain : chains) {
+                    all = detail::concat_chains(all, chain);
+                }
+                detail::relink_chain(sentinel, all);
+            };
+
+            try {
+                detail::run_segments(policy, parts, [&](std::size_t i) {
+                    detail::sort_nodes(&sentinels[i], less);
+                });
+            } catch (...) {
+                take_chains();
+                restore();
+                throw;
+            }
+            take_chains();
+
+            try {
+                for (std::size_t step = 1; step < parts; step *= 2) {
+                    auto merges = (parts - step + 2 * step - 1) / (2 * step);
+                    detail::run_segments(policy, merges, [&](std::size_t m) {
+                        auto i = m * 2 * step;
+                        detail::merge_chains(chains[i], std::exchange(chains[i + step], nullptr), less);
+                    });
+                }
+            } catch (...) {
+                // merge_chains keeps all the nodes in its first chain
+                restore();
+                throw;
+            }
+            detail::relink_chain(sentinel, chains.front());
+        }
+    }
+
+    namespace detail {
+
+        /**
+         * @brief Appends copies of the elements of r to out, building one sub-list per segment concurrently
+         *
+         * Every segment is copied into a list of its own, on its own thread, with a copy of the allocator of out.
+         * The sub-lists are then spliced to out in order; with equal allocators a whole-list splice relinks the
+         * nodes and adopts the node pool, so stitching is O(segments). out is unchanged if a copy throws.
+         *
+         * The sub-lists have no observer. Once they are stitched, the observer of out gets a node allocation and an
+         * element copy (or move) for every element, as if out had built them itself, then one insert of them all.
+         */
+        template<typename P, typename R, typename T, typename Allocator, typename Observer>
+        void parallel_append(const P& policy, R&& r, list<T, Allocator, Observer>& out) {
+            using list_type = list<T, Allocator, Observer>;
+            using reference = std::ranges::range_reference_t<R>;
+            auto n = static_cast<std::size_t>(std::ranges::size(r));
+            auto parts = segment_count(policy, n);
+            auto bounds = split_points(std::ranges::begin(r), n, parts);
+
+            std::vector<list<T, Allocator>> pieces;
+            pieces.reserve(parts);
+            for (std::size_t i = 0; i < parts; ++i) {
+                pieces.emplace_back(out.get_allocator());
+            }
+            run_segments(policy, parts, [&](std::size_t i) {
+                auto& piece = pieces[i];
+                piece.reserve(static_cast<std::size_t>(std::distance(bounds[i], bounds[i + 1])));
+                for (auto it = bounds[i]; it != bounds[i + 1]; ++it) {
+                    piece.emplace_back(*it);
+                }
+            });
+            auto was_empty = out.empty();
+            auto last_old = was_empty ? out.end() : std::prev(out.end());
+            for (auto& piece : pieces) {
+                out.splice(out.end(), piece);
+            }
+            if (n == 0) {
+                return;
+            }
+
+            // the same reports as list::emplace_back(*it) on out
+            auto& observer = out.observer();
+            for (std::size_t i = 0; i < n; ++i) {
+                observer.on_node_allocate(out);
+                if constexpr (std::is_same_v<std::remove_cvref_t<reference>, T>) {
+                    if constexpr (std::is_rvalue_reference_v<reference&&> && !std::is_const_v<std::remove_reference_t<reference>>) {
+                        observer.on_element_move(out);
+                    } else {
+                        observer.on_element_copy(out);
+                    }
+                }
+            }
+            auto first = was_empty ? out.begin() : std::next(last_old);
+            observer.on_insert(out, typename list_type::const_iterator(first), n);
+        }
+
+        /// copies other into a new list, returned by NRVO: moving it would give the copy a fresh observer
+        template<typename P, typename T, typename Allocator, typename Observer>
+        list<T, Allocator, Observer> parallel_copy(const P& policy, const list<T, Allocator, Observer>& other,
+                                                   const Allocator& alloc) {
+            other.observer().on_copied(other);
+            list<T, Allocator, Observer> out(alloc);
+            parallel_append(policy, other, out);
+            return out;
+        }
+    }
+
+    /**
+     * @brief Copies a list, like its copy constructor, building the copy on several threads
+     *
+     * The copy has the same elements in the same order and the allocator given by
+     * select_on_container_copy_construction, like list(const list&). Each thread copies a segment into a list of
+     * its own and the lists are spliced together in O(threads).
+     *
+     * @param policy execution policy
+     * @param other list to copy
+     * @return list<T, Allocator, Observer>
+     * @note The allocator is used from several threads at once, so it must be thread-safe (std::allocator is, a
+     *       polymorphic allocator on an unsynchronized memory resource isn't: use seq for those).
+     */
+    template<typename P, typename T, typename Allocator, typename Observer>
+    requires execution::is_execution_policy_v<P>
+    [[nodiscard]]
+    list<T, Allocator, Observer> copy(P&& policy, const list<T, Allocator, Observer>& other) {
+        if constexpr (detail::is_sequenced<P>()) {
+            return list<T, Allocator, Observer>(other);
+        } else {
+            return detail::parallel_copy(policy, other,
+                                         std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator()));
+        }
+    }
+
+    /**
+     * @brief Copies a list using the given allocator, building the copy on several threads
+     *
+     * @param policy execution policy
+     * @param other list to copy
+     * @param alloc allocator of the copy, thread-safe
+     * @return list<T, Allocator, Observer>
+     */
+    template<typename P, typename T, typename Allocator, typename Observer>
+    requires execution::is_execution_policy_v<P>
+    [[nodiscard]]
+    list<T, Allocator, Observer> copy(P&& policy, const list<T, Allocator, Observer>& other,
+                                      const std::type_identity_t<Allocator>& alloc) {
+        if constexpr (detail::is_sequenced<P>()) {
+            return list<T, Allocator, Observer>(other, alloc);
+        } else {
+            return detail::parallel_copy(policy, other, alloc);
+        }
+    }
+
+    /**
+     * @brief Replaces the elements of a list by copies of the elements of another, like its copy assignment
+     *
+     * The allocator propagates according to propagate_on_container_copy_assignment, like in operator=. The
+     * observer of lst sees a clear and one insert of all the elements instead of a copy assignment.
+     *
+     * @param policy execution policy
+     * @param lst list to assign to
+     * @param other list to copy
+     * @return lst
+     */
+    template<typename P, typename T, typename Allocator, typename Observer>
+    requires execution::is_execution_policy_v<P>
+    list<T, Allocator, Observer>& assign(P&& policy, list<T, Allocator, Observer>& lst,
+                                         const list<T, Allocator, Observer>& other) {
+        if constexpr (detail::is_sequenced<P>()) {
+            lst = other;
+        } else if (&lst != &other) {
+            lst.clear();
+            if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+                // copying an empty list takes over the allocator of other
+                const list<T, Allocator, Observer> empty(other.get_allocator());
+                lst = empty;
+            }
+            other.observer().on_copied(other);
+            detail::parallel_append(policy, other, lst);
+        }
+        return lst;
+    }
+
+    /**
+     * @brief Builds a list from the elements of a sized range, on several threads
+     *
+     * @param policy execution policy
+     * @param r sized forward range whose elements T can be constructed from
+     * @param alloc allocator of the list, thread-safe
+     * @return list<T, Allocator, Observer>
+     */
+    template<typename T, typename Allocator = std::allocator<T>, typename Observer = list_observer, typename P,
+             std::ranges::forward_range R>
+    requires execution::is_execution_policy_v<P> && std::ranges::sized_range<R>
+    [[nodiscard]]
+    list<T, Allocator, Observer> make_list(P&& policy, R&& r, const Allocator& alloc = Allocator()) {
+        list<T, Allocator, Observer> out(alloc);
+        if constexpr (detail::is_sequenced<P>()) {
+            for (auto&& x : r) {
+                out.emplace_back(x);
+            }
+        } else {
+            detail::parallel_append(policy, r, out);
+        }
+        return out;
+    }
+}
+
+#endif
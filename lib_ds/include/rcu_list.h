@@ -0,0 +1,386 @@
+#ifndef INCLUDE_RCU_LIST_H
+#define INCLUDE_RCU_LIST_H
+
+/**
+ * @file rcu_list.h
+ * @brief Read-mostly list with lock-free traversal (read-copy-update)
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+#include "epoch.h"
+#include "list.h"
+
+namespace saxion {
+
+    namespace detail {
+
+        /**
+         * @brief Node of an rcu_list: the links of a list node followed by the value
+         *
+         * next_ is written by the writer with a release store and read by the readers with an acquire load
+         * (std::atomic_ref), prev_ is only used by the writer.
+         */
+        template<typename T>
+        struct rcu_node : public list_node_base {
+            T value_;
+
+            template<typename... Args>
+            explicit rcu_node(Args&&... args) :
+                list_node_base{},
+                value_(std::forward<Args>(args)...)
+            {}
+
+            /// deleter handed to the epoch domain
+            static void destroy(void* node) {
+                delete static_cast<rcu_node*>(node);
+            }
+        };
+
+        [[nodiscard]]
+        inline list_node_base* rcu_next(list_node_base* node) noexcept {
+            return std::atomic_ref<list_node_base*>(node->next_).load(std::memory_order_acquire);
+        }
+
+        inline void rcu_publish(list_node_base* node, list_node_base* next) noexcept {
+            std::atomic_ref<list_node_base*>(node->next_).store(next, std::memory_order_release);
+        }
+
+        /**
+         * @brief Forward iterator of a read section of an rcu_list
+         *
+         * Valid as long as the read section it was obtained from. Elements erased meanwhile can still be reached,
+         * elements inserted meanwhile may or may not be.
+         */
+        template<typename T>
+        struct rcu_list_iterator {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            list_node_base* current_{};
+
+            rcu_list_iterator() = default;
+
+            explicit rcu_list_iterator(list_node_base* node) noexcept :
+                current_{node}
+            {}
+
+            reference operator*() const noexcept {
+                return static_cast<rcu_node<T>*>(current_)->value_;
+            }
+
+            pointer operator->() const noexcept {
+                return &**this;
+            }
+
+            rcu_list_iterator& operator++() noexcept {
+                current_ = rcu_next(current_);
+                return *this;
+            }
+
+            rcu_list_iterator operator++(int) noexcept {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const rcu_list_iterator&) const = default;
+        };
+    }
+
+    /**
+     * @brief Doubly-linked list for data that is read far more often than it is changed
+     *
+     * Readers open a read section (read()) and traverse the list without any lock and without atomic
+     * read-modify-write operations: every step is an acquire load, a plain load on x86 and ARMv8.3+. The only
+     * shared write of a reader is announcing its epoch when the section starts.
+     *
+     * Writers are serialized by a mutex. A new node is fully constructed before it is published with a release
+     * store, so a reader sees either the old or the new list. Unlinked nodes keep their link to the next node,
+     * so a reader standing on one can go on; they are retired to the global epoch domain and freed after the
+     * grace period, when no read section that could see them is left.
+     *
+     * @tparam T type of the elements
+     */
+    template<typename T>
+    class rcu_list {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using const_iterator = detail::rcu_list_iterator<T>;
+        using iterator = const_iterator;
+
+    private:
+        using node_t = detail::rcu_node<T>;
+
+        // the sentinel is written by the writer only, readers only read its next_
+        detail::list_node_base node_{};
+
+        std::mutex writer_mutex_{};
+        std::atomic<size_type> size_{};
+
+        [[nodiscard]]
+        static epoch_domain& domain() noexcept {
+            return epoch_domain::global();
+        }
+
+        /// links a new node before pos, the writer lock must be held
+        template<typename... Args>
+        void link_new_node(detail::list_node_base* pos, Args&&... args) {
+            auto node = new node_t(std::forward<Args>(args)...);
+            auto prev = pos->prev_;
+            node->prev_ = prev;
+            node->next_ = pos;
+            pos->prev_ = node;
+            detail::rcu_publish(prev, node);
+            size_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// unlinks a node and retires it, the writer lock must be held
+        void unlink_node(detail::list_node_base* node) {
+            auto next = node->next_;
+            next->prev_ = node->prev_;
+            // node->next_ is left alone: readers standing on node can still leave it
+            detail::rcu_publish(node->prev_, next);
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            domain().retire(node, &node_t::destroy);
+        }
+
+    public:
+
+        /**
+         * @brief A read section, the list can be traversed while it exists
+         *
+         * @note Don't keep a read section open for long, it delays the reclamation of all the retired nodes.
+         */
+        class read_view {
+            epoch_domain::guard guard_;
+            detail::list_node_base* sentinel_;
+
+        public:
+            explicit read_view(detail::list_node_base* sentinel) :
+                guard_{domain()},
+                sentinel_{sentinel}
+            {}
+
+            [[nodiscard]]
+            const_iterator begin() const noexcept {
+                return const_iterator{detail::rcu_next(sentinel_)};
+            }
+
+            [[nodiscard]]
+            const_iterator end() const noexcept {
+                return const_iterator{sentinel_};
+            }
+        };
+
+        /**
+         * @brief Construct a new, empty list
+         */
+        rcu_list() {
+            node_.prev_ = node_.next_ = &node_;
+        }
+
+        /**
+         * @brief Construct a new list object from an initializer list
+         *
+         * @param values values to copy
+         */
+        rcu_list(std::initializer_list<T> values) :
+            rcu_list() {
+            for (const auto& value : values) {
+                link_new_node(&node_, value);
+            }
+        }
+
+        // the nodes point to the sentinel
+        rcu_list(const rcu_list&) = delete;
+        rcu_list& operator=(const rcu_list&) = delete;
+
+        /**
+         * @brief Destroy the list, no reader or writer may be using it anymore
+         *
+         * @note Nodes that were already retired are freed by the epoch domain.
+         */
+        ~rcu_list() {
+            for (auto current = node_.next_; current != &node_;) {
+                delete static_cast<node_t*>(std::exchange(current, current->next_));
+            }
+        }
+
+        /**
+         * @brief Opens a read section
+         *
+         * @return view whose iterators stay valid while it exists
+         */
+        [[nodiscard]]
+        read_view read() const {
+            return read_view{const_cast<detail::list_node_base*>(&node_)};
+        }
+
+        /**
+         * @brief Calls f for every element, in a read section of its own
+         *
+         * @param f function called with a const reference to every element
+         */
+        template<typename F>
+        void for_each(F f) const {
+            for (const auto& value : read()) {
+                f(value);
+            }
+        }
+
+        /**
+         * @brief Checks if the list contains an element equal to value
+         *
+         * @param value value to look for
+         * @return true if found
+         */
+        template<typename V>
+        [[nodiscard]]
+        bool contains(const V& value) const {
+            auto view = read();
+            return std::find(view.begin(), view.end(), value) != view.end();
+        }
+
+        /**
+         * @brief Emplaces an element at the end of the list
+         *
+         * @param args arguments passed to the constructor of the element
+         */
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            std::lock_guard lock{writer_mutex_};
+            link_new_node(&node_, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Emplaces an element at the front of the list
+         *
+         * @param args arguments passed to the constructor of the element
+         */
+        template<typename... Args>
+        void emplace_front(Args&&... args) {
+            std::lock_guard lock{writer_mutex_};
+            link_new_node(node_.next_, std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const T& value) {
+            emplace_front(value);
+        }
+
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+
+        /**
+         * @brief Erases all the elements that satisfy pred
+         *
+         * @param pred unary predicate, called by the writer only
+         * @return number of erased elements
+         */
+        template<typename Pred>
+        size_type remove_if(Pred pred) {
+            std::lock_guard lock{writer_mutex_};
+            size_type count = 0;
+            for (auto current = node_.next_; current != &node_;) {
+                auto next = current->next_;
+                if (pred(static_cast<node_t*>(current)->value_)) {
+                    unlink_node(current);
+                    ++count;
+                }
+                current = next;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Erases all the elements equal to value
+         *
+         * @param value value to compare with
+         * @return number of erased elements
+         */
+        template<typename V>
+        size_type remove(const V& value) {
+            return remove_if([&value](const T& element) { return element == value; });
+        }
+
+        /**
+         * @brief Replaces the elements that satisfy pred by a copy of value
+         *
+         * The new element is linked in place of the old one in a single publication: a reader sees either the old
+         * or the new element, never both and never neither.
+         *
+         * @param pred unary predicate, called by the writer only
+         * @param value new value
+         * @return number of replaced elements
+         */
+        template<typename Pred>
+        size_type replace_if(Pred pred, const T& value) {
+            std::lock_guard lock{writer_mutex_};
+            size_type count = 0;
+            for (auto current = node_.next_; current != &node_; current = current->next_) {
+                if (pred(static_cast<node_t*>(current)->value_)) {
+                    auto node = new node_t(value);
+                    node->prev_ = current->prev_;
+                    node->next_ = current->next_;
+                    current->next_->prev_ = node;
+                    detail::rcu_publish(current->prev_, node);
+                    domain().retire(std::exchange(current, node), &node_t::destroy);
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief Erases all the elements
+         */
+        void clear() {
+            remove_if([](const T&) { return true; });
+        }
+
+        /**
+         * @brief Number of elements, exact only when no writer is active
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return size_.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        /**
+         * @brief Waits until the nodes erased so far by this thread are freed
+         *
+         * @note Must not be called inside a read section.
+         */
+        void synchronize() {
+            domain().synchronize();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef INCLUDE_SHARDED_LIST_H
+#define INCLUDE_SHARDED_LIST_H
+
+/**
+ * @file sharded_list.h
+ * @brief Append-only list split in per-thread shards, drained into a saxion::list
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "list.h"
+
+namespace saxion {
+
+    namespace detail {
+
+        /**
+         * @brief Small index of the calling thread: 0 for the first thread that asks, 1 for the second, ...
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]]
+        inline std::size_t thread_index() noexcept {
+            static std::atomic<std::size_t> next_index{0};
+            thread_local std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+    }
+
+    /**
+     * @brief List that many threads append to and one thread drains
+     *
+     * The list is split in shards, each a saxion::list with its own lock on its own cache line. A thread always
+     * appends to the same shard, thread i to shard i % shard_count(), so with at least as many shards as
+     * appending threads a lock is only ever contended by drain().
+     *
+     * drain() splices the shards into one saxion::list. Whole-list splices between lists with equal allocators
+     * relink the nodes and hand over the node pools, so a drain is O(shard_count()) whatever the number of
+     * elements. Appending after a drain starts a new slab in each shard.
+     *
+     * @tparam T type of the elements
+     * @tparam Allocator allocator of the shards and of the drained lists
+     * @tparam Observer observer of the shards and of the drained lists, every shard reports its own appends
+     */
+    template<typename T, typename Allocator = std::allocator<T>, typename Observer = list_observer>
+    class sharded_list {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using list_type = list<T, Allocator, Observer>;
+
+    private:
+        struct alignas(64) shard {
+            std::mutex mutex_{};
+            list_type list_;
+
+            explicit shard(const Allocator& alloc) :
+                list_(alloc)
+            {}
+        };
+
+        Allocator alloc_;
+        std::vector<std::unique_ptr<shard>> shards_;
+
+        [[nodiscard]]
+        shard& local_shard() noexcept {
+            return *shards_[detail::thread_index() % shards_.size()];
+        }
+
+        /// moves the elements of every shard to a list of its own, taking every lock once
+        std::vector<list_type> take_shards() {
+            std::vector<list_type> taken;
+            taken.reserve(shards_.size());
+            for (auto& s : shards_) {
+                taken.emplace_back(alloc_);
+                std::lock_guard lock{s->mutex_};
+                taken.back().splice(taken.back().end(), s->list_);
+            }
+            return taken;
+        }
+
+    public:
+
+        /**
+         * @brief Number of shards used when none is given: one per hardware thread
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        static size_type default_shard_count() noexcept {
+            return std::max(1U, std::thread::hardware_concurrency());
+        }
+
+        /**
+         * @brief Construct a new, empty sharded list
+         *
+         * @param shard_count number of shards, at least 1
+         * @param alloc allocator of the shards
+         */
+        explicit sharded_list(size_type shard_count = default_shard_count(), const Allocator& alloc = Allocator()) :
+                alloc_(alloc) {
+            shards_.reserve(std::max<size_type>(1, shard_count));
+            for (size_type i = 0; i < std::max<size_type>(1, shard_count); ++i) {
+                shards_.push_back(std::make_unique<shard>(alloc));
+            }
+        }
+
+        // the threads refer to the shards
+        sharded_list(const sharded_list&) = delete;
+        sharded_list& operator=(const sharded_list&) = delete;
+
+        /**
+         * @brief Appends an element to the shard of the calling thread
+         *
+         * @param args arguments passed to the constructor of the element
+         */
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            auto& s = local_shard();
+            std::lock_guard lock{s.mutex_};
+            s.list_.emplace_back(std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * @brief Moves all the elements to the end of out
+         *
+         * The elements of one shard keep their order, the shards follow each other.
+         *
+         * @param out list to append to, with an allocator equal to the one of this list for O(1) splices
+         */
+        void drain(list_type& out) {
+            for (auto& s : shards_) {
+                std::lock_guard lock{s->mutex_};
+                out.splice(out.end(), s->list_);
+            }
+        }
+
+        /**
+         * @brief Moves all the elements to a new list
+         *
+         * @return list_type
+         */
+        [[nodiscard]]
+        list_type drain() {
+            list_type out(alloc_);
+            drain(out);
+            return out;
+        }
+
+        /**
+         * @brief Moves all the elements to a new list, merging the shards in the order of comp
+         *
+         * The shards are merged pairwise, O(n log shard_count()) comparisons. A shard that isn't sorted already
+         * (e.g. because two threads share it) is sorted first. The locks are only held to take the shards.
+         *
+         * @param comp strict weak ordering of the projected elements
+         * @param proj projection applied to the elements, e.g. a pointer to a timestamp member
+         * @return list_type the elements, sorted; equivalent elements of the same shard keep their order
+         */
+        template<typename Compare = std::less<>, typename Projection = std::identity>
+        [[nodiscard]]
+        list_type drain_merged(Compare comp = {}, Projection proj = {}) {
+            auto less = [&comp, &proj](const T& lhs, const T& rhs) {
+                return std::invoke(comp, std::invoke(proj, lhs), std::invoke(proj, rhs));
+            };
+
+            auto lists = take_shards();
+            for (auto& lst : lists) {
+                if (!std::is_sorted(lst.begin(), lst.end(), less)) {
+                    lst.sort(less);
+                }
+            }
+            for (size_type step = 1; step < lists.size(); step *= 2) {
+                for (size_type i = 0; i + step < lists.size(); i += 2 * step) {
+                    lists[i].merge(lists[i + step], less);
+                }
+            }
+            return std::move(lists.front());
+        }
+
+        /**
+         * @brief Number of elements, exact only when no other thread is appending
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type size() {
+            size_type n = 0;
+            for (auto& s : shards_) {
+                std::lock_guard lock{s->mutex_};
+                n += s->list_.size();
+            }
+            return n;
+        }
+
+        [[nodiscard]]
+        bool empty() {
+            return size() == 0;
+        }
+
+        [[nodiscard]]
+        size_type shard_count() const noexcept {
+            return shards_.size();
+        }
+
+        [[nodiscard]]
+        allocator_type get_allocator() const noexcept {
+            return alloc_;
+        }
+    };
+
+    namespace pmr {
+        /// saxion::sharded_list using a polymorphic allocator
+        template<typename T>
+        using sharded_list = saxion::sharded_list<T, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+#endif
@@ -0,0 +1,481 @@
+#ifndef INCLUDE_SHM_LIST_H
+#define INCLUDE_SHM_LIST_H
+
+/**
+ * @file shm_list.h
+ * @brief Doubly linked list living in a shared memory segment, for exchanging records between processes
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace saxion {
+
+    namespace detail {
+
+        /// position of a node in a segment, relative to the start of the segment; 0 is no node
+        using shm_offset = std::uint64_t;
+
+        /**
+         * @brief Links of a node in a shared memory segment
+         *
+         * The segment is mapped at a different address in every process, so the links are offsets from the start
+         * of the segment instead of pointers.
+         */
+        struct shm_node_base {
+            shm_offset prev_;
+            shm_offset next_;
+        };
+
+        template<typename T>
+        struct shm_node : shm_node_base {
+            T value_;
+        };
+
+        /// throws the std::system_error of errno
+        [[noreturn]]
+        inline void throw_errno(const char* what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        /// throws the std::system_error of a pthread return code, if it is not 0
+        inline void check_pthread(int rc, const char* what) {
+            if (rc != 0) {
+                throw std::system_error(rc, std::generic_category(), what);
+            }
+        }
+    }
+
+    /**
+     * @brief FIFO list in a shared memory segment: one process pushes records, another pops them
+     *
+     * The segment holds a header with a process-shared mutex and two condition variables, the sentinel of the
+     * list and a fixed number of node slots. The nodes are linked by offsets, so every process sees the same list
+     * wherever the segment is mapped. A pushed value is copied once into its node and read in place by
+     * for_each(), or copied once out of it by pop_front(); there is no serialization.
+     *
+     * Free slots are kept in a singly linked free list in the segment, so the segment never grows: a push to a full
+     * list waits (push_back()) or fails (try_push_back()).
+     *
+     * The mutex is robust: if a process dies while holding it, the next process that locks it takes it over instead
+     * of waiting forever. The list may be left inconsistent if the process died in the middle of an operation.
+     *
+     * @tparam T type of the records; trivially copyable since they are read by another address space
+     */
+    template<typename T>
+    class shm_list {
+        static_assert(std::is_trivially_copyable_v<T>, "the records are copied byte-wise between processes");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+    private:
+        using node_t = detail::shm_node<T>;
+        using offset = detail::shm_offset;
+
+        /// value of header::magic_ once the segment is initialized
+        static constexpr std::uint64_t magic = 0x7361786c73686d31;  // "saxlshm1"
+
+        struct header {
+            std::atomic<std::uint64_t> magic_;
+            /// layout of the records, checked when a segment is opened
+            std::uint64_t value_size_;
+            std::uint64_t value_align_;
+
+            pthread_mutex_t mutex_;
+            pthread_cond_t not_empty_;
+            pthread_cond_t not_full_;
+
+            detail::shm_node_base sentinel_;
+            std::uint64_t size_;
+            std::uint64_t capacity_;
+            /// number of slots ever used: the slots behind it were never linked in the free list
+            std::uint64_t used_;
+            offset free_;
+        };
+
+        static constexpr std::size_t nodes_offset = (sizeof(header) + alignof(node_t) - 1) / alignof(node_t) * alignof(node_t);
+        static constexpr offset sentinel_offset = offsetof(header, sentinel_);
+
+        std::byte* base_{};
+        std::size_t bytes_{};
+
+        /// frees the mapping in case of failure while it is being set up
+        struct mapping_guard {
+            std::byte* base_;
+            std::size_t bytes_;
+
+            ~mapping_guard() {
+                if (base_) {
+                    ::munmap(base_, bytes_);
+                }
+            }
+        };
+
+        shm_list(std::byte* base, std::size_t bytes) noexcept :
+            base_{base},
+            bytes_{bytes}
+        {}
+
+        [[nodiscard]]
+        static std::size_t segment_bytes(size_type capacity) noexcept {
+            return nodes_offset + capacity * sizeof(node_t);
+        }
+
+        [[nodiscard]]
+        header& head() const noexcept {
+            return *reinterpret_cast<header*>(base_);
+        }
+
+        [[nodiscard]]
+        detail::shm_node_base& links(offset off) const noexcept {
+            return *reinterpret_cast<detail::shm_node_base*>(base_ + off);
+        }
+
+        [[nodiscard]]
+        node_t& node(offset off) const noexcept {
+            return *static_cast<node_t*>(&links(off));
+        }
+
+        /// sets up the header of a new segment, the segment is published last
+        static void initialize(std::byte* base, size_type capacity) {
+            auto* h = new (base) header{};
+            h->value_size_ = sizeof(T);
+            h->value_align_ = alignof(T);
+            h->sentinel_ = {sentinel_offset, sentinel_offset};
+            h->capacity_ = capacity;
+
+            pthread_mutexattr_t mutex_attr;
+            detail::check_pthread(pthread_mutexattr_init(&mutex_attr), "pthread_mutexattr_init");
+            pthread_mutexattr_setpshared(&mutex_attr, PTHREAD_PROCESS_SHARED);
+            pthread_mutexattr_setrobust(&mutex_attr, PTHREAD_MUTEX_ROBUST);
+            int rc = pthread_mutex_init(&h->mutex_, &mutex_attr);
+            pthread_mutexattr_destroy(&mutex_attr);
+            detail::check_pthread(rc, "pthread_mutex_init");
+
+            pthread_condattr_t cond_attr;
+            detail::check_pthread(pthread_condattr_init(&cond_attr), "pthread_condattr_init");
+            pthread_condattr_setpshared(&cond_attr, PTHREAD_PROCESS_SHARED);
+            rc = pthread_cond_init(&h->not_empty_, &cond_attr);
+            if (rc == 0) {
+                rc = pthread_cond_init(&h->not_full_, &cond_attr);
+            }
+            pthread_condattr_destroy(&cond_attr);
+            detail::check_pthread(rc, "pthread_cond_init");
+
+            h->magic_.store(magic, std::memory_order_release);
+        }
+
+        /// the process-shared mutex, taken over if its last owner died
+        class lock_guard {
+            pthread_mutex_t& mutex_;
+
+        public:
+            explicit lock_guard(pthread_mutex_t& mutex) :
+                    mutex_{mutex} {
+                int rc = pthread_mutex_lock(&mutex_);
+                if (rc == EOWNERDEAD) {
+                    rc = pthread_mutex_consistent(&mutex_);
+                }
+                detail::check_pthread(rc, "pthread_mutex_lock");
+            }
+
+            lock_guard(const lock_guard&) = delete;
+            lock_guard& operator=(const lock_guard&) = delete;
+
+            ~lock_guard() {
+                pthread_mutex_unlock(&mutex_);
+            }
+
+            void wait(pthread_cond_t& cond) {
+                int rc = pthread_cond_wait(&cond, &mutex_);
+                if (rc == EOWNERDEAD) {
+                    rc = pthread_mutex_consistent(&mutex_);
+                }
+                detail::check_pthread(rc, "pthread_cond_wait");
+            }
+        };
+
+        /// takes a free slot, the lock must be held and the list must not be full
+        [[nodiscard]]
+        offset allocate_slot() noexcept {
+            auto& h = head();
+            if (h.free_ != 0) {
+                offset off = h.free_;
+                h.free_ = links(off).next_;
+                return off;
+            }
+            return nodes_offset + h.used_++ * sizeof(node_t);
+        }
+
+        /// links a slot holding a value at the end, the lock must be held
+        void link_back(offset off) noexcept {
+            auto& h = head();
+            offset last = h.sentinel_.prev_;
+            links(off) = {last, sentinel_offset};
+            links(last).next_ = off;
+            h.sentinel_.prev_ = off;
+            ++h.size_;
+            pthread_cond_signal(&h.not_empty_);
+        }
+
+        /// unlinks the first node, moves its value out and frees its slot, the lock must be held
+        [[nodiscard]]
+        T unlink_front() noexcept {
+            auto& h = head();
+            offset off = h.sentinel_.next_;
+            auto& n = node(off);
+            T value = n.value_;
+            h.sentinel_.next_ = n.next_;
+            links(n.next_).prev_ = sentinel_offset;
+            n.next_ = h.free_;
+            h.free_ = off;
+            --h.size_;
+            pthread_cond_signal(&h.not_full_);
+            return value;
+        }
+
+    public:
+
+        /**
+         * @brief Creates a named segment, see shm_open(); the segment stays until remove() is called
+         *
+         * @param name name of the segment, e.g. "/records"
+         * @param capacity maximum number of records
+         * @return shm_list mapping the new segment
+         * @throw std::system_error if the segment exists already or can't be created
+         */
+        [[nodiscard]]
+        static shm_list create(const std::string& name, size_type capacity) {
+            int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                detail::throw_errno("shm_open");
+            }
+            auto bytes = segment_bytes(capacity);
+            void* base = MAP_FAILED;
+            if (::ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+                base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            int error = errno;
+            ::close(fd);
+            if (base == MAP_FAILED) {
+                ::shm_unlink(name.c_str());
+                errno = error;
+                detail::throw_errno("mmap");
+            }
+            mapping_guard guard{static_cast<std::byte*>(base), bytes};
+            try {
+                initialize(guard.base_, capacity);
+            } catch (...) {
+                ::shm_unlink(name.c_str());
+                throw;
+            }
+            return shm_list{std::exchange(guard.base_, nullptr), bytes};
+        }
+
+        /**
+         * @brief Maps a named segment created by another process
+         *
+         * @param name name given to create()
+         * @return shm_list mapping the segment
+         * @throw std::system_error if the segment doesn't exist, isn't initialized yet or holds another type
+         */
+        [[nodiscard]]
+        static shm_list open(const std::string& name) {
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) {
+                detail::throw_errno("shm_open");
+            }
+            struct stat st{};
+            void* base = MAP_FAILED;
+            if (::fstat(fd, &st) == 0) {
+                if (static_cast<std::size_t>(st.st_size) < sizeof(header)) {
+                    ::close(fd);
+                    throw std::system_error(std::make_error_code(std::errc::invalid_argument), "shm_list: segment not initialized");
+                }
+                base = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            }
+            int error = errno;
+            ::close(fd);
+            if (base == MAP_FAILED) {
+                errno = error;
+                detail::throw_errno("mmap");
+            }
+            mapping_guard guard{static_cast<std::byte*>(base), static_cast<std::size_t>(st.st_size)};
+            auto& h = *reinterpret_cast<header*>(guard.base_);
+            if (h.magic_.load(std::memory_order_acquire) != magic) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument), "shm_list: segment not initialized");
+            }
+            if (h.value_size_ != sizeof(T) || h.value_align_ != alignof(T) || segment_bytes(h.capacity_) > guard.bytes_) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument), "shm_list: segment holds another type");
+            }
+            return shm_list{std::exchange(guard.base_, nullptr), guard.bytes_};
+        }
+
+        /**
+         * @brief Creates an unnamed segment, shared with the processes fork()ed afterwards
+         *
+         * @param capacity maximum number of records
+         * @return shm_list mapping the new segment
+         */
+        [[nodiscard]]
+        static shm_list anonymous(size_type capacity) {
+            auto bytes = segment_bytes(capacity);
+            void* base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED) {
+                detail::throw_errno("mmap");
+            }
+            mapping_guard guard{static_cast<std::byte*>(base), bytes};
+            initialize(guard.base_, capacity);
+            return shm_list{std::exchange(guard.base_, nullptr), bytes};
+        }
+
+        /**
+         * @brief Removes a named segment; the processes that mapped it keep their mapping
+         *
+         * @param name name given to create()
+         * @return true if the segment existed
+         */
+        static bool remove(const std::string& name) noexcept {
+            return ::shm_unlink(name.c_str()) == 0;
+        }
+
+        shm_list(shm_list&& other) noexcept :
+            base_{std::exchange(other.base_, nullptr)},
+            bytes_{std::exchange(other.bytes_, 0)}
+        {}
+
+        shm_list& operator=(shm_list&& other) noexcept {
+            if (this != &other) {
+                std::swap(base_, other.base_);
+                std::swap(bytes_, other.bytes_);
+            }
+            return *this;
+        }
+
+        // a copy would unmap the segment twice
+        shm_list(const shm_list&) = delete;
+        shm_list& operator=(const shm_list&) = delete;
+
+        /**
+         * @brief Unmaps the segment, the list itself stays in it
+         */
+        ~shm_list() {
+            if (base_) {
+                ::munmap(base_, bytes_);
+            }
+        }
+
+        /**
+         * @brief Appends a record if there is a free slot
+         *
+         * @param value record to copy into the segment
+         * @return true if the record was appended, false if the list is full
+         */
+        bool try_push_back(const T& value) {
+            auto& h = head();
+            lock_guard lock{h.mutex_};
+            if (h.size_ == h.capacity_) {
+                return false;
+            }
+            offset off = allocate_slot();
+            node(off).value_ = value;
+            link_back(off);
+            return true;
+        }
+
+        /**
+         * @brief Appends a record, waiting for a free slot while the list is full
+         *
+         * @param value record to copy into the segment
+         */
+        void push_back(const T& value) {
+            auto& h = head();
+            lock_guard lock{h.mutex_};
+            while (h.size_ == h.capacity_) {
+                lock.wait(h.not_full_);
+            }
+            offset off = allocate_slot();
+            node(off).value_ = value;
+            link_back(off);
+        }
+
+        /**
+         * @brief Removes the first record if there is one
+         *
+         * @return the record, or an empty optional if the list is empty
+         */
+        [[nodiscard]]
+        std::optional<T> try_pop_front() {
+            auto& h = head();
+            lock_guard lock{h.mutex_};
+            if (h.size_ == 0) {
+                return std::nullopt;
+            }
+            return unlink_front();
+        }
+
+        /**
+         * @brief Removes the first record, waiting for one while the list is empty
+         *
+         * @return T
+         */
+        [[nodiscard]]
+        T pop_front() {
+            auto& h = head();
+            lock_guard lock{h.mutex_};
+            while (h.size_ == 0) {
+                lock.wait(h.not_empty_);
+            }
+            return unlink_front();
+        }
+
+        /**
+         * @brief Calls fn on every record, in order, reading them in place
+         *
+         * @param fn function taking a const T&; it runs under the lock of the segment, so it must not use this list
+         */
+        template<typename Fn>
+        void for_each(Fn fn) const {
+            auto& h = head();
+            lock_guard lock{h.mutex_};
+            for (offset off = h.sentinel_.next_; off != sentinel_offset; off = links(off).next_) {
+                fn(std::as_const(node(off).value_));
+            }
+        }
+
+        [[nodiscard]]
+        size_type size() const {
+            auto& h = head();
+            lock_guard lock{h.mutex_};
+            return h.size_;
+        }
+
+        [[nodiscard]]
+        bool empty() const {
+            return size() == 0;
+        }
+
+        [[nodiscard]]
+        size_type capacity() const noexcept {
+            return head().capacity_;
+        }
+    };
+}
+
+#endif
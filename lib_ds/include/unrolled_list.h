@@ -0,0 +1,871 @@
+#ifndef INCLUDE_UNROLLED_LIST_H
+#define INCLUDE_UNROLLED_LIST_H
+
+/**
+ * @file unrolled_list.h
+ * @brief Unrolled doubly-linked list, every node stores a small array of elements
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+
+namespace saxion {
+
+    template<typename T, typename Allocator, std::size_t ChunkBytes>
+    class unrolled_list;
+
+    namespace detail {
+
+        /// default size of an unrolled list node: four cache lines
+        inline constexpr std::size_t unrolled_chunk_bytes = 4 * 64;
+
+        /**
+         * @brief Links and element count shared by the chunks and the sentinel of an unrolled list
+         *
+         * The sentinel always has a count of 0, the size of the list is kept by the list itself.
+         */
+        struct unrolled_node_base : public list_node_base {
+            std::size_t count_{};
+
+            unrolled_node_base() noexcept = default;
+
+            /// makes an empty chain containing just this node
+            void reset() noexcept {
+                prev_ = this;
+                next_ = this;
+                count_ = 0;
+            }
+        };
+
+        /**
+         * @brief Number of elements stored in a chunk of (roughly) the given size, at least 2
+         */
+        template<typename T>
+        [[nodiscard]]
+        constexpr std::size_t unrolled_capacity(std::size_t chunk_bytes) noexcept {
+            constexpr auto header = sizeof(unrolled_node_base);
+            auto capacity = chunk_bytes > header ? (chunk_bytes - header) / sizeof(T) : 0;
+            return capacity < 2 ? 2 : capacity;
+        }
+
+        /**
+         * @brief Chunk of an unrolled list
+         *
+         * Elements [0, count_) of values_ are alive, the rest is uninitialized storage.
+         *
+         * @tparam T type of the elements
+         * @tparam Capacity maximum number of elements in the chunk
+         */
+        template<typename T, std::size_t Capacity>
+        struct unrolled_node : public unrolled_node_base {
+            union {
+                T values_[Capacity];
+            };
+
+            unrolled_node() noexcept:
+                unrolled_node_base{}
+            {}
+
+            unrolled_node(const unrolled_node&) = delete;
+            unrolled_node& operator=(const unrolled_node&) = delete;
+
+            ~unrolled_node() requires std::is_trivially_destructible_v<T> = default;
+
+            /// doesn't destroy the values
+            ~unrolled_node() {}
+
+            [[nodiscard]]
+            bool full() const noexcept {
+                return count_ == Capacity;
+            }
+
+            [[nodiscard]]
+            T* slot(std::size_t index) noexcept {
+                return std::addressof(values_[index]);
+            }
+        };
+
+        template<typename T, typename NodeT>
+        struct const_unrolled_list_iterator;
+
+        template<typename T, typename NodeT>
+        struct unrolled_list_iterator {
+            template<typename, typename, std::size_t> friend
+            class ::saxion::unrolled_list;
+
+            // the iterator walks the chunks, NodeT is the concrete chunk type
+            using node_t = unrolled_node_base;
+
+            node_t* current_;
+            std::size_t index_;
+
+            using value_type = T;
+            using reference = T&;
+            using pointer = T*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            unrolled_list_iterator() noexcept:
+                current_{},
+                index_{}
+            {}
+
+            unrolled_list_iterator(node_t* node, std::size_t index) noexcept:
+                current_{node},
+                index_{index}
+            {}
+
+            /// the chunk that contains the element
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            /// the position of the element within its chunk
+            [[nodiscard]]
+            std::size_t index() const noexcept {
+                return index_;
+            }
+
+            unrolled_list_iterator& operator++() noexcept {
+                if (++index_ == current_->count_) {
+                    current_ = static_cast<node_t*>(current_->next());
+                    index_ = 0;
+                }
+                return *this;
+            }
+
+            unrolled_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            unrolled_list_iterator& operator--() noexcept {
+                if (index_ == 0) {
+                    current_ = static_cast<node_t*>(current_->prev());
+                    index_ = current_->count_ ? current_->count_ - 1 : 0;
+                } else {
+                    --index_;
+                }
+                return *this;
+            }
+
+            unrolled_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<NodeT*>(current_)->values_[index_];
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(**this);
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const unrolled_list_iterator& lhs, const unrolled_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_ && lhs.index_ == rhs.index_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const unrolled_list_iterator& lhs, const unrolled_list_iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+        };
+
+        template<typename T, typename NodeT>
+        struct const_unrolled_list_iterator {
+            template<typename, typename, std::size_t> friend
+            class ::saxion::unrolled_list;
+
+            // the iterator walks the chunks, NodeT is the concrete chunk type
+            using node_t = unrolled_node_base;
+
+            node_t* current_;
+            std::size_t index_;
+
+            using value_type = T;
+            using reference = T const&;
+            using pointer = T const*;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+            using iterator_concept = iterator_category;
+
+            const_unrolled_list_iterator() noexcept:
+                current_{},
+                index_{}
+            {}
+
+            const_unrolled_list_iterator(node_t* node, std::size_t index) noexcept:
+                current_{node},
+                index_{index}
+            {}
+
+            /// a non-const iterator can always be used where a const one is expected
+            const_unrolled_list_iterator(const unrolled_list_iterator<T, NodeT>& other) noexcept:
+                current_{other.current_},
+                index_{other.index_}
+            {}
+
+            /// the chunk that contains the element
+            [[nodiscard]]
+            node_t* node() const noexcept {
+                return current_;
+            }
+
+            /// the position of the element within its chunk
+            [[nodiscard]]
+            std::size_t index() const noexcept {
+                return index_;
+            }
+
+            const_unrolled_list_iterator& operator++() noexcept {
+                if (++index_ == current_->count_) {
+                    current_ = static_cast<node_t*>(current_->next());
+                    index_ = 0;
+                }
+                return *this;
+            }
+
+            const_unrolled_list_iterator operator++(int) noexcept {
+                auto copy{*this};
+                ++(*this);
+                return copy;
+            }
+
+            const_unrolled_list_iterator& operator--() noexcept {
+                if (index_ == 0) {
+                    current_ = static_cast<node_t*>(current_->prev());
+                    index_ = current_->count_ ? current_->count_ - 1 : 0;
+                } else {
+                    --index_;
+                }
+                return *this;
+            }
+
+            const_unrolled_list_iterator operator--(int) noexcept {
+                auto copy{*this};
+                --(*this);
+                return copy;
+            }
+
+            [[nodiscard]]
+            reference operator*() const noexcept {
+                return static_cast<const NodeT*>(current_)->values_[index_];
+            }
+
+            [[nodiscard]]
+            pointer operator->() const noexcept {
+                return std::addressof(**this);
+            }
+
+            [[nodiscard]]
+            friend bool operator==(const const_unrolled_list_iterator& lhs, const const_unrolled_list_iterator& rhs) noexcept {
+                return lhs.current_ == rhs.current_ && lhs.index_ == rhs.index_;
+            }
+
+            [[nodiscard]]
+            friend bool operator!=(const const_unrolled_list_iterator& lhs, const const_unrolled_list_iterator& rhs) noexcept {
+                return !(lhs == rhs);
+            }
+        };
+
+        template <typename T, typename NodeT>
+        [[nodiscard]]
+        inline bool operator==(const unrolled_list_iterator<T, NodeT>& lhs, const const_unrolled_list_iterator<T, NodeT>& rhs) {
+            return lhs.current_ == rhs.current_ && lhs.index_ == rhs.index_;
+        }
+
+        template <typename T, typename NodeT>
+        [[nodiscard]]
+        inline bool operator!=(const unrolled_list_iterator<T, NodeT>& lhs, const const_unrolled_list_iterator<T, NodeT>& rhs) {
+            return !(lhs == rhs);
+        }
+    }
+
+    /**
+     * @brief Unrolled doubly-linked list
+     *
+     * Every node (chunk) holds up to chunk_capacity() elements in a contiguous array, so iterating touches one
+     * cache line per few elements instead of one per element. A full chunk is split in two halves when an element
+     * is inserted into it; a chunk that is at most half full after an erase is merged with its successor
+     * when they fit together.
+     *
+     * @note Inserting or erasing an element invalidates the iterators to the elements of the affected chunks.
+     *
+     * @tparam T type of the elements
+     * @tparam Allocator allocator used for the elements (rebound to allocate the chunks)
+     * @tparam ChunkBytes approximate size of a chunk in bytes
+     */
+    template<typename T, typename Allocator = std::allocator<T>, std::size_t ChunkBytes = detail::unrolled_chunk_bytes>
+    class unrolled_list {
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using reference = T&;
+        using const_reference = T const&;
+        using pointer = T*;
+        using const_pointer = T const*;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>,
+                      "Allocator::value_type must be the same as the value_type of the list");
+
+        /// maximum number of elements in a chunk
+        static constexpr size_type chunk_capacity = detail::unrolled_capacity<T>(ChunkBytes);
+
+    private:
+        using node_base_t = detail::unrolled_node_base;
+        using node_t = detail::unrolled_node<T, chunk_capacity>;
+
+        using alloc_traits = std::allocator_traits<Allocator>;
+        using node_allocator_type = typename alloc_traits::template rebind_alloc<node_t>;
+        using node_alloc_traits = std::allocator_traits<node_allocator_type>;
+
+        static_assert(std::is_same_v<typename node_alloc_traits::pointer, node_t*>,
+                      "Allocators with fancy pointers are not supported");
+
+        /// a chunk with at most this number of elements is merged with the next one if possible
+        static constexpr size_type merge_threshold = chunk_capacity / 2;
+
+        [[no_unique_address]]
+        node_allocator_type alloc_;
+
+        node_base_t node_{};
+        size_type size_{};
+        size_type chunks_{};
+
+    public:
+        using iterator = detail::unrolled_list_iterator<T, node_t>;
+        using const_iterator = detail::const_unrolled_list_iterator<T, node_t>;
+
+    private:
+        [[nodiscard]]
+        static node_t* chunk(detail::list_node_base* node) noexcept {
+            return static_cast<node_t*>(node);
+        }
+
+        [[nodiscard]]
+        bool is_sentinel(const detail::list_node_base* node) const noexcept {
+            return node == &node_;
+        }
+
+        [[nodiscard]]
+        allocator_type value_allocator() const noexcept {
+            return allocator_type(alloc_);
+        }
+
+        template<typename... Args>
+        void construct_value(T* where, Args&&... args) {
+            auto value_alloc = value_allocator();
+            alloc_traits::construct(value_alloc, where, std::forward<Args>(args)...);
+        }
+
+        void destroy_value(T* where) noexcept {
+            auto value_alloc = value_allocator();
+            alloc_traits::destroy(value_alloc, where);
+        }
+
+        /// allocates an empty chunk and links it before pos
+        node_t* create_chunk(detail::list_node_base* pos) {
+            auto node = node_alloc_traits::allocate(alloc_, 1);
+            node_alloc_traits::construct(alloc_, node);
+            node->hook_before(pos);
+            ++chunks_;
+            return node;
+        }
+
+        /// unlinks and frees a chunk, its elements must be already destroyed or moved out
+        void destroy_chunk(node_t* node) noexcept {
+            node->unhook();
+            node_alloc_traits::destroy(alloc_, node);
+            node_alloc_traits::deallocate(alloc_, node, 1);
+            --chunks_;
+        }
+
+        /**
+         * @brief Moves the elements [from, count) of a chunk to the end of another chunk
+         */
+        void move_elements(node_t* source, size_type from, node_t* target) {
+            for (auto ind = from; ind < source->count_; ++ind) {
+                construct_value(target->slot(target->count_), std::move_if_noexcept(source->values_[ind]));
+                ++target->count_;
+            }
+            for (auto ind = from; ind < source->count_; ++ind) {
+                destroy_value(source->slot(ind));
+            }
+            source->count_ = from;
+        }
+
+        /**
+         * @brief Constructs an element at the given index of a chunk that isn't full
+         *
+         * @return pointer to the new element
+         */
+        template<typename... Args>
+        T* emplace_in_chunk(node_t* node, size_type index, Args&&... args) {
+            if (index == node->count_) {
+                construct_value(node->slot(index), std::forward<Args>(args)...);
+            } else {
+                // build the value first, so a throwing constructor leaves the chunk untouched
+                T value(std::forward<Args>(args)...);
+                construct_value(node->slot(node->count_), std::move(node->values_[node->count_ - 1]));
+                try {
+                    std::move_backward(node->slot(index), node->slot(node->count_ - 1), node->slot(node->count_));
+                    node->values_[index] = std::move(value);
+                } catch (...) {
+                    destroy_value(node->slot(node->count_));
+                    throw;
+                }
+            }
+            ++node->count_;
+            ++size_;
+            return node->slot(index);
+        }
+
+        /**
+         * @brief Finds room for a new element at the given position, splitting a full chunk if needed
+         *
+         * @return the chunk and index where the new element must be constructed
+         */
+        std::pair<node_t*, size_type> make_room(detail::list_node_base* node, size_type index) {
+            if (is_sentinel(node)) {
+                // appending: use the last chunk if it has room
+                if (!is_sentinel(node_.prev()) && !chunk(node_.prev())->full()) {
+                    return {chunk(node_.prev()), chunk(node_.prev())->count_};
+                }
+                return {create_chunk(&node_), 0};
+            }
+
+            auto current = chunk(node);
+            if (index == 0 && !is_sentinel(current->prev()) && !chunk(current->prev())->full()) {
+                // inserting before the first element of a chunk: append to the previous chunk instead
+                return {chunk(current->prev()), chunk(current->prev())->count_};
+            }
+            if (!current->full()) {
+                return {current, index};
+            }
+
+            // split the full chunk, the upper half goes to a new chunk after it
+            auto upper = create_chunk(current->next());
+            auto half = chunk_capacity / 2;
+            try {
+                move_elements(current, half, upper);
+            } catch (...) {
+                // only a throwing copy gets here, so the full chunk still holds every element
+                for (size_type ind = 0; ind < upper->count_; ++ind) {
+                    destroy_value(upper->slot(ind));
+                }
+                destroy_chunk(upper);
+                throw;
+            }
+            if (index <= half) {
+                return {current, index};
+            }
+            return {upper, index - half};
+        }
+
+        template<typename... Args>
+        iterator emplace_at(detail::list_node_base* node, size_type index, Args&&... args) {
+            auto [target, target_index] = make_room(node, index);
+            try {
+                emplace_in_chunk(target, target_index, std::forward<Args>(args)...);
+            } catch (...) {
+                if (target->count_ == 0) {
+                    destroy_chunk(target);
+                }
+                throw;
+            }
+            return iterator(target, target_index);
+        }
+
+        /// true if a chunk with the given number of elements should be merged with a neighbour
+        [[nodiscard]]
+        static bool can_merge(const node_t* node, const detail::list_node_base* neighbour, bool neighbour_is_sentinel) noexcept {
+            return node->count_ <= merge_threshold && !neighbour_is_sentinel &&
+                   node->count_ + static_cast<const node_t*>(neighbour)->count_ <= chunk_capacity;
+        }
+
+        /**
+         * @brief Merges a chunk that got at most half full with one of its neighbours, if they fit in one chunk
+         *
+         * @param node chunk an element was erased from
+         * @param index index of the element that followed the erased one
+         * @return iterator to the element that followed the erased one
+         */
+        iterator merge_after_erase(node_t* node, size_type index) {
+            if (can_merge(node, node->next(), is_sentinel(node->next()))) {
+                auto next = chunk(node->next());
+                move_elements(next, 0, node);
+                destroy_chunk(next);
+            } else if (can_merge(node, node->prev(), is_sentinel(node->prev()))) {
+                auto prev = chunk(node->prev());
+                auto offset = prev->count_;
+                auto at_end = index == node->count_;
+                move_elements(node, 0, prev);
+                auto next = static_cast<node_base_t*>(node->next());
+                destroy_chunk(node);
+                return at_end ? iterator(next, 0) : iterator(prev, offset + index);
+            }
+
+            if (index == node->count_) {
+                return iterator(static_cast<node_base_t*>(node->next()), 0);
+            }
+            return iterator(node, index);
+        }
+
+        template<typename Iter>
+        void append_range(Iter first, Iter last) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+    public:
+
+        /**
+         * @brief Construct a new, empty list
+         */
+        unrolled_list() noexcept(noexcept(Allocator())) :
+                unrolled_list(Allocator())
+        {}
+
+        /**
+         * @brief Construct a new, empty list using the given allocator
+         *
+         * @param alloc allocator used for the chunks
+         */
+        explicit unrolled_list(const Allocator& alloc) noexcept :
+                alloc_(alloc) {
+            node_.reset();
+        }
+
+        /**
+         * @brief Construct a new list from an initializer list
+         *
+         * @param init_list initializer list
+         * @param alloc allocator used for the chunks
+         */
+        unrolled_list(std::initializer_list<T> init_list, const Allocator& alloc = Allocator()) :
+                unrolled_list(alloc) {
+            append_range(init_list.begin(), init_list.end());
+        }
+
+        /**
+         * @brief Construct a new list from a range
+         *
+         * @param first begin of the range
+         * @param last end of the range
+         * @param alloc allocator used for the chunks
+         */
+        template<typename _Iter, typename = std::enable_if_t<
+                std::is_convertible_v<typename std::iterator_traits<_Iter>::iterator_category, std::input_iterator_tag>>>
+        unrolled_list(_Iter first, _Iter last, const Allocator& alloc = Allocator()) :
+                unrolled_list(alloc) {
+            append_range(first, last);
+        }
+
+        /**
+         * @brief Copy constructor
+         *
+         * @param other list to copy
+         */
+        unrolled_list(const unrolled_list& other) :
+                unrolled_list(alloc_traits::select_on_container_copy_construction(other.get_allocator())) {
+            append_range(other.begin(), other.end());
+        }
+
+        /**
+         * @brief Move constructor
+         *
+         * @param other list to move from
+         */
+        unrolled_list(unrolled_list&& other) noexcept :
+                unrolled_list(other.get_allocator()) {
+            swap_chains(other);
+        }
+
+        /**
+         * @brief Copy assignment operator
+         *
+         * @param other list to copy
+         * @return reference to self
+         */
+        unrolled_list& operator=(const unrolled_list& other) {
+            if (this != &other) {
+                clear();
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                    alloc_ = other.alloc_;
+                }
+                append_range(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Move assignment operator
+         *
+         * @param other list to move from
+         * @return reference to self
+         */
+        unrolled_list& operator=(unrolled_list&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                                 alloc_traits::is_always_equal::value) {
+            if (this != &other) {
+                clear();
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                    alloc_ = other.alloc_;
+                    swap_chains(other);
+                } else if (alloc_ == other.alloc_) {
+                    swap_chains(other);
+                } else {
+                    for (auto& el : other) {
+                        emplace_back(std::move(el));
+                    }
+                    other.clear();
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the list
+         */
+        ~unrolled_list() noexcept {
+            clear();
+        }
+
+        [[nodiscard]]
+        allocator_type get_allocator() const noexcept {
+            return value_allocator();
+        }
+
+        [[nodiscard]]
+        iterator begin() noexcept {
+            return iterator(static_cast<node_base_t*>(node_.next()), 0);
+        }
+
+        [[nodiscard]]
+        iterator end() noexcept {
+            return iterator(&node_, 0);
+        }
+
+        [[nodiscard]]
+        const_iterator begin() const noexcept {
+            return const_iterator(static_cast<node_base_t*>(node_.next()), 0);
+        }
+
+        [[nodiscard]]
+        const_iterator end() const noexcept {
+            return const_iterator(const_cast<node_base_t*>(&node_), 0);
+        }
+
+        [[nodiscard]]
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        [[nodiscard]]
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        [[nodiscard]]
+        reference front() {
+            return chunk(node_.next())->values_[0];
+        }
+
+        [[nodiscard]]
+        const_reference front() const {
+            return chunk(node_.next())->values_[0];
+        }
+
+        [[nodiscard]]
+        reference back() {
+            auto last = chunk(node_.prev());
+            return last->values_[last->count_ - 1];
+        }
+
+        [[nodiscard]]
+        const_reference back() const {
+            auto last = chunk(node_.prev());
+            return last->values_[last->count_ - 1];
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        [[nodiscard]]
+        size_type size() const noexcept {
+            return size_;
+        }
+
+        /**
+         * @brief Returns the number of chunks in use
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type chunk_count() const noexcept {
+            return chunks_;
+        }
+
+        /**
+         * @brief Emplaces an element before the given position
+         *
+         * @param pos position to insert before
+         * @param args arguments passed to the constructor of the element
+         * @return iterator to the new element
+         */
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args) {
+            return emplace_at(pos.current_, pos.index_, std::forward<Args>(args)...);
+        }
+
+        iterator insert(const_iterator pos, const_reference value) {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value) {
+            return emplace(pos, std::move(value));
+        }
+
+        template<typename... Args>
+        reference emplace_back(Args&&... args) {
+            return *emplace_at(&node_, 0, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        reference emplace_front(Args&&... args) {
+            return *emplace_at(node_.next(), 0, std::forward<Args>(args)...);
+        }
+
+        void push_back(const_reference value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const_reference value) {
+            emplace_front(value);
+        }
+
+        void push_front(T&& value) {
+            emplace_front(std::move(value));
+        }
+
+        /**
+         * @brief Erases the element at the given position
+         *
+         * @param pos position of the element to erase
+         * @return iterator to the element after the erased one
+         */
+        iterator erase(const_iterator pos) {
+            auto node = chunk(pos.current_);
+            auto index = pos.index_;
+
+            std::move(node->slot(index + 1), node->slot(node->count_), node->slot(index));
+            destroy_value(node->slot(node->count_ - 1));
+            --node->count_;
+            --size_;
+
+            if (node->count_ == 0) {
+                auto next = static_cast<node_base_t*>(node->next());
+                destroy_chunk(node);
+                return iterator(next, 0);
+            }
+
+            return merge_after_erase(node, index);
+        }
+
+        void pop_front() {
+            if (!empty()) {
+                erase(begin());
+            }
+        }
+
+        void pop_back() {
+            if (!empty()) {
+                erase(--end());
+            }
+        }
+
+        /**
+         * @brief Erases all the elements
+         */
+        void clear() noexcept {
+            auto current = node_.next();
+            while (!is_sentinel(current)) {
+                auto node = chunk(current);
+                current = current->next();
+                for (size_type ind = 0; ind < node->count_; ++ind) {
+                    destroy_value(node->slot(ind));
+                }
+                node_alloc_traits::destroy(alloc_, node);
+                node_alloc_traits::deallocate(alloc_, node, 1);
+            }
+            node_.reset();
+            size_ = 0;
+            chunks_ = 0;
+        }
+
+        /**
+         * @brief Swaps the contents of two lists
+         *
+         * @param other list to swap with
+         */
+        void swap(unrolled_list& other) noexcept {
+            if constexpr (alloc_traits::propagate_on_container_swap::value) {
+                using std::swap;
+                swap(alloc_, other.alloc_);
+            }
+            swap_chains(other);
+        }
+
+    private:
+        void swap_chains(unrolled_list& other) noexcept {
+            std::swap(node_.prev_, other.node_.prev_);
+            std::swap(node_.next_, other.node_.next_);
+            std::swap(size_, other.size_);
+            std::swap(chunks_, other.chunks_);
+            for (auto list : {this, &other}) {
+                if (list->chunks_ == 0) {
+                    list->node_.reset();
+                } else {
+                    list->node_.next_->prev_ = &list->node_;
+                    list->node_.prev_->next_ = &list->node_;
+                }
+            }
+        }
+    };
+
+    /// Deduction guide for iterator arguments
+    template<typename _Iter, typename _Alloc = std::allocator<typename std::iterator_traits<_Iter>::value_type>>
+    unrolled_list(_Iter b, _Iter e, _Alloc = _Alloc()) -> unrolled_list<typename std::iterator_traits<_Iter>::value_type, _Alloc>;
+
+    namespace pmr {
+        /// saxion::unrolled_list using a polymorphic allocator
+        template<typename T>
+        using unrolled_list = saxion::unrolled_list<T, std::pmr::polymorphic_allocator<T>>;
+    }
+}
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef INCLUDE_WORK_STEALING_DEQUE_H
+#define INCLUDE_WORK_STEALING_DEQUE_H
+
+/**
+ * @file work_stealing_deque.h
+ * @brief Work-stealing deque of list nodes (THE protocol)
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "list.h"
+
+namespace saxion {
+
+    /**
+     * @brief Deque of tasks of one worker: the owner works at the back, other threads steal from the front
+     *
+     * The elements are saxion::list nodes, chained from a dummy node (the last node taken from the front) to the
+     * back node. Element i lives in the i-th node after the first dummy; head and tail are the indices of the
+     * front element and one past the back one.
+     *
+     * Synchronization follows the THE protocol of Cilk-5: the owner claims the back element by decrementing
+     * tail, a thief claims front elements by incrementing head, and each re-reads the other index after a
+     * full fence. Only when they may have claimed the same element does the owner take the lock that thieves
+     * always hold, so push_back() and pop_back() are lock-free and don't contend with each other unless the
+     * deque is about to run empty.
+     *
+     * steal_half() moves half of the elements to the deque of the thief by cutting the node chain: the stolen
+     * nodes are relinked, only one value is moved (into the old dummy, as the last stolen node stays behind as
+     * the new dummy).
+     *
+     * Nodes are recycled: the owner keeps the nodes it pops, thieves hand back the dummies they replace.
+     *
+     * @tparam T type of the elements, must be nothrow move constructible
+     */
+    template<typename T>
+    class work_stealing_deque {
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+
+        static_assert(std::is_nothrow_move_constructible_v<T>, "stealing moves elements between nodes");
+
+    private:
+        using node_base_t = detail::list_node_base;
+        using node_t = detail::list_node<T>;
+        using index_t = std::ptrdiff_t;
+
+        // owner side
+        alignas(64) std::atomic<index_t> tail_{0};
+        node_base_t* back_{};
+        /// nodes popped by the owner, linked through next_
+        node_base_t* cache_{};
+
+        // thief side
+        alignas(64) std::mutex mutex_{};
+        std::atomic<index_t> head_{0};
+        node_base_t* dummy_{};
+        /// nodes given back by the thieves, taken by the owner all at once
+        std::atomic<node_base_t*> spare_{};
+
+        [[nodiscard]]
+        static node_t* value_node(node_base_t* node) noexcept {
+            return static_cast<node_t*>(node);
+        }
+
+        [[nodiscard]]
+        static node_base_t* next_of(node_base_t* node) noexcept {
+            return std::atomic_ref<node_base_t*>(node->next_).load(std::memory_order_acquire);
+        }
+
+        /// storage for a node, the value is not constructed
+        [[nodiscard]]
+        node_t* allocate_node() {
+            if (!cache_) {
+                cache_ = spare_.exchange(nullptr, std::memory_order_acquire);
+            }
+            if (cache_) {
+                return value_node(std::exchange(cache_, cache_->next_));
+            }
+            return new node_t;
+        }
+
+        void recycle(node_base_t* node) noexcept {
+            node->next_ = cache_;
+            cache_ = node;
+        }
+
+        /// gives a node back to the owner, called by thieves
+        void give_back(node_base_t* node) noexcept {
+            auto top = spare_.load(std::memory_order_relaxed);
+            do {
+                node->next_ = top;
+            } while (!spare_.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /// links the chain [first, last] of n nodes after the back, called by the owner
+        void link_back(node_base_t* first, node_base_t* last, index_t n) noexcept {
+            first->prev_ = back_;
+            last->next_ = nullptr;
+            std::atomic_ref<node_base_t*>(back_->next_).store(first, std::memory_order_release);
+            back_ = last;
+            tail_.store(tail_.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        /**
+         * @brief Claims up to the requested number of elements at the front, the lock must be held
+         *
+         * @param amount number of elements to claim, given the number of elements available
+         * @return number of elements claimed, the nodes after dummy_
+         */
+        template<typename Amount>
+        index_t claim_front(Amount amount) noexcept {
+            auto head = head_.load(std::memory_order_relaxed);
+            while (true) {
+                auto available = tail_.load(std::memory_order_acquire) - head;
+                if (available <= 0) {
+                    return 0;
+                }
+                auto n = amount(available);
+                head_.store(head + n, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (head + n <= tail_.load(std::memory_order_acquire)) {
+                    return n;
+                }
+                // the owner popped some of them meanwhile, try again with what is left
+                head_.store(head, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+
+        /**
+         * @brief Construct a new, empty deque
+         */
+        work_stealing_deque() :
+            back_{new node_t} {
+            dummy_ = back_;
+        }
+
+        // the owner and the thieves refer to the deque
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+        /**
+         * @brief Destroy the deque, no other thread may be using it anymore
+         */
+        ~work_stealing_deque() {
+            auto count = tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+            auto node = dummy_->next_;
+            delete value_node(dummy_);
+            for (; count > 0; --count) {
+                std::destroy_at(std::addressof(value_node(node)->value_));
+                delete value_node(std::exchange(node, node->next_));
+            }
+            for (auto chain : {cache_, spare_.load(std::memory_order_relaxed)}) {
+                while (chain) {
+                    delete value_node(std::exchange(chain, chain->next_));
+                }
+            }
+        }
+
+        /**
+         * @brief Adds an element at the back, only the owner may call this
+         *
+         * @param args arguments passed to the constructor of the element
+         */
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            auto node = allocate_node();
+            try {
+                std::construct_at(std::addressof(node->value_), std::forward<Args>(args)...);
+            } catch (...) {
+                recycle(node);
+                throw;
+            }
+            link_back(node, node, 1);
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * @brief Removes the element at the back, only the owner may call this
+         *
+         * @return the element, or an empty optional if the deque is empty
+         */
+        std::optional<T> pop_back() {
+            if (head_.load(std::memory_order_relaxed) >= tail_.load(std::memory_order_relaxed)) {
+                // head may be the claim of a thief that is about to roll it back (see claim_front), it is only
+                // final under the lock; once empty, the deque stays empty until the owner pushes again
+                std::lock_guard lock{mutex_};
+                if (head_.load(std::memory_order_relaxed) >= tail_.load(std::memory_order_relaxed)) {
+                    return std::nullopt;
+                }
+            }
+            auto tail = tail_.load(std::memory_order_relaxed) - 1;
+            tail_.store(tail, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (head_.load(std::memory_order_relaxed) > tail) {
+                // a thief may be taking the same element, wait until it is done
+                std::lock_guard lock{mutex_};
+                if (head_.load(std::memory_order_relaxed) > tail) {
+                    tail_.store(tail + 1, std::memory_order_relaxed);
+                    return std::nullopt;
+                }
+            }
+            auto node = back_;
+            back_ = node->prev_;
+            std::optional<T> value{std::move(value_node(node)->value_)};
+            std::destroy_at(std::addressof(value_node(node)->value_));
+            recycle(node);
+            return value;
+        }
+
+        /**
+         * @brief Removes the element at the front, any thread may call this
+         *
+         * @return the element, or an empty optional if the deque is empty
+         */
+        std::optional<T> steal() {
+            std::unique_lock lock{mutex_};
+            if (claim_front([](index_t) { return index_t{1}; }) == 0) {
+                return std::nullopt;
+            }
+            auto old_dummy = std::exchange(dummy_, next_of(dummy_));
+            std::optional<T> value{std::move(value_node(dummy_)->value_)};
+            std::destroy_at(std::addressof(value_node(dummy_)->value_));
+            lock.unlock();
+            give_back(old_dummy);
+            return value;
+        }
+
+        /**
+         * @brief Moves the front half of the elements (at least one) to the back of another deque
+         *
+         * @param into deque owned by the calling thread
+         * @return number of elements moved
+         */
+        size_type steal_half(work_stealing_deque& into) {
+            node_base_t* first;
+            node_base_t* last;
+            index_t n;
+            {
+                std::lock_guard lock{mutex_};
+                n = claim_front([](index_t available) { return std::max<index_t>(1, available / 2); });
+                if (n == 0) {
+                    return 0;
+                }
+                // the n-th node becomes the dummy, its value moves into the old dummy at the end of the chain
+                first = next_of(dummy_);
+                last = dummy_;
+                auto new_dummy = first;
+                for (index_t i = 1; i < n; ++i) {
+                    new_dummy = next_of(new_dummy);
+                }
+                std::construct_at(std::addressof(value_node(last)->value_), std::move(value_node(new_dummy)->value_));
+                std::destroy_at(std::addressof(value_node(new_dummy)->value_));
+                if (n == 1) {
+                    first = last;
+                } else {
+                    new_dummy->prev_->next_ = last;
+                    last->prev_ = new_dummy->prev_;
+                }
+                dummy_ = new_dummy;
+            }
+            into.link_back(first, last, n);
+            return static_cast<size_type>(n);
+        }
+
+        /**
+         * @brief Number of elements, exact only when no other thread is using the deque
+         *
+         * @return size_type
+         */
+        [[nodiscard]]
+        size_type size() const noexcept {
+            auto size = tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+            return static_cast<size_type>(std::max<index_t>(0, size));
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,319 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "async_channel.h"
+
+namespace {
+
+    using saxion::detached_task;
+
+    detached_task produce(saxion::async_channel<int>& channel, int first, int count, std::vector<bool>* results = nullptr) {
+        for (int i = first; i < first + count; ++i) {
+            bool pushed = co_await channel.push(i);
+            if (results) {
+                results->push_back(pushed);
+            }
+        }
+    }
+
+    detached_task consume(saxion::async_channel<int>& channel, std::vector<int>& out) {
+        while (auto value = co_await channel.pop()) {
+            out.push_back(*value);
+        }
+    }
+
+    TEST(async_channel, unbounded) {
+        saxion::manual_executor exec;
+        saxion::async_channel<int> channel(exec);
+        ASSERT_EQ(channel.capacity(), saxion::async_channel<int>::unbounded);
+
+        spawn(exec, produce(channel, 0, 5));
+        exec.run();
+        ASSERT_EQ(channel.size(), 5) << "An unbounded channel should never suspend a producer";
+
+        std::vector<int> out;
+        spawn(exec, consume(channel, out));
+        exec.run();
+        ASSERT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+        ASSERT_EQ(channel.size(), 0);
+
+        // the consumer is suspended on the empty channel now and gets the next element directly
+        spawn(exec, produce(channel, 5, 1));
+        exec.run();
+        ASSERT_EQ(out.back(), 5);
+        ASSERT_EQ(channel.size(), 0);
+
+        channel.close();
+        ASSERT_TRUE(channel.closed());
+        ASSERT_EQ(exec.run(), 1) << "Closing should wake the waiting consumer";
+    }
+
+    TEST(async_channel, backpressure) {
+        saxion::manual_executor exec;
+        saxion::async_channel<int> channel(exec, 2);
+        std::vector<bool> results;
+
+        spawn(exec, produce(channel, 0, 5, &results));
+        exec.run();
+        ASSERT_EQ(channel.size(), 2);
+        ASSERT_EQ(results.size(), 2) << "The third push should wait for room";
+
+        std::vector<int> out;
+        spawn(exec, consume(channel, out));
+        exec.run();
+        ASSERT_EQ(out, (std::vector<int>{0, 1, 2, 3, 4}));
+        ASSERT_EQ(results, std::vector<bool>(5, true));
+
+        // let the consumer finish
+        channel.close();
+        exec.run();
+    }
+
+    TEST(async_channel, unbuffered) {
+        saxion::manual_executor exec;
+        saxion::async_channel<int> channel(exec, 0);
+        std::vector<bool> results;
+
+        spawn(exec, produce(channel, 0, 3, &results));
+        exec.run();
+        ASSERT_EQ(channel.size(), 0);
+        ASSERT_TRUE(results.empty()) << "A push to an unbuffered channel should wait for a consumer";
+
+        std::vector<int> out;
+        spawn(exec, consume(channel, out));
+        exec.run();
+        ASSERT_EQ(out, (std::vector<int>{0, 1, 2}));
+        ASSERT_EQ(results, std::vector<bool>(3, true));
+
+        // let the consumer finish
+        channel.close();
+        exec.run();
+    }
+
+    TEST(async_channel, close) {
+        saxion::manual_executor exec;
+        saxion::async_channel<int> channel(exec, 1);
+        std::vector<bool> results;
+
+        spawn(exec, produce(channel, 0, 3, &results));
+        exec.run();
+        channel.close();
+        exec.run();
+        ASSERT_EQ(results, (std::vector<bool>{true, false, false})) << "Waiting and later pushes should fail";
+
+        std::vector<int> out;
+        spawn(exec, consume(channel, out));
+        exec.run();
+        ASSERT_EQ(out, std::vector<int>{0}) << "The buffered elements should still be popped";
+    }
+
+    TEST(async_channel, pop_batch) {
+        saxion::manual_executor exec;
+        saxion::async_channel<std::string> channel(exec, 3);
+        std::vector<std::size_t> counts;
+        saxion::list<std::string> received;
+
+        spawn(exec, [](saxion::async_channel<std::string>& ch) -> detached_task {
+            for (int i = 0; i < 8; ++i) {
+                co_await ch.push(std::to_string(i));
+            }
+            ch.close();
+        }(channel));
+        exec.run();
+
+        spawn(exec, [](saxion::async_channel<std::string>& ch, saxion::list<std::string>& out,
+                       std::vector<std::size_t>& counts) -> detached_task {
+            while (auto n = co_await ch.pop_batch(out, 4)) {
+                counts.push_back(n);
+            }
+        }(channel, received, counts));
+        exec.run();
+
+        ASSERT_EQ(std::vector<std::string>(received.begin(), received.end()),
+                  (std::vector<std::string>{"0", "1", "2", "3", "4", "5", "6", "7"}));
+        ASSERT_EQ(counts.front(), 4) << "A batch should also take the elements of the waiting producers";
+        std::size_t total = 0;
+        for (auto n : counts) {
+            total += n;
+        }
+        ASSERT_EQ(total, 8);
+    }
+
+    TEST(async_channel, move_only) {
+        saxion::manual_executor exec;
+        saxion::async_channel<std::unique_ptr<int>> channel(exec, 0);
+        std::unique_ptr<int> received;
+
+        spawn(exec, [](saxion::async_channel<std::unique_ptr<int>>& ch, std::unique_ptr<int>& out) -> detached_task {
+            out = *co_await ch.pop();
+        }(channel, received));
+        spawn(exec, [](saxion::async_channel<std::unique_ptr<int>>& ch) -> detached_task {
+            co_await ch.push(std::make_unique<int>(42));
+        }(channel));
+        exec.run();
+        ASSERT_TRUE(received);
+        ASSERT_EQ(*received, 42);
+    }
+
+    /// allocator that throws while *fail is set
+    template<typename T>
+    struct failing_allocator {
+        using value_type = T;
+
+        bool* fail;
+
+        explicit failing_allocator(bool* fail) noexcept : fail{fail} {}
+
+        template<typename U>
+        failing_allocator(const failing_allocator<U>& other) noexcept : fail{other.fail} {}
+
+        T* allocate(std::size_t n) {
+            if (*fail) {
+                throw std::bad_alloc();
+            }
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        friend bool operator==(const failing_allocator& lhs, const failing_allocator& rhs) noexcept {
+            return lhs.fail == rhs.fail;
+        }
+    };
+
+    using failing_channel = saxion::async_channel<int, failing_allocator<int>>;
+
+    detached_task push_catching(failing_channel& channel, int value, std::vector<bool>& results, bool& failed) {
+        try {
+            results.push_back(co_await channel.push(value));
+        } catch (const std::bad_alloc&) {
+            failed = true;
+        }
+    }
+
+    detached_task pop_batch_catching(failing_channel& channel, failing_channel::list_type& out, bool& failed) {
+        try {
+            while (co_await channel.pop_batch(out, 4)) {
+            }
+        } catch (const std::bad_alloc&) {
+            failed = true;
+        }
+    }
+
+    TEST(async_channel, failed_delivery_to_waiting_consumer) {
+        saxion::manual_executor exec;
+        bool never = false;
+        bool out_full = true;
+        failing_channel channel(exec, failing_channel::unbounded, failing_allocator<int>{&never});
+        failing_channel::list_type out(failing_allocator<int>{&out_full});
+        bool consumer_failed = false;
+
+        spawn(exec, pop_batch_catching(channel, out, consumer_failed));
+        exec.run();
+
+        std::vector<bool> results;
+        bool producer_failed = false;
+        spawn(exec, push_catching(channel, 1, results, producer_failed));
+        exec.run();
+        ASSERT_TRUE(producer_failed) << "The producer should get the exception of the failed delivery";
+        ASSERT_TRUE(out.empty());
+
+        out_full = false;
+        spawn(exec, push_catching(channel, 2, results, producer_failed));
+        exec.run();
+        ASSERT_EQ(results, std::vector<bool>{true});
+        ASSERT_EQ(std::vector<int>(out.begin(), out.end()), std::vector<int>{2})
+                                    << "The consumer should still be waiting after a failed delivery";
+
+        channel.close();
+        ASSERT_EQ(exec.run(), 1) << "Closing should wake the consumer";
+        ASSERT_FALSE(consumer_failed);
+    }
+
+    TEST(async_channel, failed_delivery_from_waiting_producer) {
+        saxion::manual_executor exec;
+        bool never = false;
+        bool out_full = true;
+        failing_channel channel(exec, 0, failing_allocator<int>{&never});
+        failing_channel::list_type out(failing_allocator<int>{&out_full});
+
+        std::vector<bool> results;
+        bool producer_failed = false;
+        spawn(exec, push_catching(channel, 7, results, producer_failed));
+        exec.run();
+        ASSERT_TRUE(results.empty());
+
+        bool consumer_failed = false;
+        spawn(exec, pop_batch_catching(channel, out, consumer_failed));
+        exec.run();
+        ASSERT_TRUE(consumer_failed) << "The consumer should get the exception of the failed delivery";
+        ASSERT_TRUE(results.empty()) << "The producer should keep waiting with its element";
+
+        out_full = false;
+        consumer_failed = false;
+        spawn(exec, pop_batch_catching(channel, out, consumer_failed));
+        exec.run();
+        ASSERT_EQ(std::vector<int>(out.begin(), out.end()), std::vector<int>{7});
+        ASSERT_EQ(results, std::vector<bool>{true});
+
+        channel.close();
+        exec.run();
+        ASSERT_FALSE(consumer_failed);
+        ASSERT_FALSE(producer_failed);
+    }
+
+    TEST(async_channel, thread_pool) {
+        constexpr int producers = 4;
+        constexpr int consumers = 4;
+        constexpr int per_producer = 10000;
+
+        std::atomic<long> sum{};
+        std::atomic<int> received{};
+        std::atomic<int> finished_producers{};
+        std::atomic<int> finished_consumers{};
+        {
+            saxion::thread_pool_executor exec(4);
+            saxion::async_channel<int> channel(exec, 16);
+
+            for (int c = 0; c < consumers; ++c) {
+                spawn(exec, [](saxion::async_channel<int>& ch, std::atomic<long>& sum, std::atomic<int>& received,
+                               std::atomic<int>& finished) -> detached_task {
+                    while (auto value = co_await ch.pop()) {
+                        sum += *value;
+                        ++received;
+                    }
+                    ++finished;
+                    finished.notify_one();
+                }(channel, sum, received, finished_consumers));
+            }
+            for (int p = 0; p < producers; ++p) {
+                spawn(exec, [](saxion::async_channel<int>& ch, int first, std::atomic<int>& finished) -> detached_task {
+                    for (int i = first; i < first + per_producer; ++i) {
+                        co_await ch.push(i);
+                    }
+                    ++finished;
+                    finished.notify_one();
+                }(channel, p * per_producer, finished_producers));
+            }
+
+            for (int n = finished_producers; n != producers; n = finished_producers) {
+                finished_producers.wait(n);
+            }
+            channel.close();
+            for (int n = finished_consumers; n != consumers; n = finished_consumers) {
+                finished_consumers.wait(n);
+            }
+        }
+        constexpr long total = producers * per_producer;
+        ASSERT_EQ(received, total);
+        ASSERT_EQ(sum, total * (total - 1) / 2);
+    }
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "concurrent_ordered_list.h"
+
+namespace {
+
+    constexpr int n_threads = 4;
+
+    template<typename Set>
+    std::vector<typename Set::value_type> to_vector(const Set& set) {
+        std::vector<typename Set::value_type> result;
+        set.for_each([&result](const auto& value) { result.push_back(value); });
+        return result;
+    }
+
+    /// counts its live instances, to check the reclamation
+    struct tracked {
+        static inline std::atomic<int> alive{};
+
+        int value;
+
+        tracked(int v) : value{v} { ++alive; }
+        tracked(const tracked& other) : value{other.value} { ++alive; }
+        ~tracked() { --alive; }
+
+        friend bool operator<(const tracked& lhs, const tracked& rhs) {
+            return lhs.value < rhs.value;
+        }
+    };
+
+    TEST(concurrent_ordered_list, single_thread) {
+        saxion::concurrent_ordered_list<int> set;
+        ASSERT_TRUE(set.empty());
+
+        ASSERT_TRUE(set.insert(5));
+        ASSERT_TRUE(set.insert(1));
+        ASSERT_TRUE(set.insert(3));
+        ASSERT_FALSE(set.insert(3)) << "A set shouldn't contain duplicates";
+        ASSERT_EQ(set.size(), 3);
+        ASSERT_EQ(to_vector(set), (std::vector<int>{1, 3, 5}));
+
+        ASSERT_TRUE(set.contains(3));
+        ASSERT_FALSE(set.contains(4));
+        ASSERT_TRUE(set.erase(3));
+        ASSERT_FALSE(set.erase(3));
+        ASSERT_FALSE(set.contains(3));
+        ASSERT_EQ(to_vector(set), (std::vector<int>{1, 5}));
+    }
+
+    TEST(concurrent_ordered_list, custom_order) {
+        saxion::concurrent_ordered_list<int, std::greater<>> set;
+        for (int v : {2, 9, 4}) {
+            set.insert(v);
+        }
+        ASSERT_EQ(to_vector(set), (std::vector<int>{9, 4, 2}));
+    }
+
+    TEST(concurrent_ordered_list, disjoint_keys_stress) {
+        saxion::concurrent_ordered_list<int> set;
+        constexpr int per_thread = 2000;
+
+        // every thread owns the keys k with k % n_threads == id, so the final content is known
+        std::vector<std::thread> threads;
+        for (int id = 0; id < n_threads; ++id) {
+            threads.emplace_back([&set, id] {
+                for (int i = 0; i < per_thread; ++i) {
+                    EXPECT_TRUE(set.insert(i * n_threads + id));
+                }
+                for (int i = 0; i < per_thread; i += 2) {
+                    EXPECT_TRUE(set.erase(i * n_threads + id));
+                }
+                for (int i = 0; i < per_thread; ++i) {
+                    EXPECT_EQ(set.contains(i * n_threads + id), i % 2 == 1);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        auto values = to_vector(set);
+        ASSERT_EQ(values.size(), n_threads * per_thread / 2);
+        ASSERT_EQ(set.size(), values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            ASSERT_EQ(values[i] / n_threads % 2, 1);
+            if (i > 0) {
+                ASSERT_LT(values[i - 1], values[i]);
+            }
+        }
+    }
+
+    TEST(concurrent_ordered_list, contended_keys_stress) {
+        saxion::concurrent_ordered_list<int> set;
+        std::atomic<long> inserted{0};
+        std::atomic<long> erased{0};
+
+        std::vector<std::thread> threads;
+        for (int id = 0; id < n_threads; ++id) {
+            threads.emplace_back([&, id] {
+                std::mt19937 gen(static_cast<unsigned>(id));
+                for (int i = 0; i < 20000; ++i) {
+                    auto key = static_cast<int>(gen() % 64);
+                    switch (gen() % 3) {
+                        case 0:
+                            inserted += set.insert(key);
+                            break;
+                        case 1:
+                            erased += set.erase(key);
+                            break;
+                        default:
+                            (void) set.contains(key);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        auto values = to_vector(set);
+        ASSERT_EQ(static_cast<long>(values.size()), inserted - erased)
+                                    << "Every successful insert and erase should be accounted for exactly once";
+        for (std::size_t i = 1; i < values.size(); ++i) {
+            ASSERT_LT(values[i - 1], values[i]) << "The set should stay sorted and free of duplicates";
+        }
+    }
+
+    TEST(concurrent_ordered_list, erased_nodes_are_reclaimed) {
+        saxion::epoch_domain::global().synchronize();
+        auto before = tracked::alive.load();
+        {
+            saxion::concurrent_ordered_list<tracked> set;
+            std::vector<std::thread> threads;
+            for (int id = 0; id < n_threads; ++id) {
+                threads.emplace_back([&set, id] {
+                    for (int round = 0; round < 50; ++round) {
+                        for (int i = 0; i < 20; ++i) {
+                            set.insert(tracked{id * 100 + i});
+                        }
+                        for (int i = 0; i < 20; ++i) {
+                            set.erase(tracked{id * 100 + i});
+                        }
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            ASSERT_TRUE(set.empty());
+        }
+        saxion::epoch_domain::global().synchronize();
+        ASSERT_EQ(tracked::alive.load(), before) << "Every erased node should be freed after a grace period";
+    }
+}
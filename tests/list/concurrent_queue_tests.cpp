@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_queue.h"
+
+namespace {
+
+    constexpr int n_producers = 3;
+    constexpr int n_consumers = 3;
+    constexpr int per_producer = 20000;
+
+    /// memory resource counting the allocations forwarded to its upstream
+    struct counting_resource : std::pmr::memory_resource {
+        std::atomic<std::size_t> allocations{};
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    TEST(concurrent_queue, fifo) {
+        saxion::concurrent_queue<std::string> queue;
+        ASSERT_TRUE(queue.empty());
+        ASSERT_FALSE(queue.try_pop().has_value());
+
+        queue.push("a");
+        std::string b = "b";
+        queue.push(b);
+        queue.emplace(3, 'c');
+        ASSERT_EQ(queue.size(), 3);
+
+        ASSERT_EQ(queue.try_pop(), "a");
+        ASSERT_EQ(queue.pop(), "b");
+        ASSERT_EQ(queue.try_pop(), "ccc");
+        ASSERT_FALSE(queue.try_pop().has_value());
+        ASSERT_TRUE(queue.empty());
+
+        queue.push("left behind");
+    }
+
+    TEST(concurrent_queue, bulk_push_and_pop_n) {
+        saxion::concurrent_queue<int> queue;
+        std::vector<int> values(10);
+        std::iota(values.begin(), values.end(), 0);
+        ASSERT_EQ(queue.push(values.begin(), values.end()), 10);
+
+        saxion::list<int> out{-1};
+        ASSERT_EQ(queue.pop_n(out, 4), 4);
+        ASSERT_EQ(std::vector<int>(out.begin(), out.end()), (std::vector<int>{-1, 0, 1, 2, 3}));
+        ASSERT_EQ(queue.size(), 6);
+
+        ASSERT_EQ(queue.pop_n(out, 100), 6) << "pop_n should stop at the end of the queue";
+        ASSERT_EQ(out.size(), 11);
+        ASSERT_EQ(out.back(), 9);
+        ASSERT_EQ(queue.pop_n(out, 100), 0);
+
+        queue.push(42);
+        ASSERT_EQ(queue.pop(), 42);
+    }
+
+    TEST(concurrent_queue, throwing_element) {
+        struct fragile {
+            int value;
+
+            explicit fragile(int v) : value{v} {
+                if (v < 0) {
+                    throw std::runtime_error("negative");
+                }
+            }
+        };
+
+        saxion::concurrent_queue<fragile> queue;
+        queue.emplace(1);
+        ASSERT_THROW(queue.emplace(-1), std::runtime_error);
+        std::vector<int> values{2, -3, 4};
+        ASSERT_THROW(queue.push(values.begin(), values.end()), std::runtime_error);
+        ASSERT_EQ(queue.size(), 1) << "A failed push shouldn't add anything";
+        queue.emplace(5);
+        ASSERT_EQ(queue.pop().value, 1);
+        ASSERT_EQ(queue.pop().value, 5);
+    }
+
+    TEST(concurrent_queue, nodes_are_recycled) {
+        counting_resource resource;
+        saxion::pmr::concurrent_queue<int> queue(&resource);
+        queue.reserve(16);
+        auto allocations = resource.allocations.load();
+
+        saxion::list<int> out;
+        out.reserve(16);
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 16; ++i) {
+                queue.push(i);
+            }
+            if (round % 2 == 0) {
+                while (queue.try_pop()) {}
+            } else {
+                out.clear();
+                queue.pop_n(out, 16);
+            }
+        }
+        ASSERT_EQ(resource.allocations, allocations) << "Popped nodes should be reused by the next pushes";
+    }
+
+    TEST(concurrent_queue, producers_and_consumers) {
+        saxion::concurrent_queue<int> queue;
+        std::atomic<long long> sum{};
+        std::vector<std::vector<int>> seen(n_consumers);
+        constexpr int total = n_producers * per_producer;
+        std::atomic<int> popped{};
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < n_producers; ++p) {
+            threads.emplace_back([&queue, p] {
+                for (int i = 0; i < per_producer; i += 10) {
+                    if (i % 20 == 0) {
+                        for (int j = i; j < i + 10; ++j) {
+                            queue.push(p * per_producer + j);
+                        }
+                    } else {
+                        std::vector<int> batch(10);
+                        std::iota(batch.begin(), batch.end(), p * per_producer + i);
+                        queue.push(batch.begin(), batch.end());
+                    }
+                }
+            });
+        }
+        for (int c = 0; c < n_consumers; ++c) {
+            threads.emplace_back([&, c] {
+                saxion::list<int> batch;
+                while (popped.load() < total) {
+                    batch.clear();
+                    if (c == 0) {
+                        if (auto value = queue.try_pop()) {
+                            batch.push_back(*value);
+                        }
+                    } else {
+                        queue.pop_n(batch, 7);
+                    }
+                    for (int value : batch) {
+                        seen[static_cast<std::size_t>(c)].push_back(value);
+                        sum += value;
+                    }
+                    popped += static_cast<int>(batch.size());
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_TRUE(queue.empty());
+        ASSERT_EQ(popped.load(), total);
+        ASSERT_EQ(sum.load(), static_cast<long long>(total) * (total - 1) / 2) << "Every element should be popped once";
+        for (const auto& values : seen) {
+            // elements of one producer are seen in order by every consumer
+            std::vector<int> last(n_producers, -1);
+            for (int value : values) {
+                auto producer = static_cast<std::size_t>(value / per_producer);
+                ASSERT_LT(last[producer], value);
+                last[producer] = value;
+            }
+        }
+    }
+
+    TEST(concurrent_queue, blocking_pop) {
+        saxion::concurrent_queue<std::unique_ptr<int>> queue;
+        std::atomic<int> sum{};
+        std::vector<std::thread> consumers;
+        for (int c = 0; c < n_consumers; ++c) {
+            consumers.emplace_back([&queue, &sum] {
+                while (true) {
+                    auto value = queue.pop();
+                    if (!value) {
+                        return;
+                    }
+                    sum += *value;
+                }
+            });
+        }
+
+        for (int i = 1; i <= 1000; ++i) {
+            queue.push(std::make_unique<int>(i));
+            if (i % 100 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        for (int c = 0; c < n_consumers; ++c) {
+            queue.push(nullptr);
+        }
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+        ASSERT_EQ(sum.load(), 1000 * 1001 / 2);
+    }
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "indexed_list.h"
+
+namespace {
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    /// checks the sizes and the AVL balance of a subtree, returns its height
+    int check_subtree(const saxion::detail::indexed_node_base* node) {
+        if (!node) {
+            return 0;
+        }
+        auto left = check_subtree(node->left_);
+        auto right = check_subtree(node->right_);
+        EXPECT_LE(std::abs(left - right), 1) << "The tree should be balanced";
+        EXPECT_EQ(node->count_, saxion::detail::indexed_tree::size_of(node->left_) +
+                                saxion::detail::indexed_tree::size_of(node->right_) + 1);
+        EXPECT_EQ(node->height_, std::max(left, right) + 1);
+        return node->height_;
+    }
+
+    template<typename List>
+    void check_tree(const List& lst) {
+        check_subtree(lst.end().node()->parent_);
+    }
+
+    static_assert(std::random_access_iterator<saxion::indexed_list<int>::iterator>);
+    static_assert(std::random_access_iterator<saxion::indexed_list<int>::const_iterator>);
+
+    TEST(indexed_list, empty) {
+        saxion::indexed_list<int> lst;
+        ASSERT_TRUE(lst.empty());
+        ASSERT_EQ(lst.size(), 0);
+        ASSERT_EQ(lst.begin(), lst.end());
+        ASSERT_EQ(lst.index_of(lst.end()), 0);
+        ASSERT_THROW((void) lst.at(0), std::length_error);
+    }
+
+    TEST(indexed_list, positional_access) {
+        saxion::indexed_list<int> lst;
+        for (int i = 0; i < 1000; ++i) {
+            lst.push_back(i);
+        }
+        check_tree(lst);
+        ASSERT_EQ(lst.size(), 1000);
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_EQ(lst[static_cast<std::size_t>(i)], i);
+        }
+        ASSERT_EQ(lst.at(999), 999);
+        ASSERT_THROW((void) lst.at(1000), std::length_error);
+
+        auto it = lst.begin();
+        std::advance(it, 500);
+        ASSERT_EQ(*it, 500);
+        ASSERT_EQ(lst.index_of(it), 500);
+        ASSERT_EQ(std::distance(lst.begin(), it), 500);
+        ASSERT_EQ(std::distance(it, lst.end()), 500);
+        ASSERT_EQ(it[10], 510);
+        ASSERT_EQ(*(it - 100), 400);
+        ASSERT_EQ(lst.end() - 1, std::prev(lst.end()));
+        ASSERT_TRUE(lst.begin() < it);
+        ASSERT_TRUE(it < lst.end());
+        ASSERT_EQ(lst.index_of(lst.end()), 1000);
+    }
+
+    TEST(indexed_list, push_front_and_insert) {
+        saxion::indexed_list<std::string> lst{"c", "e"};
+        lst.push_front("a");
+        lst.insert(lst.begin() + 1, "b");
+        lst.insert(lst.begin() + 3, "d");
+        lst.emplace(lst.end(), 2, 'f');
+        ASSERT_EQ(to_vector(lst), (std::vector<std::string>{"a", "b", "c", "d", "e", "ff"}));
+        ASSERT_EQ(lst[3], "d");
+        ASSERT_EQ(lst.front(), "a");
+        ASSERT_EQ(lst.back(), "ff");
+        check_tree(lst);
+    }
+
+    TEST(indexed_list, random_operations) {
+        std::mt19937 gen(7);
+        saxion::indexed_list<int> lst;
+        std::vector<int> expected;
+
+        for (int step = 0; step < 4000; ++step) {
+            if (gen() % 3 != 0 || expected.empty()) {
+                auto index = gen() % (expected.size() + 1);
+                auto it = lst.insert(lst.begin() + static_cast<std::ptrdiff_t>(index), step);
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index), step);
+                ASSERT_EQ(lst.index_of(it), index);
+            } else {
+                auto index = gen() % expected.size();
+                auto it = lst.erase(lst.begin() + static_cast<std::ptrdiff_t>(index));
+                expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+                ASSERT_EQ(lst.index_of(it), index) << "erase should return the element after the erased one";
+            }
+            if (step % 500 == 0) {
+                check_tree(lst);
+            }
+        }
+        check_tree(lst);
+        ASSERT_EQ(to_vector(lst), expected);
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            ASSERT_EQ(lst[i], expected[i]);
+        }
+    }
+
+    TEST(indexed_list, algorithms) {
+        saxion::indexed_list<int> lst{5, 3, 9, 1, 7};
+        const auto& const_lst = lst;
+        ASSERT_EQ(*std::max_element(const_lst.begin(), const_lst.end()), 9);
+        auto found = std::find(lst.begin(), lst.end(), 1);
+        ASSERT_EQ(lst.index_of(found), 3);
+
+        std::vector<int> sorted{1, 3, 5, 7, 9};
+        saxion::indexed_list<int> sorted_list(sorted.begin(), sorted.end());
+        auto lower = std::lower_bound(sorted_list.begin(), sorted_list.end(), 6);
+        ASSERT_EQ(*lower, 7);
+        ASSERT_EQ(sorted_list.index_of(lower), 3);
+        ASSERT_EQ(lst.begin(), const_lst.cbegin()) << "It should be possible to compare const and non-const iterators";
+    }
+
+    TEST(indexed_list, copy_move_swap) {
+        saxion::indexed_list<int> first{1, 2, 3, 4};
+        saxion::indexed_list<int> copy{first};
+        ASSERT_EQ(to_vector(copy), to_vector(first));
+        check_tree(copy);
+
+        saxion::indexed_list<int> moved{std::move(first)};
+        ASSERT_TRUE(first.empty());
+        ASSERT_EQ(moved[2], 3);
+        ASSERT_EQ(moved.index_of(moved.end()), 4) << "The tree should belong to the list it was moved to";
+
+        saxion::indexed_list<int> other{9};
+        other.swap(moved);
+        ASSERT_EQ(to_vector(moved), (std::vector<int>{9}));
+        ASSERT_EQ(other[3], 4);
+        ASSERT_EQ(other.end() - other.begin(), 4);
+
+        moved = other;
+        copy = std::move(other);
+        ASSERT_EQ(to_vector(moved), to_vector(copy));
+        while (!copy.empty()) {
+            copy.pop_front();
+            check_tree(copy);
+        }
+        moved.clear();
+        ASSERT_TRUE(moved.empty());
+        moved.push_back(1);
+        ASSERT_EQ(moved[0], 1);
+    }
+}
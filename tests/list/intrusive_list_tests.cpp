@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "intrusive_list.h"
+
+namespace {
+
+    struct task {
+        int id;
+        std::string name;
+        saxion::intrusive_list_hook ready_hook;
+        saxion::intrusive_list_hook dirty_hook;
+
+        explicit task(int i) : id{i}, name{"task" + std::to_string(i)} {}
+    };
+
+    using ready_queue = saxion::intrusive_list<task, &task::ready_hook>;
+    using dirty_set = saxion::intrusive_list<task, &task::dirty_hook>;
+
+    template<typename List>
+    std::vector<int> ids(const List& lst) {
+        std::vector<int> result;
+        for (auto& t : lst) {
+            result.push_back(t.id);
+        }
+        return result;
+    }
+
+    TEST(intrusive_list, empty) {
+        ready_queue queue;
+        ASSERT_TRUE(queue.empty());
+        ASSERT_EQ(queue.size(), 0);
+        ASSERT_EQ(queue.begin(), queue.end());
+    }
+
+    TEST(intrusive_list, push_and_iterate) {
+        std::vector<task> tasks{task{0}, task{1}, task{2}};
+        ready_queue queue;
+
+        queue.push_back(tasks[1]);
+        queue.push_back(tasks[2]);
+        queue.push_front(tasks[0]);
+
+        ASSERT_EQ(queue.size(), 3);
+        ASSERT_EQ(ids(queue), (std::vector<int>{0, 1, 2}));
+        ASSERT_EQ(&queue.front(), &tasks[0]) << "The list should link the objects, not copies of them";
+        ASSERT_EQ(&queue.back(), &tasks[2]);
+        ASSERT_EQ(queue.begin()->name, "task0");
+
+        auto it = queue.end();
+        --it;
+        ASSERT_EQ(it->id, 2);
+        queue.clear();
+    }
+
+    TEST(intrusive_list, two_hooks) {
+        std::vector<task> tasks{task{0}, task{1}, task{2}};
+        ready_queue ready;
+        dirty_set dirty;
+
+        for (auto& t : tasks) {
+            ready.push_back(t);
+        }
+        dirty.push_back(tasks[2]);
+        dirty.push_back(tasks[0]);
+
+        ASSERT_EQ(ids(ready), (std::vector<int>{0, 1, 2}));
+        ASSERT_EQ(ids(dirty), (std::vector<int>{2, 0})) << "The hooks should be independent";
+        ready.clear();
+        dirty.clear();
+    }
+
+    TEST(intrusive_list, unlink_from_anywhere) {
+        std::vector<task> tasks{task{0}, task{1}, task{2}, task{3}};
+        ready_queue queue;
+        for (auto& t : tasks) {
+            queue.push_back(t);
+        }
+
+        tasks[2].ready_hook.unlink();
+        ASSERT_EQ(queue.size(), 3) << "Unlinking through the hook should update the size of the list";
+        ASSERT_FALSE(tasks[2].ready_hook.is_linked());
+        ASSERT_EQ(ids(queue), (std::vector<int>{0, 1, 3}));
+
+        ASSERT_TRUE(queue.remove(tasks[0]));
+        ASSERT_FALSE(queue.remove(tasks[0])) << "An unlinked object can't be removed twice";
+        ASSERT_EQ(ids(queue), (std::vector<int>{1, 3}));
+
+        auto next = queue.erase(queue.iterator_to(tasks[1]));
+        ASSERT_EQ(next->id, 3);
+        ASSERT_EQ(queue.size(), 1);
+
+        queue.pop_back();
+        ASSERT_TRUE(queue.empty());
+        ASSERT_FALSE(tasks[3].ready_hook.is_linked());
+    }
+
+    TEST(intrusive_list, auto_unlink) {
+        ready_queue queue;
+        task first{1};
+        queue.push_back(first);
+        {
+            task temporary{2};
+            queue.push_back(temporary);
+            ASSERT_EQ(queue.size(), 2);
+        }
+        ASSERT_EQ(queue.size(), 1) << "A destroyed object should unlink itself";
+        ASSERT_EQ(ids(queue), (std::vector<int>{1}));
+
+        auto owned = std::make_unique<task>(3);
+        queue.push_front(*owned);
+        owned.reset();
+        ASSERT_EQ(ids(queue), (std::vector<int>{1}));
+    }
+
+    TEST(intrusive_list, list_destruction_unlinks) {
+        task t{1};
+        {
+            ready_queue queue;
+            queue.push_back(t);
+            ASSERT_TRUE(t.ready_hook.is_linked());
+        }
+        ASSERT_FALSE(t.ready_hook.is_linked()) << "Destroying a list should unlink its objects";
+    }
+
+    TEST(intrusive_list, relinking_moves_between_lists) {
+        std::vector<task> tasks{task{0}, task{1}, task{2}};
+        ready_queue first;
+        ready_queue second;
+        for (auto& t : tasks) {
+            first.push_back(t);
+        }
+
+        second.push_back(tasks[1]);
+        ASSERT_EQ(ids(first), (std::vector<int>{0, 2}));
+        ASSERT_EQ(ids(second), (std::vector<int>{1}));
+        ASSERT_TRUE(second.contains(tasks[1]));
+        ASSERT_FALSE(first.contains(tasks[1]));
+
+        first.push_front(tasks[2]);
+        ASSERT_EQ(ids(first), (std::vector<int>{2, 0})) << "Relinking within the same list should reorder";
+        ASSERT_EQ(first.size(), 2);
+        first.clear();
+        second.clear();
+    }
+
+    TEST(intrusive_list, move_and_swap) {
+        std::vector<task> tasks{task{0}, task{1}, task{2}};
+        ready_queue first;
+        for (auto& t : tasks) {
+            first.push_back(t);
+        }
+
+        ready_queue second(std::move(first));
+        ASSERT_TRUE(first.empty());
+        ASSERT_EQ(ids(second), (std::vector<int>{0, 1, 2}));
+
+        tasks[1].ready_hook.unlink();
+        ASSERT_EQ(second.size(), 2) << "The hooks should belong to the list they were moved to";
+
+        ready_queue third;
+        third.push_back(tasks[1]);
+        third.swap(second);
+        ASSERT_EQ(ids(third), (std::vector<int>{0, 2}));
+        ASSERT_EQ(ids(second), (std::vector<int>{1}));
+        ASSERT_TRUE(third.contains(tasks[0]));
+        ASSERT_TRUE(second.contains(tasks[1]));
+        second.clear();
+        third.clear();
+    }
+
+    TEST(intrusive_list, algorithms) {
+        std::vector<task> tasks{task{3}, task{1}, task{2}};
+        ready_queue queue;
+        for (auto& t : tasks) {
+            queue.push_back(t);
+        }
+
+        auto found = std::find_if(queue.begin(), queue.end(), [](const task& t) { return t.id == 1; });
+        ASSERT_NE(found, queue.end());
+        ASSERT_EQ(found->name, "task1");
+
+        const auto& const_queue = queue;
+        ASSERT_EQ(std::distance(const_queue.begin(), const_queue.end()), 3);
+        ASSERT_EQ(queue.begin(), const_queue.cbegin()) << "It should be possible to compare const and non-const iterators";
+        queue.clear();
+    }
+
+    TEST(intrusive_list, member_offset) {
+        using ready_traits = saxion::detail::member_hook_traits<task, &task::ready_hook>;
+        using dirty_traits = saxion::detail::member_hook_traits<task, &task::dirty_hook>;
+        task t{7};
+        auto address = [](const auto& object) { return reinterpret_cast<const char*>(&object); };
+        ASSERT_EQ(ready_traits::offset(), address(t.ready_hook) - address(t));
+        ASSERT_EQ(dirty_traits::offset(), address(t.dirty_hook) - address(t));
+        ASSERT_EQ(ready_traits::to_value(ready_traits::to_hook(t)), &t);
+        ASSERT_EQ(dirty_traits::to_value(dirty_traits::to_hook(t)), &t);
+    }
+
+    /// polymorphic, linked through a base hook
+    struct shape : saxion::intrusive_list_hook {
+        virtual ~shape() = default;
+
+        [[nodiscard]]
+        virtual int sides() const noexcept = 0;
+    };
+
+    struct triangle final : shape {
+        [[nodiscard]]
+        int sides() const noexcept override { return 3; }
+    };
+
+    struct square final : shape {
+        [[nodiscard]]
+        int sides() const noexcept override { return 4; }
+    };
+
+    TEST(intrusive_list, base_hook) {
+        triangle t;
+        square s;
+        saxion::intrusive_base_list<shape> shapes;
+        shapes.push_back(t);
+        shapes.push_front(s);
+        ASSERT_TRUE(t.is_linked());
+        ASSERT_EQ(&shapes.front(), &s);
+        ASSERT_EQ(&shapes.back(), &t);
+
+        std::vector<int> sides;
+        for (const auto& item : shapes) {
+            sides.push_back(item.sides());
+        }
+        ASSERT_EQ(sides, (std::vector<int>{4, 3}));
+
+        s.unlink();
+        ASSERT_EQ(shapes.size(), 1);
+        ASSERT_EQ(shapes.begin()->sides(), 3);
+        shapes.clear();
+        ASSERT_FALSE(t.is_linked());
+    }
+}
@@ -0,0 +1,374 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "list.h"
+
+namespace {
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    struct record {
+        int key;
+        int order;
+
+        bool operator==(const record&) const = default;
+    };
+
+    TEST(list_sort, empty_and_single) {
+        saxion::list<int> empty;
+        empty.sort();
+        ASSERT_TRUE(empty.empty());
+
+        saxion::list<int> single{42};
+        single.sort();
+        ASSERT_EQ(to_vector(single), (std::vector<int>{42}));
+        ASSERT_EQ(*(--single.end()), 42) << "The backward links should be restored";
+    }
+
+    TEST(list_sort, random_values) {
+        std::mt19937 gen(1);
+        for (std::size_t n : {2U, 3U, 17U, 64U, 1000U, 4097U}) {
+            std::vector<int> values(n);
+            for (auto& v : values) {
+                v = static_cast<int>(gen() % 100);
+            }
+            saxion::list<int> lst(values.begin(), values.end());
+            lst.sort();
+            std::sort(values.begin(), values.end());
+            ASSERT_EQ(to_vector(lst), values) << "n = " << n;
+            ASSERT_EQ(lst.size(), n);
+
+            std::vector<int> backwards;
+            for (auto it = lst.end(); it != lst.begin();) {
+                backwards.push_back(*--it);
+            }
+            std::reverse(backwards.begin(), backwards.end());
+            ASSERT_EQ(backwards, values) << "The backward links should be consistent";
+        }
+    }
+
+    TEST(list_sort, stable) {
+        std::mt19937 gen(2);
+        std::vector<record> records;
+        for (int i = 0; i < 500; ++i) {
+            records.push_back({static_cast<int>(gen() % 10), i});
+        }
+        saxion::list<record> lst(records.begin(), records.end());
+
+        lst.sort([](const record& lhs, const record& rhs) { return lhs.key < rhs.key; });
+        std::stable_sort(records.begin(), records.end(), [](const record& lhs, const record& rhs) { return lhs.key < rhs.key; });
+        ASSERT_EQ(to_vector(lst), records);
+    }
+
+    TEST(list_sort, comparator_and_projection) {
+        saxion::list<std::string> words{"pear", "fig", "banana", "kiwi", "apple"};
+        words.sort(std::greater<>{});
+        ASSERT_EQ(to_vector(words), (std::vector<std::string>{"pear", "kiwi", "fig", "banana", "apple"}));
+
+        words.sort(std::less<>{}, &std::string::size);
+        ASSERT_EQ(to_vector(words), (std::vector<std::string>{"fig", "pear", "kiwi", "apple", "banana"}))
+                                    << "Sorting by size should keep the previous order of words of the same size";
+
+        saxion::list<record> records{record{3, 0}, record{1, 1}, record{2, 2}};
+        records.sort(std::less<>{}, &record::key);
+        ASSERT_EQ(records.front().order, 1);
+        ASSERT_EQ(records.back().order, 0);
+    }
+
+    TEST(list_sort, iterators_stay_valid) {
+        saxion::list<int> lst{5, 4, 3, 2, 1};
+        auto three = std::find(lst.begin(), lst.end(), 3);
+        auto* address = &*three;
+        lst.sort();
+        ASSERT_EQ(&*three, address) << "Sorting should relink the nodes, not move the values";
+        ASSERT_EQ(*three, 3);
+        ASSERT_EQ(*++three, 4);
+    }
+
+    TEST(list_sort, throwing_comparator) {
+        std::vector<int> values(100);
+        std::iota(values.begin(), values.end(), 0);
+        std::shuffle(values.begin(), values.end(), std::mt19937(3));
+        saxion::list<int> lst(values.begin(), values.end());
+
+        int calls = 0;
+        ASSERT_THROW(lst.sort([&calls](int lhs, int rhs) {
+            if (++calls == 200) {
+                throw std::runtime_error("comparator failed");
+            }
+            return lhs < rhs;
+        }), std::runtime_error);
+
+        ASSERT_EQ(lst.size(), values.size());
+        auto remaining = to_vector(lst);
+        std::sort(remaining.begin(), remaining.end());
+        std::sort(values.begin(), values.end());
+        ASSERT_EQ(remaining, values) << "No element should be lost when the comparator throws";
+
+        lst.sort();
+        ASSERT_EQ(to_vector(lst), values);
+    }
+
+    TEST(list_splice, whole_list) {
+        saxion::list<int> first{1, 2, 3};
+        auto second = std::make_unique<saxion::list<int>>(std::initializer_list<int>{4, 5, 6});
+        auto four = second->begin();
+        auto* address = &*four;
+        auto capacity = first.capacity() + second->capacity();
+
+        first.splice(first.end(), *second);
+        ASSERT_EQ(to_vector(first), (std::vector<int>{1, 2, 3, 4, 5, 6}));
+        ASSERT_TRUE(second->empty());
+        ASSERT_EQ(second->capacity(), 0) << "The pool of the spliced list should be adopted";
+        ASSERT_EQ(first.capacity(), capacity);
+        ASSERT_EQ(&*four, address) << "Splicing should relink the nodes, not move the values";
+
+        second.reset();
+        first.pop_back();
+        first.push_back(7);
+        ASSERT_EQ(to_vector(first), (std::vector<int>{1, 2, 3, 4, 5, 7}))
+                                    << "The adopted nodes should outlive the list they came from";
+
+        saxion::list<int> third{0};
+        third.splice(third.begin(), saxion::list<int>{-2, -1});
+        ASSERT_EQ(to_vector(third), (std::vector<int>{-2, -1, 0}));
+        first.splice(first.begin(), third);
+        ASSERT_EQ(first.size(), 9);
+        ASSERT_EQ(first.front(), -2);
+        ASSERT_EQ(*(--first.end()), 7);
+    }
+
+    TEST(list_splice, different_allocators) {
+        std::pmr::monotonic_buffer_resource first_resource;
+        std::pmr::monotonic_buffer_resource second_resource;
+        saxion::pmr::list<std::pmr::string> first({"a", "b"}, &first_resource);
+        saxion::pmr::list<std::pmr::string> second({"c", "d"}, &second_resource);
+
+        first.splice(first.end(), second);
+        ASSERT_EQ(first.size(), 4);
+        ASSERT_TRUE(second.empty());
+        ASSERT_EQ(first.back(), "d");
+        ASSERT_EQ(first.back().get_allocator().resource(), &first_resource)
+                                    << "Elements of a list with another allocator should be moved to new nodes";
+
+        saxion::pmr::list<std::pmr::string> third({"e", "f"}, &second_resource);
+        ASSERT_THROW(first.splice(first.end(), third, third.begin()), std::invalid_argument);
+        ASSERT_THROW(first.splice(first.end(), third, third.begin(), third.end()), std::invalid_argument);
+        ASSERT_EQ(first.size(), 4);
+        ASSERT_EQ(third.size(), 2);
+    }
+
+    TEST(list_splice, elements_and_ranges) {
+        saxion::list<int> lst{1, 2, 3, 4, 5};
+        lst.splice(lst.begin(), lst, std::find(lst.begin(), lst.end(), 4));
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{4, 1, 2, 3, 5}));
+
+        lst.splice(lst.end(), lst, lst.begin(), std::find(lst.begin(), lst.end(), 3));
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{3, 5, 4, 1, 2}));
+
+        lst.splice(lst.begin(), lst, lst.begin());
+        lst.splice(++lst.begin(), lst, lst.begin());
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{3, 5, 4, 1, 2})) << "Splicing an element to its own place should do nothing";
+
+        saxion::list<int> other{10, 20, 30, 40};
+        lst.splice(lst.begin(), other, ++other.begin(), --other.end());
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{20, 30, 3, 5, 4, 1, 2}));
+        ASSERT_EQ(to_vector(other), (std::vector<int>{10, 40}));
+
+        lst.splice(lst.end(), other, other.begin());
+        ASSERT_EQ(lst.back(), 10);
+        ASSERT_EQ(other.size(), 1);
+
+        std::vector<int> backwards;
+        for (auto it = lst.end(); it != lst.begin();) {
+            backwards.push_back(*--it);
+        }
+        ASSERT_EQ(backwards, (std::vector<int>{10, 2, 1, 4, 5, 3, 30, 20}));
+    }
+
+    TEST(list_splice, elements_keep_their_nodes) {
+        auto source = std::make_unique<saxion::list<std::string>>(std::initializer_list<std::string>{"a", "b", "c", "d", "e"});
+        saxion::list<std::string> target{"x"};
+
+        auto b = std::next(source->begin());
+        auto* address = &*b;
+        target.splice(target.end(), *source, b);
+        ASSERT_EQ(&target.back(), address) << "Splicing should relink the node, not move the value";
+        ASSERT_EQ(std::prev(target.end()), b) << "The iterator should refer to the element in its new list";
+
+        target.splice(target.begin(), *source, std::next(source->begin()), std::prev(source->end()));
+        ASSERT_EQ(to_vector(target), (std::vector<std::string>{"c", "d", "x", "b"}));
+        ASSERT_EQ(to_vector(*source), (std::vector<std::string>{"a", "e"}));
+        ASSERT_GE(target.capacity(), target.size());
+
+        source.reset();
+        ASSERT_EQ(*b, "b") << "The spliced nodes should outlive the list they came from";
+        target.erase(b);
+        target.push_back("y");
+        ASSERT_EQ(&target.back(), address) << "A spliced node should be recycled by the list it was spliced to";
+        ASSERT_EQ(to_vector(target), (std::vector<std::string>{"c", "d", "x", "y"}));
+    }
+
+    /// can't be copied nor moved, so a splice can only relink it
+    struct pinned {
+        int value;
+
+        explicit pinned(int v) : value{v} {}
+        pinned(const pinned&) = delete;
+        pinned& operator=(const pinned&) = delete;
+    };
+
+    TEST(list_splice, immovable_elements) {
+        saxion::list<pinned> first;
+        saxion::list<pinned> second;
+        for (int i = 0; i < 4; ++i) {
+            first.emplace_back(i);
+        }
+        second.emplace_back(10);
+
+        second.splice(second.begin(), first, std::next(first.begin()));
+        second.splice(second.end(), first, first.begin(), std::prev(first.end()));
+        std::vector<int> values;
+        for (const auto& p : second) {
+            values.push_back(p.value);
+        }
+        ASSERT_EQ(values, (std::vector<int>{1, 10, 0, 2}));
+        ASSERT_EQ(first.size(), 1);
+        ASSERT_EQ(first.front().value, 3);
+    }
+
+    TEST(list_splice, shared_slabs) {
+        std::vector<std::unique_ptr<saxion::list<int>>> lists;
+        for (int i = 0; i < 4; ++i) {
+            lists.push_back(std::make_unique<saxion::list<int>>());
+            for (int j = 0; j < 100; ++j) {
+                lists.back()->push_back(i * 100 + j);
+            }
+        }
+        // every list gives the second half of its elements to the next one, so all the pools end up sharing
+        for (int round = 0; round < 3; ++round) {
+            for (std::size_t i = 0; i < lists.size(); ++i) {
+                auto& from = *lists[i];
+                auto& to = *lists[(i + 1) % lists.size()];
+                to.splice(to.end(), from, std::next(from.begin(), static_cast<long>(from.size() / 2)), from.end());
+            }
+        }
+        std::vector<int> all;
+        for (const auto& lst : lists) {
+            all.insert(all.end(), lst->begin(), lst->end());
+            ASSERT_GE(lst->capacity(), lst->size());
+        }
+        std::sort(all.begin(), all.end());
+        std::vector<int> expected(400);
+        std::iota(expected.begin(), expected.end(), 0);
+        ASSERT_EQ(all, expected);
+
+        lists[1]->shrink_to_fit();
+        lists[2].reset();
+        lists[0].reset();
+        lists[1]->erase(lists[1]->begin());
+        for (int j = 0; j < 200; ++j) {
+            lists[1]->push_back(j);
+            lists[3]->push_front(j);
+        }
+        auto size = lists[1]->size() + lists[3]->size();
+        lists[3]->splice(lists[3]->begin(), *lists[1], lists[1]->begin(), lists[1]->end());
+        ASSERT_TRUE(lists[1]->empty());
+        lists[1].reset();
+        ASSERT_EQ(lists[3]->size(), size);
+        ASSERT_EQ(std::distance(lists[3]->begin(), lists[3]->end()), static_cast<long>(size));
+        lists[3]->clear();
+        lists[3]->shrink_to_fit();
+        lists[3].reset();
+    }
+
+    TEST(list_merge, sorted_lists) {
+        saxion::list<int> first{1, 3, 5, 7};
+        saxion::list<int> second{0, 2, 3, 8, 9};
+        first.merge(second);
+        ASSERT_EQ(to_vector(first), (std::vector<int>{0, 1, 2, 3, 3, 5, 7, 8, 9}));
+        ASSERT_TRUE(second.empty());
+        ASSERT_EQ(*(--first.end()), 9);
+
+        saxion::list<int> empty;
+        empty.merge(first);
+        ASSERT_EQ(empty.size(), 9);
+        empty.merge(saxion::list<int>{});
+        ASSERT_EQ(empty.size(), 9);
+    }
+
+    TEST(list_merge, stable_with_comparator) {
+        saxion::list<record> first{record{3, 0}, record{2, 1}, record{1, 2}};
+        saxion::list<record> second{record{3, 3}, record{1, 4}};
+        auto descending = [](const record& lhs, const record& rhs) { return lhs.key > rhs.key; };
+        first.merge(second, descending);
+        ASSERT_EQ(to_vector(first), (std::vector<record>{{3, 0}, {3, 3}, {2, 1}, {1, 2}, {1, 4}}))
+                                    << "Equivalent elements of this list should come first";
+    }
+
+    TEST(list_reverse, reverse) {
+        saxion::list<int> lst{1, 2, 3, 4};
+        lst.reverse();
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{4, 3, 2, 1}));
+        ASSERT_EQ(*(--lst.end()), 1);
+
+        saxion::list<int> empty;
+        empty.reverse();
+        ASSERT_TRUE(empty.empty());
+    }
+
+    TEST(list_remove, remove_and_remove_if) {
+        saxion::list<int> lst{1, 2, 3, 2, 4, 2};
+        ASSERT_EQ(lst.remove(2), 3);
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{1, 3, 4}));
+        ASSERT_EQ(lst.size(), 3);
+
+        ASSERT_EQ(lst.remove_if([](int v) { return v % 2 == 1; }), 2);
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{4}));
+
+        saxion::list<std::string> words{"a", "b", "a", "c"};
+        ASSERT_EQ(words.remove(words.front()), 2) << "Removing an element equal to one of the list should be safe";
+        ASSERT_EQ(to_vector(words), (std::vector<std::string>{"b", "c"}));
+        auto capacity = words.capacity();
+        words.push_back("d");
+        words.push_back("e");
+        ASSERT_EQ(words.capacity(), capacity) << "The removed nodes should go back to the pool";
+    }
+
+    TEST(list_remove, throwing_predicate) {
+        saxion::list<int> lst{1, 2, 3, 4, 5};
+        ASSERT_THROW(lst.remove_if([](int v) {
+            if (v == 4) {
+                throw std::runtime_error("predicate failed");
+            }
+            return v % 2 == 0;
+        }), std::runtime_error);
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{1, 3, 4, 5}));
+        ASSERT_EQ(lst.size(), 4);
+    }
+
+    TEST(list_unique, unique) {
+        saxion::list<int> lst{1, 1, 2, 2, 2, 3, 1, 1};
+        ASSERT_EQ(lst.unique(), 4);
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{1, 2, 3, 1}));
+
+        saxion::list<int> close{1, 2, 4, 5, 9};
+        ASSERT_EQ(close.unique([](int lhs, int rhs) { return rhs - lhs <= 1; }), 2);
+        ASSERT_EQ(to_vector(close), (std::vector<int>{1, 4, 9}));
+
+        saxion::list<int> empty;
+        ASSERT_EQ(empty.unique(), 0);
+    }
+}
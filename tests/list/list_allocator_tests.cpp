@@ -0,0 +1,387 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "list.h"
+
+namespace {
+
+    /// bookkeeping shared by all the copies of a tracking allocator
+    struct allocation_stats {
+        std::size_t allocations{};
+        std::size_t deallocations{};
+    };
+
+    /**
+     * Stateful allocator, two allocators are equal only if they share the same id.
+     * The propagation traits are configurable to check the behaviour of the list.
+     */
+    template<typename T, bool Propagate = false>
+    struct tracking_allocator {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_swap = std::bool_constant<Propagate>;
+        using is_always_equal = std::false_type;
+
+        allocation_stats* stats;
+        int id;
+
+        tracking_allocator(allocation_stats* s, int i) noexcept: stats{s}, id{i} {}
+
+        template<typename U>
+        tracking_allocator(const tracking_allocator<U, Propagate>& other) noexcept: stats{other.stats}, id{other.id} {}
+
+        template<typename U>
+        struct rebind {
+            using other = tracking_allocator<U, Propagate>;
+        };
+
+        T* allocate(std::size_t n) {
+            ++stats->allocations;
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept {
+            ++stats->deallocations;
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        tracking_allocator select_on_container_copy_construction() const {
+            return tracking_allocator{stats, id + 100};
+        }
+
+        template<typename U>
+        friend bool operator==(const tracking_allocator& lhs, const tracking_allocator<U, Propagate>& rhs) noexcept {
+            return lhs.id == rhs.id;
+        }
+    };
+
+    /// memory resource counting the allocations forwarded to its upstream
+    struct counting_resource : std::pmr::memory_resource {
+        std::pmr::memory_resource* upstream;
+        std::size_t allocations{};
+
+        explicit counting_resource(std::pmr::memory_resource* up = std::pmr::new_delete_resource()) : upstream{up} {}
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            return upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            upstream->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]]
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    TEST(list_allocator, all_nodes_go_through_allocator) {
+        allocation_stats stats;
+        {
+            saxion::list<int, tracking_allocator<int>> lst({&stats, 1});
+            for (int i = 0; i < 10; ++i) {
+                lst.push_back(i);
+            }
+            lst.push_front(-1);
+            lst.emplace_back(42);
+            lst.insert(lst.begin(), 7);
+            lst.pop_back();
+            lst.erase(lst.begin());
+
+            ASSERT_EQ(lst.size(), 11);
+            ASSERT_GT(stats.allocations, 0) << "The nodes should be allocated with the allocator";
+        }
+        ASSERT_EQ(stats.allocations, stats.deallocations) << "Every node should be returned to the allocator";
+    }
+
+    TEST(list_allocator, get_allocator) {
+        allocation_stats stats;
+        saxion::list<int, tracking_allocator<int>> lst({&stats, 3});
+        ASSERT_EQ(lst.get_allocator().id, 3);
+        ASSERT_EQ(lst.get_allocator().stats, &stats);
+    }
+
+    TEST(list_allocator, copy_uses_select_on_container_copy_construction) {
+        allocation_stats stats;
+        saxion::list<int, tracking_allocator<int>> lst({1, 2, 3}, {&stats, 1});
+        auto copy(lst);
+        ASSERT_EQ(copy.get_allocator().id, 101);
+        ASSERT_EQ(to_vector(copy), (std::vector<int>{1, 2, 3}));
+
+        saxion::list<int, tracking_allocator<int>> other(lst, {&stats, 5});
+        ASSERT_EQ(other.get_allocator().id, 5);
+        ASSERT_EQ(to_vector(other), (std::vector<int>{1, 2, 3}));
+    }
+
+    TEST(list_allocator, copy_assignment_propagation) {
+        allocation_stats stats;
+        {
+            saxion::list<int, tracking_allocator<int, true>> src({1, 2}, {&stats, 1});
+            saxion::list<int, tracking_allocator<int, true>> dst({3}, {&stats, 2});
+            dst = src;
+            ASSERT_EQ(dst.get_allocator().id, 1) << "A propagating allocator should be copied";
+            ASSERT_EQ(to_vector(dst), (std::vector<int>{1, 2}));
+        }
+        {
+            saxion::list<int, tracking_allocator<int>> src({1, 2}, {&stats, 1});
+            saxion::list<int, tracking_allocator<int>> dst({3}, {&stats, 2});
+            dst = src;
+            ASSERT_EQ(dst.get_allocator().id, 2) << "A non-propagating allocator should be kept";
+            ASSERT_EQ(to_vector(dst), (std::vector<int>{1, 2}));
+        }
+        ASSERT_EQ(stats.allocations, stats.deallocations);
+    }
+
+    TEST(list_allocator, move_assignment_propagation) {
+        allocation_stats stats;
+        {
+            saxion::list<std::string, tracking_allocator<std::string, true>> src({"a", "b"}, {&stats, 1});
+            saxion::list<std::string, tracking_allocator<std::string, true>> dst({"c"}, {&stats, 2});
+            auto allocations = stats.allocations;
+            dst = std::move(src);
+            ASSERT_EQ(dst.get_allocator().id, 1);
+            ASSERT_EQ(stats.allocations, allocations) << "Moving with a propagating allocator should steal the nodes";
+            ASSERT_EQ(to_vector(dst), (std::vector<std::string>{"a", "b"}));
+            ASSERT_TRUE(src.empty());
+        }
+        {
+            saxion::list<std::string, tracking_allocator<std::string>> src({"a", "b"}, {&stats, 1});
+            saxion::list<std::string, tracking_allocator<std::string>> dst({"c"}, {&stats, 2});
+            dst = std::move(src);
+            ASSERT_EQ(dst.get_allocator().id, 2) << "A non-propagating allocator should be kept";
+            ASSERT_EQ(to_vector(dst), (std::vector<std::string>{"a", "b"}));
+            ASSERT_TRUE(src.empty());
+        }
+        {
+            saxion::list<std::string, tracking_allocator<std::string>> src({"a", "b"}, {&stats, 1});
+            saxion::list<std::string, tracking_allocator<std::string>> dst(std::move(src), {&stats, 2});
+            ASSERT_EQ(dst.get_allocator().id, 2);
+            ASSERT_EQ(to_vector(dst), (std::vector<std::string>{"a", "b"}));
+        }
+        ASSERT_EQ(stats.allocations, stats.deallocations);
+    }
+
+    TEST(list_allocator, swap_propagation) {
+        allocation_stats stats;
+        {
+            saxion::list<int, tracking_allocator<int, true>> lhs({1, 2}, {&stats, 1});
+            saxion::list<int, tracking_allocator<int, true>> rhs({3}, {&stats, 2});
+            lhs.swap(rhs);
+            ASSERT_EQ(lhs.get_allocator().id, 2);
+            ASSERT_EQ(rhs.get_allocator().id, 1);
+            ASSERT_EQ(to_vector(lhs), (std::vector<int>{3}));
+            ASSERT_EQ(to_vector(rhs), (std::vector<int>{1, 2}));
+        }
+        {
+            saxion::list<int, tracking_allocator<int>> lhs({1, 2}, {&stats, 1});
+            saxion::list<int, tracking_allocator<int>> rhs({3}, {&stats, 1});
+            std::swap(lhs, rhs);
+            ASSERT_EQ(to_vector(lhs), (std::vector<int>{3}));
+            ASSERT_EQ(to_vector(rhs), (std::vector<int>{1, 2}));
+        }
+        ASSERT_EQ(stats.allocations, stats.deallocations);
+    }
+
+    TEST(list_allocator, pmr_monotonic_resource) {
+        counting_resource upstream;
+        std::pmr::monotonic_buffer_resource arena(64 * 1024, &upstream);
+        auto initial = upstream.allocations;
+
+        saxion::pmr::list<int> lst(&arena);
+        for (int i = 0; i < 100; ++i) {
+            lst.push_back(i);
+        }
+
+        ASSERT_EQ(lst.size(), 100);
+        ASSERT_EQ(lst.get_allocator().resource(), &arena);
+        ASSERT_LE(upstream.allocations - initial, 1) << "All the nodes should come from the arena";
+        ASSERT_EQ(lst.front(), 0);
+        ASSERT_EQ(lst.back(), 99);
+    }
+
+    TEST(list_allocator, pmr_copy_uses_default_resource) {
+        std::pmr::monotonic_buffer_resource arena;
+        saxion::pmr::list<int> lst({1, 2, 3}, &arena);
+
+        auto copy(lst);
+        ASSERT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource())
+                                    << "polymorphic_allocator doesn't propagate on copy construction";
+
+        saxion::pmr::list<int> other(&arena);
+        other = std::move(copy);
+        ASSERT_EQ(other.get_allocator().resource(), &arena);
+        ASSERT_EQ(to_vector(other), (std::vector<int>{1, 2, 3}));
+    }
+
+    TEST(list_pool, steady_state_push_pop_doesnt_allocate) {
+        allocation_stats stats;
+        saxion::list<int, tracking_allocator<int>> lst({&stats, 1});
+        lst.reserve(16);
+        auto allocations = stats.allocations;
+
+        for (int round = 0; round < 1000; ++round) {
+            for (int i = 0; i < 16; ++i) {
+                lst.push_back(i);
+            }
+            while (!lst.empty()) {
+                lst.pop_front();
+            }
+        }
+
+        ASSERT_EQ(stats.allocations, allocations) << "Recycled nodes should be reused without allocating";
+    }
+
+    TEST(list_pool, reserve_allocates_once) {
+        allocation_stats stats;
+        saxion::list<std::string, tracking_allocator<std::string>> lst({&stats, 1});
+        lst.reserve(1000);
+        ASSERT_EQ(stats.allocations, 1) << "reserve() should allocate all the nodes at once";
+        ASSERT_GE(lst.capacity(), 1000);
+
+        for (int i = 0; i < 1000; ++i) {
+            lst.push_back(std::to_string(i));
+        }
+        ASSERT_EQ(stats.allocations, 1) << "No allocations expected within the reserved capacity";
+        ASSERT_EQ(lst.size(), 1000);
+        ASSERT_EQ(lst.front(), "0");
+        ASSERT_EQ(lst.back(), "999");
+
+        lst.reserve(10);
+        ASSERT_EQ(stats.allocations, 1) << "reserve() should never shrink";
+    }
+
+    TEST(list_pool, range_construction_allocates_once) {
+        allocation_stats stats;
+        std::vector<int> values(5000, 7);
+        saxion::list<int, tracking_allocator<int>> lst(values.begin(), values.end(), {&stats, 1});
+        ASSERT_EQ(stats.allocations, 1) << "Constructing from a forward range should allocate all the nodes at once";
+
+        saxion::list<int, tracking_allocator<int>> copy(lst, {&stats, 2});
+        ASSERT_EQ(stats.allocations, 2) << "Copying should allocate all the nodes at once";
+
+        lst.insert(lst.begin(), values.begin(), values.end());
+        ASSERT_EQ(stats.allocations, 3) << "Inserting a forward range should grow the pool at most once";
+        ASSERT_EQ(lst.size(), 10000);
+    }
+
+    TEST(list_pool, small_range_inserts_grow_geometrically) {
+        allocation_stats pushed;
+        saxion::list<int, tracking_allocator<int>> reference({&pushed, 1});
+        for (int i = 0; i < 1000; ++i) {
+            reference.push_back(i);
+        }
+
+        allocation_stats appended;
+        saxion::list<int, tracking_allocator<int>> lst({&appended, 2});
+        for (int i = 0; i < 1000; ++i) {
+            lst.append_range(std::vector<int>{i});
+        }
+        ASSERT_EQ(appended.allocations, pushed.allocations) << "Appending one element at a time should grow the pool like push_back";
+        ASSERT_EQ(lst.capacity(), reference.capacity());
+
+        allocation_stats inserted;
+        saxion::list<int, tracking_allocator<int>> other({&inserted, 3});
+        for (int i = 0; i < 1000; ++i) {
+            other.insert(other.begin(), 1, i);
+        }
+        ASSERT_EQ(inserted.allocations, pushed.allocations) << "Inserting copies one at a time should grow the pool like push_back";
+        ASSERT_EQ(other.memory_usage().slabs, reference.memory_usage().slabs);
+    }
+
+    TEST(list_pool, capacity_survives_clear) {
+        saxion::list<int> lst;
+        for (int i = 0; i < 100; ++i) {
+            lst.push_back(i);
+        }
+        auto capacity = lst.capacity();
+        ASSERT_GE(capacity, 100);
+
+        lst.clear();
+        ASSERT_TRUE(lst.empty());
+        ASSERT_EQ(lst.capacity(), capacity) << "clear() should keep the nodes for reuse";
+    }
+
+    TEST(list_pool, erased_nodes_are_recycled) {
+        saxion::list<int> lst{1, 2, 3, 4};
+        auto capacity = lst.capacity();
+        auto second = lst.begin();
+        ++second;
+        auto address = second.node();
+
+        lst.erase(second);
+        auto inserted = lst.insert(lst.begin(), 42);
+        ASSERT_EQ(inserted.node(), address) << "The most recently erased node should be reused first";
+        ASSERT_EQ(lst.capacity(), capacity);
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{42, 1, 3, 4}));
+    }
+
+    TEST(list_pool, shrink_to_fit) {
+        allocation_stats stats;
+        {
+            saxion::list<int, tracking_allocator<int>> lst({&stats, 1});
+            lst.reserve(10);
+            lst.reserve(1000);
+            ASSERT_EQ(stats.allocations, 2);
+
+            for (int i = 0; i < 5; ++i) {
+                lst.push_back(i);
+            }
+
+            lst.shrink_to_fit();
+            ASSERT_GE(lst.capacity(), 10) << "The slab with elements should be kept";
+            ASSERT_LT(lst.capacity(), 1000) << "The slab without elements should be released";
+            ASSERT_EQ(to_vector(lst), (std::vector<int>{0, 1, 2, 3, 4}));
+
+            lst.clear();
+            lst.shrink_to_fit();
+            ASSERT_EQ(lst.capacity(), 0);
+            ASSERT_EQ(stats.allocations, stats.deallocations);
+
+            lst.push_back(7);
+            ASSERT_EQ(lst.front(), 7);
+        }
+        ASSERT_EQ(stats.allocations, stats.deallocations);
+    }
+
+    TEST(list_pool, move_takes_the_slabs) {
+        allocation_stats stats;
+        saxion::list<int, tracking_allocator<int>> lst({&stats, 1});
+        lst.reserve(100);
+        lst.push_back(1);
+
+        auto moved(std::move(lst));
+        ASSERT_GE(moved.capacity(), 100);
+        ASSERT_EQ(lst.capacity(), 0);
+        ASSERT_EQ(to_vector(moved), (std::vector<int>{1}));
+
+        lst.push_back(2);
+        lst.swap(moved);
+        ASSERT_EQ(to_vector(lst), (std::vector<int>{1}));
+        ASSERT_GE(lst.capacity(), 100);
+        ASSERT_EQ(to_vector(moved), (std::vector<int>{2}));
+    }
+
+    TEST(list_allocator, pmr_elements_use_the_list_resource) {
+        counting_resource resource;
+        saxion::pmr::list<std::pmr::string> lst(&resource);
+
+        lst.emplace_back("a string that is far too long for the small string optimization");
+        lst.push_back(std::pmr::string("another string that is far too long for the small string buffer"));
+
+        for (auto& str : lst) {
+            ASSERT_EQ(str.get_allocator().resource(), &resource)
+                                        << "The elements should be constructed with the allocator of the list";
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "list.h"
+
+namespace {
+
+    TEST(list_memory, empty) {
+        saxion::list<int> lst;
+        auto usage = lst.memory_usage();
+        ASSERT_EQ(usage.elements, 0);
+        ASSERT_EQ(usage.slabs, 0);
+        ASSERT_EQ(usage.allocated_bytes(), 0);
+        ASSERT_EQ(usage.total_bytes(), sizeof(lst));
+
+        auto report = lst.locality_report();
+        ASSERT_EQ(report.links, 0);
+        ASSERT_EQ(report.fragmentation(), 0);
+    }
+
+    TEST(list_memory, nodes) {
+        saxion::list<std::uint32_t> lst;
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            lst.push_back(i);
+        }
+        auto usage = lst.memory_usage();
+        ASSERT_EQ(usage.elements, 1000);
+        ASSERT_EQ(usage.link_bytes, 1000 * 2 * sizeof(void*));
+        ASSERT_EQ(usage.value_bytes, 1000 * sizeof(std::uint32_t));
+        ASSERT_EQ(usage.node_bytes() % 1000, 0);
+        ASSERT_EQ(usage.padding_bytes, 1000 * (usage.node_bytes() / 1000 - 2 * sizeof(void*) - sizeof(std::uint32_t)));
+        ASSERT_EQ(usage.heap_bytes, 0);
+        ASSERT_GT(usage.slabs, 0);
+
+        auto node_size = usage.node_bytes() / 1000;
+        ASSERT_EQ(usage.allocated_bytes(), (lst.capacity() + usage.slabs) * node_size)
+            << "Every slot of every slab, including the headers, should be accounted for";
+
+        lst.reserve(5000);
+        auto reserved = lst.memory_usage();
+        ASSERT_EQ(reserved.node_bytes(), usage.node_bytes());
+        ASSERT_EQ(reserved.slack_bytes, (lst.capacity() - 1000 + reserved.slabs) * node_size);
+    }
+
+    TEST(list_memory, heap) {
+        saxion::list<std::string> lst;
+        lst.push_back("short");
+        ASSERT_EQ(lst.memory_usage().heap_bytes, 0) << "A small string owns no memory";
+
+        std::string big(1000, 'x');
+        lst.push_back(big);
+        lst.push_back(big);
+        ASSERT_GE(lst.memory_usage().heap_bytes, 2 * 1001);
+        ASSERT_LE(lst.memory_usage().heap_bytes, 2 * (big.capacity() + 1));
+
+        saxion::list<std::vector<double>> vectors;
+        vectors.emplace_back(100);
+        ASSERT_EQ(vectors.memory_usage().heap_bytes, vectors.front().capacity() * sizeof(double));
+    }
+
+    TEST(list_memory, locality) {
+        saxion::list<long> lst;
+        for (long i = 0; i < 10'000; ++i) {
+            lst.push_back(i);
+        }
+        auto in_order = lst.locality_report();
+        ASSERT_EQ(in_order.links, 9'999);
+        ASSERT_LT(in_order.fragmentation(), 0.01) << "Only the jumps between slabs should leave the next slot";
+        ASSERT_LT(in_order.page_jumps(), 0.05);
+
+        std::mt19937 rng(7);
+        std::vector<std::uint32_t> keys(lst.size());
+        for (auto& key : keys) {
+            key = static_cast<std::uint32_t>(rng());
+        }
+        lst.sort([&keys](long a, long b) { return keys[static_cast<std::size_t>(a)] < keys[static_cast<std::size_t>(b)]; });
+        auto shuffled = lst.locality_report();
+        ASSERT_GT(shuffled.fragmentation(), 0.95);
+        ASSERT_GT(shuffled.page_jumps(), 0.5);
+        ASSERT_GT(shuffled.backward, 1000);
+        ASSERT_GT(shuffled.mean_log2_distance, in_order.mean_log2_distance);
+
+        // a copy takes its nodes in order again
+        saxion::list<long> copy(lst);
+        ASSERT_LT(copy.locality_report().fragmentation(), 0.01);
+    }
+}
@@ -0,0 +1,76 @@
+#define SAXION_LIST_STATS
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+#include "list_stats.h"
+
+namespace {
+
+    TEST(list_stats, copies_and_moves) {
+        saxion::counted_list<std::string> lst;
+        std::string value = "a string too long for the small string buffer";
+        lst.push_back(value);
+        lst.push_back(std::as_const(value));
+        lst.push_back(std::move(value));
+        lst.push_back(std::string(10, 'x'));
+        lst.emplace_back(3, 'y');
+        lst.push_front(lst.front());
+
+        auto stats = saxion::stats(lst);
+        ASSERT_EQ(stats.element_copies, 3);
+        ASSERT_EQ(stats.element_moves, 2);
+        ASSERT_EQ(stats.node_allocations, 6) << "emplace_back neither copies nor moves, but takes a node";
+    }
+
+    TEST(list_stats, walks) {
+        saxion::counted_list<int> lst{1, 2, 3, 4, 5};
+        ASSERT_EQ(lst[0], 1);
+        ASSERT_EQ(saxion::stats(lst).walks, 0) << "The head is reached without walking";
+
+        ASSERT_EQ(lst[4], 5);
+        ASSERT_EQ(std::as_const(lst)[2], 3);
+        ASSERT_EQ(lst.at(3), 4);
+        ASSERT_THROW((void) lst.at(5), std::length_error);
+        auto stats = saxion::stats(lst);
+        ASSERT_EQ(stats.walks, 3);
+        ASSERT_EQ(stats.nodes_visited, 9);
+
+        lst.observer().reset();
+        ASSERT_EQ(saxion::stats(lst).walks, 0);
+    }
+
+    TEST(list_stats, node_frees) {
+        saxion::counted_list<int> lst{1, 2, 3, 4, 5, 6};
+        lst.pop_back();
+        lst.pop_front();
+        lst.erase(lst.begin());
+        ASSERT_EQ(saxion::stats(lst).node_frees, 3);
+        lst.clear();
+        ASSERT_EQ(saxion::stats(lst).node_frees, 6);
+        ASSERT_EQ(saxion::stats(lst).node_allocations, 6);
+    }
+
+    TEST(list_stats, global) {
+        using global_list = saxion::list<std::string, std::allocator<std::string>, saxion::global_stats_observer>;
+        saxion::global_stats_observer::reset();
+        {
+            global_list a{"a", "b"};
+            global_list b(a);
+            b.push_back("c");
+        }
+        auto stats = saxion::global_stats_observer::stats();
+        ASSERT_EQ(stats.node_allocations, 5);
+        ASSERT_EQ(stats.node_frees, 5) << "Destroying a list frees its nodes";
+        ASSERT_EQ(stats.element_copies, 2) << "Only the copy constructor copies, the strings are made from const char*";
+        ASSERT_EQ(stats.element_moves, 1);
+    }
+
+    TEST(list_stats, without_counters) {
+        saxion::list<int> lst{1, 2, 3};
+        (void) lst[2];
+        auto stats = saxion::stats(lst);
+        ASSERT_EQ(stats.walks, 0);
+        ASSERT_EQ(stats.node_allocations, 0);
+    }
+}
@@ -2,6 +2,9 @@
 #include <vector>
 #include <string>
 #include <random>
+#include <ranges>
+#include <cstdint>
+#include <stdexcept>
 
 #include "list.h"
 
@@ -37,7 +40,6 @@ namespace {
                                     << "Type inference from a std::initializer list failed.";
     }
 
-    /*
     TEST(list_constructors, initializer_list) {
         saxion::list lsti{1.0, 2.0, 3.0};
         ASSERT_EQ(lsti.size(), 3) << "Number of elements of a list initialized from std::initializer_list is wrong.";
@@ -45,7 +47,6 @@ namespace {
         ASSERT_FLOAT_EQ(lsti.front(), 1.0) << "The front() element should be: " << 1.0 << ".";
         ASSERT_FLOAT_EQ(lsti.back(), 3.0) << "The back() element should be: " << 3.0 << ".";
     }
-    */
     TEST(list_constructors, copy) {
         saxion::list lst(names);
         ASSERT_EQ(lst.size(), names.size());
@@ -386,26 +387,171 @@ namespace {
         }
     }
 
-    /*
     TEST(list_modifiers, emplace) {
         saxion::list lst(names);
-        auto element = lst.emplace_back(25, 'a');
+        auto& back = lst.emplace_back(25, 'a');
         ASSERT_EQ(lst.size(), names.size() + 1) << "Size should increment";
         ASSERT_EQ(lst.back(), std::string(25, 'a')) << "The last element should be constructed in-place and equal to: "
                                                     << std::string(25, 'a');
-        ++element;
-        ASSERT_EQ(element, lst.end()) << "The returned iterator should point to the last element";
+        ASSERT_EQ(&back, &lst.back()) << "The returned reference should refer to the last element";
 
-        element = lst.emplace(lst.begin(), 10, 'z');
+        auto element = lst.emplace(lst.begin(), 10, 'z');
         ASSERT_EQ(lst.size(), names.size() + 2) << "Size should increment";
         ASSERT_EQ(lst.front(), std::string(10, 'z')) << "The last element should be constructed in-place and equal to: "
                                                      << std::string(10, 'z');
 
         ASSERT_EQ(element, lst.begin()) << "The returned iterator should point to the first element";
+
+        auto& front = lst.emplace_front(3, 'x');
+        ASSERT_EQ(lst.size(), names.size() + 3) << "Size should increment";
+        ASSERT_EQ(lst.front(), std::string(3, 'x'));
+        ASSERT_EQ(&front, &lst.front()) << "The returned reference should refer to the first element";
+    }
+
+    /// counts the constructions of its instances
+    struct counted {
+        static inline int copies{};
+        static inline int moves{};
+
+        int a;
+        std::string b;
+
+        counted(int a_, std::string b_) : a{a_}, b{std::move(b_)} {}
+        counted(const counted& other) : a{other.a}, b{other.b} { ++copies; }
+        counted(counted&& other) noexcept : a{other.a}, b{std::move(other.b)} { ++moves; }
+
+        static void reset() {
+            copies = moves = 0;
+        }
+    };
+
+    TEST(list_modifiers, emplace_constructs_in_place) {
+        counted::reset();
+        saxion::list<counted> lst;
+        lst.emplace_back(1, "one");
+        lst.emplace_front(0, "zero");
+        lst.emplace(++lst.begin(), 2, "two");
+
+        ASSERT_EQ(counted::copies, 0) << "Emplacing shouldn't copy the element";
+        ASSERT_EQ(counted::moves, 0) << "Emplacing shouldn't move the element";
+        ASSERT_EQ(lst.front().b, "zero");
+        ASSERT_EQ(lst[1].b, "two");
+        ASSERT_EQ(lst.back().b, "one");
+
+        counted value{3, "three"};
+        lst.push_back(std::move(value));
+        lst.push_front(value);
+        ASSERT_EQ(counted::moves, 1) << "push_back(T&&) should move exactly once";
+        ASSERT_EQ(counted::copies, 1) << "push_front(const T&) should copy exactly once";
+    }
+
+    /// can be neither copied nor moved
+    struct immovable {
+        int value;
+
+        explicit immovable(int v) : value{v} {}
+        immovable(const immovable&) = delete;
+        immovable& operator=(const immovable&) = delete;
+    };
+
+    TEST(list_modifiers, emplace_immovable) {
+        saxion::list<immovable> lst;
+        lst.emplace_back(2);
+        lst.emplace_front(0);
+        lst.emplace(++lst.begin(), 1);
+        lst.emplace(lst.end(), 3);
+
+        ASSERT_EQ(lst.size(), 4);
+        int expected = 0;
+        for (auto& el : lst) {
+            ASSERT_EQ(el.value, expected++);
+        }
+        lst.pop_front();
+        lst.erase(lst.begin());
+        ASSERT_EQ(lst.front().value, 2);
+    }
+
+    /// throws from its constructor when asked to
+    struct throwing {
+        static inline int alive{};
+
+        explicit throwing(bool fail) {
+            if (fail) {
+                throw std::runtime_error("construction failed");
+            }
+            ++alive;
+        }
+
+        ~throwing() {
+            --alive;
+        }
+    };
+
+    TEST(list_modifiers, emplace_throwing) {
+        {
+            saxion::list<throwing> lst;
+            lst.emplace_back(false);
+            ASSERT_THROW(lst.emplace_back(true), std::runtime_error);
+            ASSERT_THROW(lst.emplace_front(true), std::runtime_error);
+            ASSERT_EQ(lst.size(), 1) << "A failed emplace shouldn't change the list";
+            ASSERT_EQ(throwing::alive, 1);
+            lst.emplace_back(false);
+            ASSERT_EQ(lst.size(), 2);
+        }
+        ASSERT_EQ(throwing::alive, 0);
     }
-    */
 
-    /*
+    TEST(list_modifiers, insert_ranges) {
+        saxion::list<int> lst{1, 5};
+        std::vector<int> middle{2, 3, 4};
+
+        auto first = lst.insert(++lst.begin(), middle.begin(), middle.end());
+        ASSERT_EQ(*first, 2) << "insert should return an iterator to the first inserted element";
+        ASSERT_EQ(lst.size(), 5);
+
+        auto copies = lst.insert(lst.end(), 3, 9);
+        ASSERT_EQ(*copies, 9);
+        ASSERT_EQ(lst.size(), 8);
+
+        lst.insert(lst.begin(), {-1, 0});
+        ASSERT_EQ(std::vector<int>(lst.begin(), lst.end()), (std::vector<int>{-1, 0, 1, 2, 3, 4, 5, 9, 9, 9}));
+
+        auto pos = lst.insert(lst.begin(), middle.begin(), middle.begin());
+        ASSERT_EQ(pos, lst.begin()) << "Inserting an empty range should return pos";
+        ASSERT_EQ(*(--lst.end()), 9) << "The backward links should be consistent";
+    }
+
+    TEST(list_modifiers, append_and_prepend_ranges) {
+        saxion::list<std::string> lst{"c"};
+        lst.append_range(std::vector<std::string>{"d", "e"});
+        lst.prepend_range(std::vector<std::string>{"a", "b"});
+        auto it = lst.insert_range(std::next(lst.begin(), 3), std::views::iota(0, 2) |
+                                                            std::views::transform([](int i) { return std::to_string(i); }));
+        ASSERT_EQ(*it, "0");
+        ASSERT_EQ(std::vector<std::string>(lst.begin(), lst.end()),
+                  (std::vector<std::string>{"a", "b", "c", "0", "1", "d", "e"}));
+        ASSERT_EQ(lst.size(), 7);
+    }
+
+    TEST(list_modifiers, insert_range_throwing) {
+        throwing::alive = 0;
+        {
+            saxion::list<throwing> lst;
+            lst.emplace_back(false);
+            std::vector<bool> fail{false, false, true, false};
+            ASSERT_THROW(lst.insert_range(lst.begin(), fail), std::runtime_error);
+            ASSERT_EQ(lst.size(), 1) << "A failed range insertion shouldn't change the list";
+            ASSERT_EQ(throwing::alive, 1) << "The elements constructed so far should be destroyed";
+        }
+        ASSERT_EQ(throwing::alive, 0);
+    }
+
+    TEST(list_constructors, initializer_list_copies_once) {
+        counted::reset();
+        saxion::list<counted> lst{counted{1, "one"}, counted{2, "two"}};
+        ASSERT_EQ(counted::copies, 2) << "Every element of the initializer list should be copied exactly once";
+        ASSERT_EQ(counted::moves, 0);
+    }
 
     TEST(list_iterators, iterators) {
         saxion::list lst(names);
@@ -447,9 +593,7 @@ namespace {
         } while (el_names != names.begin());
 #endif
     }
-    */
 
-    /*
     TEST(list_modifiers, erase) {
         saxion::list lst(names);
         auto size = lst.size();
@@ -503,9 +647,7 @@ namespace {
             --names_element;
         }
     }
-    */
 
-    /*
     TEST(list_modifiers, insert) {
         saxion::list lst(names);
         auto pos = lst.begin();
@@ -549,5 +691,11 @@ namespace {
         ASSERT_TRUE(name.empty()) << "The moved from object should be empty";
 
     }
-    */
-}
\ No newline at end of file
+
+    TEST(list_nodes, layout) {
+        ASSERT_FALSE(std::is_polymorphic_v<saxion::detail::list_node<int>>) << "The nodes shouldn't carry a vtable";
+        ASSERT_EQ(sizeof(saxion::detail::list_node<std::int64_t>), 2 * sizeof(void*) + sizeof(std::int64_t))
+                                    << "A node should be just two links and the value";
+        ASSERT_TRUE(std::is_trivially_destructible_v<saxion::detail::list_node<int>>);
+    }
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "list_trace.h"
+
+namespace {
+
+    using saxion::trace_op;
+    using saxion::trace_record;
+
+    /// counts the calls of every hook
+    struct counting_observer : saxion::list_observer {
+        int inserted{};
+        int pushed_back{};
+        int erased{};
+        int clears{};
+        int copy_assigns{};
+        int move_assigns{};
+        int copies{};
+        int moves{};
+
+        template<typename List>
+        void on_insert(const List&, typename List::const_iterator, std::size_t count) noexcept {
+            inserted += static_cast<int>(count);
+        }
+
+        template<typename List>
+        void on_push_back(const List&) noexcept { ++pushed_back; }
+
+        template<typename List>
+        void on_erase(const List&, typename List::const_iterator, std::size_t count) noexcept {
+            erased += static_cast<int>(count);
+        }
+
+        template<typename List>
+        void on_clear(const List&) noexcept { ++clears; }
+
+        template<typename List>
+        void on_copy_assign(const List&, const List&) noexcept { ++copy_assigns; }
+
+        template<typename List>
+        void on_move_assign(const List&, const List&) noexcept { ++move_assigns; }
+
+        template<typename List>
+        void on_copied(const List&) noexcept { ++copies; }
+
+        template<typename List>
+        void on_moved(const List&) noexcept { ++moves; }
+    };
+
+    TEST(list_observer, default_observer_is_free) {
+        // a recorder holds one pointer, the empty default observer should take no space at all
+        ASSERT_EQ(sizeof(saxion::list<int>) + sizeof(void*), sizeof(saxion::recorded_list<int>));
+    }
+
+    TEST(list_observer, hooks) {
+        using observed = saxion::list<std::string, std::allocator<std::string>, counting_observer>;
+        observed lst;
+        lst.push_back("a");
+        lst.emplace_back("b");
+        lst.push_front("c");
+        lst.emplace_front("d");
+        lst.insert(lst.begin(), {"e", "f"});
+        lst.append_range(std::vector<std::string>{"g", "h", "i"});
+        lst.insert(lst.end(), 0, "nothing");
+        ASSERT_EQ(lst.observer().inserted, 9) << "An empty insert should not be reported";
+        lst.insert(lst.end(), "j");
+        ASSERT_EQ(lst.observer().pushed_back, 2) << "Only push_back and emplace_back are appends by push_back";
+
+        lst.pop_back();
+        lst.pop_front();
+        lst.erase(lst.begin());
+        ASSERT_EQ(lst.observer().erased, 3);
+
+        observed copy(lst);
+        ASSERT_EQ(lst.observer().copies, 1);
+        ASSERT_EQ(copy.observer().inserted, 0) << "Building the copy is not an insert";
+        copy = lst;
+        ASSERT_EQ(copy.observer().copy_assigns, 1);
+        ASSERT_EQ(copy.observer().clears, 0) << "The clear in the assignment is part of the assignment";
+        ASSERT_EQ(lst.observer().copies, 2);
+
+        observed moved(std::move(copy));
+        ASSERT_EQ(copy.observer().moves, 1);
+        ASSERT_EQ(moved.observer().inserted, 0) << "Every list has its own observer";
+        copy = std::move(moved);
+        ASSERT_EQ(copy.observer().move_assigns, 1);
+        ASSERT_EQ(moved.observer().moves, 1);
+
+        lst.clear();
+        ASSERT_EQ(lst.observer().clears, 1);
+    }
+
+    TEST(list_trace, records) {
+        saxion::list_trace trace;
+        saxion::recorded_list<int> lst;
+        lst.push_back(0);
+        ASSERT_EQ(trace.size(), 0) << "Nothing is recorded before a trace is attached";
+
+        lst.observer().attach(trace);
+        lst.push_back(1);
+        lst.push_front(2);
+        lst.insert(std::next(lst.begin(), 2), {3, 4});
+        lst.erase(std::next(lst.begin(), 3));
+        lst.pop_front();
+        lst.pop_back();
+        auto copy = lst;
+        lst = copy;
+        lst.clear();
+        lst = std::move(copy);
+        auto moved = std::move(lst);
+        lst.observer().detach();
+        lst.push_back(5);
+
+        std::vector<trace_record> expected{
+                {trace_op::push_back, 1, 1, 1},
+                {trace_op::push_front, 0, 1, 2},
+                {trace_op::insert, 2, 2, 3},
+                {trace_op::erase, 3, 1, 5},
+                {trace_op::pop_front, 0, 1, 4},
+                {trace_op::pop_back, 2, 1, 3},
+                {trace_op::copied, 0, 2, 2},
+                {trace_op::copy_assign, 0, 2, 2},
+                {trace_op::clear, 0, 2, 2},
+                {trace_op::move_assign, 0, 2, 0},
+                {trace_op::moved, 0, 2, 2},
+        };
+        ASSERT_EQ(trace.records(), expected);
+        ASSERT_EQ(trace.size(), expected.size());
+        ASSERT_EQ(trace.dropped(), 0);
+    }
+
+    TEST(list_trace, save_load) {
+        saxion::list_trace trace;
+        saxion::recorded_list<long> lst;
+        lst.observer().attach(trace);
+        for (long i = 0; i < 100'000; ++i) {
+            lst.push_back(i);
+        }
+        lst.insert(std::next(lst.begin(), 60'000), 3, -1);
+        ASSERT_LT(trace.bytes(), 4 * trace.size()) << "The records should be compact";
+
+        auto path = std::filesystem::temp_directory_path() / "saxion_list_trace_test.trace";
+        trace.save(path);
+        auto loaded = saxion::list_trace::load(path);
+        ASSERT_EQ(loaded.size(), trace.size());
+        ASSERT_EQ(loaded.records(), trace.records());
+        ASSERT_EQ(loaded.records().back(), (trace_record{trace_op::insert, 60'000, 3, 100'000}));
+
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "not a trace";
+        }
+        ASSERT_THROW((void) saxion::list_trace::load(path), std::system_error);
+        std::filesystem::remove(path);
+        ASSERT_THROW((void) saxion::list_trace::load(path), std::system_error);
+    }
+
+    template<typename Container>
+    std::vector<int> replayed(const saxion::list_trace& trace) {
+        Container c;
+        saxion::replay(trace, c, [](std::size_t n) { return static_cast<int>(n); });
+        return {c.begin(), c.end()};
+    }
+
+    TEST(list_trace, replay) {
+        saxion::list_trace trace;
+        saxion::recorded_list<int> lst;
+        lst.observer().attach(trace);
+        // the same values the replay makes, in the same order, so the results can be compared
+        int next = 0;
+        for (int i = 0; i < 50; ++i) {
+            lst.push_back(next++);
+            if (i % 3 == 0) {
+                lst.push_front(next++);
+            }
+            if (i % 7 == 0) {
+                lst.insert(std::next(lst.begin(), static_cast<long>(lst.size()) / 2), 2, next);
+                next += 2;
+            }
+            if (i % 5 == 0) {
+                lst.erase(std::next(lst.begin(), static_cast<long>(lst.size()) / 3));
+                lst.pop_back();
+            }
+        }
+        auto copy = lst;
+        lst.clear();
+        lst = copy;
+
+        std::vector<int> expected(lst.begin(), lst.end());
+        ASSERT_EQ(replayed<saxion::list<int>>(trace), expected);
+        ASSERT_EQ(replayed<std::list<int>>(trace), expected);
+        ASSERT_EQ(replayed<std::deque<int>>(trace), expected);
+        ASSERT_EQ(replayed<std::vector<int>>(trace), expected);
+    }
+}
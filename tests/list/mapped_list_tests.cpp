@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "mapped_list.h"
+
+namespace {
+
+    /// a file in the temporary directory, removed at the end of the test
+    struct temp_file {
+        std::filesystem::path path_;
+
+        explicit temp_file(const char* test) :
+            path_{std::filesystem::temp_directory_path() /
+                  ("saxion_mapped_list_" + std::string(test) + "_" + std::to_string(::getpid()))} {
+            std::filesystem::remove(path_);
+        }
+
+        ~temp_file() {
+            std::filesystem::remove(path_);
+        }
+    };
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    /**
+     * checks the links in both directions and the invariant of the crash test: consecutive values, where a value may
+     * be repeated (a child was killed between the two steps of moving it)
+     */
+    void check_consecutive(const saxion::mapped_list<long>& lst) {
+        std::size_t forward = 0;
+        long previous = lst.empty() ? 0 : lst.front() - 1;
+        for (auto v : lst) {
+            ASSERT_TRUE(v == previous + 1 || v == previous) << v << " follows " << previous;
+            previous = v;
+            ++forward;
+        }
+        std::size_t backward = 0;
+        for (auto it = lst.rbegin(); it != lst.rend(); ++it) {
+            ++backward;
+        }
+        ASSERT_EQ(forward, lst.size());
+        ASSERT_EQ(backward, lst.size());
+    }
+
+    TEST(mapped_list, persists) {
+        temp_file file("persists");
+        {
+            saxion::mapped_list<int> lst(file.path_, 4);
+            ASSERT_TRUE(lst.empty());
+            ASSERT_FALSE(lst.recovered());
+            for (int i = 0; i < 100; ++i) {
+                lst.push_back(i);
+            }
+            ASSERT_GE(lst.capacity(), 100) << "The file should grow";
+            lst.push_front(-1);
+            lst.pop_back();
+            auto it = lst.insert(std::next(lst.begin()), 1000);
+            ASSERT_EQ(*it, 1000);
+            ASSERT_EQ(*lst.erase(it), 0);
+            lst.front() = -2;
+            lst.checkpoint();
+        }
+        {
+            saxion::mapped_list<int> lst(file.path_);
+            ASSERT_FALSE(lst.recovered());
+            ASSERT_EQ(lst.size(), 100);
+            ASSERT_EQ(lst.front(), -2);
+            ASSERT_EQ(lst.back(), 98);
+            auto values = to_vector(lst);
+            for (int i = 0; i < 99; ++i) {
+                ASSERT_EQ(values[static_cast<std::size_t>(i) + 1], i);
+            }
+
+            auto capacity = lst.capacity();
+            lst.clear();
+            ASSERT_TRUE(lst.empty());
+            for (int i = 0; i < 100; ++i) {
+                lst.push_back(i);
+            }
+            ASSERT_EQ(lst.capacity(), capacity) << "The cleared nodes should be reused";
+        }
+    }
+
+    TEST(mapped_list, open_errors) {
+        temp_file file("errors");
+        {
+            saxion::mapped_list<long> lst(file.path_);
+            ASSERT_THROW(saxion::mapped_list<long>{file.path_}, std::system_error) << "The file should be locked";
+        }
+        ASSERT_THROW(saxion::mapped_list<char>{file.path_}, std::system_error) << "The element type should be checked";
+        ASSERT_NO_THROW(saxion::mapped_list<long>{file.path_});
+    }
+
+    TEST(mapped_list, reopen_is_constant_time) {
+        temp_file file("reopen");
+        constexpr std::size_t n = 1'000'000;
+        {
+            saxion::mapped_list<long> lst(file.path_);
+            lst.reserve(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                lst.push_back(static_cast<long>(i));
+            }
+        }
+        auto start = std::chrono::steady_clock::now();
+        saxion::mapped_list<long> lst(file.path_);
+        ASSERT_EQ(lst.size(), n);
+        ASSERT_EQ(lst.back(), static_cast<long>(n) - 1);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        ASSERT_LT(elapsed, std::chrono::milliseconds(100)) << "Reopening shouldn't touch the nodes";
+    }
+
+    TEST(mapped_list, killed_mid_write) {
+        temp_file file("killed");
+        std::mt19937 rng(18);
+        std::uniform_int_distribution<int> delay_us(0, 3000);
+        int recovered = 0;
+
+        for (int round = 0; round < 30; ++round) {
+            pid_t child = ::fork();
+            if (child == 0) {
+                // appends consecutive values, pops from the front, and now and then clears or moves a value
+                saxion::mapped_list<long> lst(file.path_, 16);
+                long next = lst.empty() ? 0 : lst.back() + 1;
+                for (long i = 0;; ++i) {
+                    lst.push_back(next++);
+                    if (lst.size() > 2000) {
+                        lst.pop_front();
+                    }
+                    if (i % 7 == 0 && lst.size() > 2) {
+                        // moves the second value into a new node: inserts a copy, then erases the original
+                        auto it = std::next(lst.begin());
+                        lst.insert(it, *it);
+                        lst.erase(it);
+                    }
+                    if (i % 5000 == 4999) {
+                        lst.clear();
+                    }
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(delay_us(rng)));
+            ::kill(child, SIGKILL);
+            int status = 0;
+            ::waitpid(child, &status, 0);
+            ASSERT_TRUE(WIFSIGNALED(status));
+
+            saxion::mapped_list<long> lst(file.path_);
+            check_consecutive(lst);
+            recovered += lst.recovered();
+            if (HasFatalFailure()) {
+                return;
+            }
+        }
+        // how often the redo log was needed, typically a few of the 30 kills
+        RecordProperty("interrupted_changes", recovered);
+    }
+}
@@ -0,0 +1,309 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "list_stats.h"
+#include "list_trace.h"
+#include "parallel.h"
+
+namespace {
+
+    namespace ex = saxion::execution;
+
+    constexpr std::size_t n = 100'000;
+
+    saxion::list<long> iota_list(std::size_t count) {
+        saxion::list<long> lst;
+        for (std::size_t i = 0; i < count; ++i) {
+            lst.push_back(static_cast<long>(i));
+        }
+        return lst;
+    }
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    TEST(parallel, for_each) {
+        auto lst = iota_list(n);
+        saxion::for_each(ex::par(4), lst, [](long& v) { v *= 2; });
+        long expected = 0;
+        for (auto v : lst) {
+            ASSERT_EQ(v, expected);
+            expected += 2;
+        }
+
+        std::atomic<long> calls{};
+        saxion::for_each(ex::seq, lst, [&](long) { ++calls; });
+        saxion::for_each(ex::par(64), saxion::list<long>{1, 2, 3}, [&](long) { ++calls; });
+        ASSERT_EQ(calls, static_cast<long>(n) + 3) << "More threads than elements should still visit every element once";
+        saxion::for_each(ex::par, saxion::list<long>{}, [&](long) { ++calls; });
+    }
+
+    TEST(parallel, transform) {
+        auto lst = iota_list(n);
+        saxion::list<std::string> out;
+        for (std::size_t i = 0; i < n; ++i) {
+            out.emplace_back();
+        }
+        auto end = saxion::transform(ex::par(3), lst, out.begin(), [](long v) { return std::to_string(v); });
+        ASSERT_EQ(end, out.end());
+        std::size_t i = 0;
+        for (const auto& s : out) {
+            ASSERT_EQ(s, std::to_string(i++));
+        }
+
+        // in place
+        saxion::transform(ex::par(3), lst, lst.begin(), [](long v) { return -v; });
+        ASSERT_EQ(lst.back(), -static_cast<long>(n - 1));
+    }
+
+    TEST(parallel, transform_reduce) {
+        auto lst = iota_list(n);
+        auto square = [](long v) { return v * v; };
+        auto expected = saxion::transform_reduce(ex::seq, lst, 0L, std::plus<>{}, square);
+        ASSERT_EQ(saxion::transform_reduce(ex::par(4), lst, 0L, std::plus<>{}, square), expected);
+        ASSERT_EQ(saxion::transform_reduce(ex::par(7), lst, 10L, std::plus<>{}, square), expected + 10);
+
+        // associative, not commutative: the segments have to be combined in order
+        saxion::list<std::string> words{"a", "b", "c", "d", "e", "f", "g", "h", "i"};
+        auto concat = saxion::transform_reduce(ex::par(4), words, std::string{">"}, std::plus<>{}, std::identity{});
+        ASSERT_EQ(concat, ">abcdefghi");
+    }
+
+    TEST(parallel, count_if_find_if) {
+        auto lst = iota_list(n);
+        auto odd = [](long v) { return v % 2 == 1; };
+        ASSERT_EQ(saxion::count_if(ex::par(4), lst, odd), n / 2);
+        ASSERT_EQ(saxion::count_if(ex::seq, lst, odd), n / 2);
+
+        // there are matches in several segments: the first one wins
+        auto it = saxion::find_if(ex::par(4), lst, [](long v) { return v % 10'000 == 9'999; });
+        ASSERT_NE(it, lst.end());
+        ASSERT_EQ(*it, 9'999);
+        ASSERT_EQ(saxion::find_if(ex::par(4), lst, [](long v) { return v < 0; }), lst.end());
+        ASSERT_EQ(*saxion::find_if(ex::par(4), lst, [](long v) { return v == static_cast<long>(n) - 1; }),
+                  static_cast<long>(n) - 1);
+    }
+
+    TEST(parallel, sort) {
+        std::mt19937 rng(19);
+        std::vector<int> values(n);
+        for (auto& v : values) {
+            v = static_cast<int>(rng() % 1000);
+        }
+        saxion::list<std::pair<int, std::size_t>> lst;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            lst.emplace_back(values[i], i);
+        }
+        auto first = lst.begin();
+        auto* first_value = &*first;
+
+        saxion::sort(ex::par(5), lst, std::less<>{}, &std::pair<int, std::size_t>::first);
+        ASSERT_EQ(lst.size(), n);
+        ASSERT_TRUE(std::is_sorted(lst.begin(), lst.end())) << "Equal keys should keep their order (stable)";
+        ASSERT_EQ(&*first, first_value) << "The nodes should be relinked, not copied";
+
+        std::size_t backward = 0;
+        for (auto it = lst.end(); it != lst.begin(); --it) {
+            ++backward;
+        }
+        ASSERT_EQ(backward, n);
+
+        saxion::list<int> small{3, 1, 2};
+        saxion::sort(ex::par(8), small, std::greater<>{});
+        ASSERT_EQ(to_vector(small), (std::vector<int>{3, 2, 1}));
+    }
+
+    TEST(parallel, sort_throwing_comparator_keeps_elements) {
+        auto lst = iota_list(1000);
+        std::reverse(lst.begin(), lst.end());
+        std::atomic<int> comparisons{};
+        ASSERT_THROW(saxion::sort(ex::par(4), lst, [&](long a, long b) {
+            if (++comparisons == 3000) {
+                throw std::runtime_error("comparison failed");
+            }
+            return a < b;
+        }), std::runtime_error);
+
+        ASSERT_EQ(lst.size(), 1000);
+        auto values = to_vector(lst);
+        std::sort(values.begin(), values.end());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            ASSERT_EQ(values[i], static_cast<long>(i)) << "No element should be lost";
+        }
+    }
+
+    TEST(parallel, exceptions) {
+        auto lst = iota_list(1000);
+        ASSERT_THROW(saxion::for_each(ex::par(4), lst, [](long v) {
+            if (v == 900) {
+                throw std::runtime_error("bad element");
+            }
+        }), std::runtime_error);
+    }
+
+    TEST(parallel, executor) {
+        auto lst = iota_list(n);
+        saxion::thread_pool_executor pool(3);
+        auto sum = saxion::transform_reduce(ex::on(pool, 6), lst, 0L, std::plus<>{}, std::identity{});
+        ASSERT_EQ(sum, static_cast<long>(n * (n - 1) / 2));
+        saxion::sort(ex::on(pool, 4), lst, std::greater<>{});
+        ASSERT_EQ(lst.front(), static_cast<long>(n) - 1);
+        ASSERT_THROW(saxion::for_each(ex::on(pool), lst, [](long v) {
+            if (v == 0) {
+                throw std::runtime_error("bad element");
+            }
+        }), std::runtime_error);
+    }
+
+    /// throws when the n-th copy is made
+    struct fragile {
+        static inline std::atomic<int> copies_left{};
+
+        int value;
+
+        explicit fragile(int v) : value{v} {}
+
+        fragile(const fragile& other) : value{other.value} {
+            if (--copies_left == 0) {
+                throw std::runtime_error("copy failed");
+            }
+        }
+    };
+
+    TEST(parallel, copy) {
+        saxion::list<std::string> lst;
+        for (std::size_t i = 0; i < n; ++i) {
+            lst.push_back(std::to_string(i));
+        }
+        auto copy = saxion::copy(ex::par(4), lst);
+        ASSERT_EQ(copy.size(), n);
+        ASSERT_EQ(to_vector(copy), to_vector(lst)) << "The copy should keep the order";
+        ASSERT_EQ(to_vector(saxion::copy(ex::seq, lst)), to_vector(lst));
+        ASSERT_TRUE(saxion::copy(ex::par(4), saxion::list<std::string>{}).empty());
+
+        // the copy is a list like any other
+        copy.push_back("end");
+        copy.pop_front();
+        ASSERT_EQ(copy.front(), "1");
+        ASSERT_EQ(copy.back(), "end");
+    }
+
+    TEST(parallel, copy_allocator) {
+        std::pmr::synchronized_pool_resource resource;
+        saxion::pmr::list<long> lst(&resource);
+        for (long i = 0; i < 1000; ++i) {
+            lst.push_back(i);
+        }
+        // like the copy constructor: select_on_container_copy_construction gives the default resource
+        auto copy = saxion::copy(ex::par(4), lst);
+        ASSERT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+        ASSERT_EQ(to_vector(copy), to_vector(lst));
+
+        auto same = saxion::copy(ex::par(4), lst, lst.get_allocator());
+        ASSERT_EQ(same.get_allocator().resource(), &resource);
+        ASSERT_EQ(to_vector(same), to_vector(lst));
+    }
+
+    TEST(parallel, assign) {
+        auto source = iota_list(n);
+        saxion::list<long> lst{-1, -2, -3};
+        saxion::assign(ex::par(3), lst, source);
+        ASSERT_EQ(to_vector(lst), to_vector(source));
+        saxion::assign(ex::par(3), lst, lst);
+        ASSERT_EQ(lst.size(), n) << "Self-assignment should change nothing";
+
+        saxion::list<long> small{7, 8};
+        saxion::assign(ex::par(3), lst, small);
+        ASSERT_EQ(to_vector(lst), (std::vector<long>{7, 8}));
+    }
+
+    TEST(parallel, make_list) {
+        std::vector<int> values(n);
+        std::iota(values.begin(), values.end(), 0);
+        auto lst = saxion::make_list<long>(ex::par(4), values);
+        ASSERT_EQ(lst.size(), n);
+        long expected = 0;
+        for (auto v : lst) {
+            ASSERT_EQ(v, expected++);
+        }
+    }
+
+    TEST(parallel, copy_throwing_element) {
+        saxion::list<fragile> lst;
+        for (int i = 0; i < 1000; ++i) {
+            lst.emplace_back(i);
+        }
+        fragile::copies_left = 700;
+        ASSERT_THROW((void) saxion::copy(ex::par(4), lst), std::runtime_error);
+        fragile::copies_left = 0;
+        ASSERT_EQ(lst.size(), 1000) << "The source should be untouched";
+    }
+
+    TEST(parallel, observed_lists) {
+        saxion::list_trace trace;
+        saxion::recorded_list<long> lst;
+        lst.observer().attach(trace);
+        for (long i = 0; i < 1000; ++i) {
+            lst.push_back((i * 7919) % 1000);
+        }
+        saxion::sort(ex::par(4), lst);
+        ASSERT_TRUE(std::is_sorted(lst.begin(), lst.end()));
+
+        auto copy = saxion::copy(ex::par(4), lst);
+        ASSERT_EQ(to_vector(copy), to_vector(lst));
+        saxion::recorded_list<long> assigned{1, 2, 3};
+        assigned.observer().attach(trace);
+        saxion::assign(ex::par(4), assigned, copy);
+        ASSERT_EQ(to_vector(assigned), to_vector(lst));
+        auto made = saxion::make_list<long, std::allocator<long>, saxion::trace_recorder>(ex::par(4), to_vector(lst));
+        ASSERT_EQ(to_vector(made), to_vector(lst));
+
+        // the parallel assignment is recorded as a clear and one insert
+        auto records = trace.records();
+        ASSERT_EQ(records.back(), (saxion::trace_record{saxion::trace_op::insert, 0, 1000, 0}));
+        ASSERT_EQ(records[records.size() - 2].op, saxion::trace_op::clear);
+    }
+
+    TEST(parallel, observed_counters) {
+        using counted = saxion::list<long, std::allocator<long>, saxion::stats_observer>;
+        counted lst;
+        for (long i = 0; i < 1000; ++i) {
+            lst.push_back(i);
+        }
+
+        auto sequential = saxion::copy(ex::seq, lst);
+        auto copy = saxion::copy(ex::par(4), lst);
+        ASSERT_EQ(saxion::stats(copy).node_allocations, 1000) << "The nodes built on the workers should be reported";
+        ASSERT_EQ(saxion::stats(copy).element_copies, 1000);
+        ASSERT_EQ(saxion::stats(copy).element_moves, 0);
+        ASSERT_EQ(saxion::stats(copy).node_allocations, saxion::stats(sequential).node_allocations);
+
+        counted assigned{1, 2, 3};
+        saxion::assign(ex::par(4), assigned, lst);
+        auto made = saxion::make_list<long, std::allocator<long>, saxion::stats_observer>(ex::par(4), to_vector(lst));
+        ASSERT_EQ(saxion::stats(made).element_copies, 1000);
+        for (auto* list : {&copy, &assigned, &made}) {
+            list->clear();
+            auto stats = saxion::stats(*list);
+            ASSERT_EQ(stats.node_frees, stats.node_allocations) << "The counters should balance";
+        }
+
+        // counters shared by all the lists see each node once
+        saxion::list<long, std::allocator<long>, saxion::global_stats_observer> global(lst.begin(), lst.end());
+        saxion::global_stats_observer::reset();
+        {
+            auto global_copy = saxion::copy(ex::par(4), global);
+            ASSERT_EQ(saxion::global_stats_observer::stats().node_allocations, 1000);
+        }
+        ASSERT_EQ(saxion::global_stats_observer::stats().node_frees, 1000);
+    }
+}
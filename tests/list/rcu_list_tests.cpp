@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rcu_list.h"
+
+namespace {
+
+    constexpr int n_readers = 3;
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        auto view = lst.read();
+        return {view.begin(), view.end()};
+    }
+
+    /// counts its live instances, to check the reclamation
+    struct tracked {
+        static inline std::atomic<int> alive{};
+
+        int value;
+
+        tracked(int v) : value{v} { ++alive; }
+        tracked(const tracked& other) : value{other.value} { ++alive; }
+        ~tracked() { --alive; }
+
+        bool operator==(const tracked& other) const {
+            return value == other.value;
+        }
+    };
+
+    static_assert(std::forward_iterator<saxion::rcu_list<int>::const_iterator>);
+
+    TEST(rcu_list, single_thread) {
+        saxion::rcu_list<std::string> lst{"b", "c"};
+        ASSERT_EQ(lst.size(), 2);
+        lst.push_front("a");
+        lst.emplace_back(2, 'd');
+        ASSERT_EQ(to_vector(lst), (std::vector<std::string>{"a", "b", "c", "dd"}));
+        ASSERT_TRUE(lst.contains("c"));
+
+        ASSERT_EQ(lst.remove("c"), 1);
+        ASSERT_FALSE(lst.contains("c"));
+        ASSERT_EQ(lst.replace_if([](const std::string& s) { return s.size() == 2; }, "d"), 1);
+        ASSERT_EQ(to_vector(lst), (std::vector<std::string>{"a", "b", "d"}));
+        ASSERT_EQ(lst.size(), 3);
+
+        std::string joined;
+        lst.for_each([&joined](const std::string& s) { joined += s; });
+        ASSERT_EQ(joined, "abd");
+
+        lst.clear();
+        ASSERT_TRUE(lst.empty());
+        ASSERT_EQ(to_vector(lst), std::vector<std::string>{});
+    }
+
+    TEST(rcu_list, reader_keeps_its_snapshot_nodes) {
+        saxion::rcu_list<int> lst{1, 2, 3, 4};
+        auto view = lst.read();
+        auto it = std::find(view.begin(), view.end(), 2);
+
+        lst.remove(2);
+        lst.remove(3);
+        ASSERT_EQ(*it, 2) << "An erased node should stay alive during the read section";
+        ++it;
+        ASSERT_EQ(*it, 3);
+        ++it;
+        ASSERT_EQ(*it, 4) << "A reader on an erased node should find its way back to the list";
+        ASSERT_EQ(++it, view.end());
+    }
+
+    TEST(rcu_list, erased_nodes_are_reclaimed) {
+        {
+            saxion::rcu_list<tracked> lst;
+            for (int i = 0; i < 100; ++i) {
+                lst.push_back(i);
+            }
+            lst.remove_if([](const tracked& t) { return t.value % 2 == 0; });
+            lst.replace_if([](const tracked& t) { return t.value == 1; }, tracked{-1});
+            lst.synchronize();
+            ASSERT_EQ(tracked::alive, 50) << "The erased and replaced nodes should be freed after the grace period";
+        }
+        ASSERT_EQ(tracked::alive, 0);
+    }
+
+    TEST(rcu_list, readers_and_writer) {
+        constexpr int n_values = 64;
+        saxion::rcu_list<int> lst;
+        for (int i = 0; i < n_values; ++i) {
+            lst.push_back(i);
+        }
+
+        std::atomic<bool> done{false};
+        std::atomic<long> traversals{};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < n_readers; ++r) {
+            readers.emplace_back([&] {
+                while (!done.load()) {
+                    int previous = -1;
+                    int count = 0;
+                    for (int value : lst.read()) {
+                        EXPECT_LT(previous, value) << "Every snapshot should be sorted";
+                        previous = value;
+                        ++count;
+                    }
+                    // only the first and the last element can be missing, while they are moved
+                    EXPECT_GE(count, n_values - 2);
+                    ++traversals;
+                }
+            });
+        }
+
+        // every change keeps the list sorted
+        for (int round = 0; round < 5000; ++round) {
+            auto middle = round % (n_values - 2) + 1;
+            lst.replace_if([middle](int v) { return v == middle; }, middle);
+            if (round % 2 == 0) {
+                lst.remove(0);
+                lst.push_front(0);
+            } else {
+                lst.remove(n_values - 1);
+                lst.push_back(n_values - 1);
+            }
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        ASSERT_GT(traversals.load(), 0);
+        ASSERT_EQ(lst.size(), n_values);
+    }
+}
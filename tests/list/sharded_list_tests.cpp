@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "list_trace.h"
+#include "sharded_list.h"
+
+namespace {
+
+    constexpr int n_threads = 4;
+    constexpr int per_thread = 10000;
+
+    struct event {
+        long timestamp;
+        int thread;
+        int sequence;
+    };
+
+    /// counts the copies and moves of its instances
+    struct counted {
+        static inline std::atomic<int> transfers{};
+
+        int value;
+
+        explicit counted(int v) : value{v} {}
+        counted(const counted& other) : value{other.value} { ++transfers; }
+        counted(counted&& other) noexcept : value{other.value} { ++transfers; }
+    };
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    TEST(sharded_list, single_thread) {
+        saxion::sharded_list<std::string> lst(3);
+        ASSERT_EQ(lst.shard_count(), 3);
+        ASSERT_TRUE(lst.empty());
+        ASSERT_TRUE(lst.drain().empty());
+
+        lst.push_back("a");
+        std::string b = "b";
+        lst.push_back(b);
+        lst.emplace_back(2, 'c');
+        ASSERT_EQ(lst.size(), 3);
+
+        auto drained = lst.drain();
+        ASSERT_EQ(to_vector(drained), (std::vector<std::string>{"a", "b", "cc"})) << "One thread appends to one shard";
+        ASSERT_TRUE(lst.empty());
+
+        lst.push_back("d");
+        saxion::list<std::string> out{"x"};
+        lst.drain(out);
+        ASSERT_EQ(to_vector(out), (std::vector<std::string>{"x", "d"}));
+        ASSERT_EQ(saxion::sharded_list<int>(0).shard_count(), 1);
+    }
+
+    TEST(sharded_list, drain_relinks_nodes) {
+        saxion::sharded_list<counted> lst(2);
+        for (int i = 0; i < 100; ++i) {
+            lst.emplace_back(i);
+        }
+        counted::transfers = 0;
+        auto drained = lst.drain();
+        ASSERT_EQ(drained.size(), 100);
+        ASSERT_EQ(counted::transfers, 0) << "Draining should splice the nodes, not move the elements";
+    }
+
+    TEST(sharded_list, concurrent_appends) {
+        saxion::sharded_list<event> lst(n_threads);
+        std::atomic<long> clock{};
+        saxion::list<event> drained;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    lst.push_back({clock.fetch_add(1), t, i});
+                }
+            });
+        }
+        // drain while the threads are appending
+        for (int i = 0; i < 10; ++i) {
+            lst.drain(drained);
+            std::this_thread::yield();
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        lst.drain(drained);
+
+        ASSERT_EQ(drained.size(), n_threads * per_thread);
+        std::vector<int> next(n_threads, 0);
+        for (const auto& e : drained) {
+            ASSERT_EQ(e.sequence, next[static_cast<std::size_t>(e.thread)]++) << "The events of a thread should keep their order";
+        }
+    }
+
+    TEST(sharded_list, drain_merged_by_timestamp) {
+        saxion::sharded_list<event> lst(n_threads);
+        std::atomic<long> clock{};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    lst.push_back({clock.fetch_add(1), t, i});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        auto merged = lst.drain_merged(std::less<>{}, &event::timestamp);
+        ASSERT_EQ(merged.size(), n_threads * per_thread);
+        long expected = 0;
+        for (const auto& e : merged) {
+            ASSERT_EQ(e.timestamp, expected++);
+        }
+    }
+
+    TEST(sharded_list, drain_merged_sorts_shared_shards) {
+        saxion::sharded_list<int> lst(1);
+        for (int v : {5, 1, 4, 2, 3}) {
+            lst.push_back(v);
+        }
+        ASSERT_EQ(to_vector(lst.drain_merged()), (std::vector<int>{1, 2, 3, 4, 5}));
+        ASSERT_EQ(to_vector(lst.drain_merged(std::greater<>{})), std::vector<int>{});
+    }
+
+    TEST(sharded_list, observed_shards) {
+        saxion::sharded_list<int, std::allocator<int>, saxion::trace_recorder> lst(2);
+        for (int v : {3, 1, 2}) {
+            lst.push_back(v);
+        }
+        saxion::recorded_list<int> out{0};
+        lst.drain(out);
+        ASSERT_EQ(to_vector(out), (std::vector<int>{0, 3, 1, 2}));
+        lst.push_back(4);
+        ASSERT_EQ(to_vector(lst.drain()), (std::vector<int>{4}));
+    }
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "shm_list.h"
+
+namespace {
+
+    struct record {
+        int producer;
+        int sequence;
+        char tag[8];
+    };
+
+    /// runs fn in a child process and returns its exit code
+    template<typename Fn>
+    pid_t fork_child(Fn fn) {
+        pid_t pid = ::fork();
+        if (pid == 0) {
+            int code = 1;
+            try {
+                code = fn();
+            } catch (...) {
+            }
+            ::_exit(code);
+        }
+        return pid;
+    }
+
+    int wait_child(pid_t pid) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+
+    std::string segment_name(const char* test) {
+        return "/saxion_shm_list_" + std::string(test) + "_" + std::to_string(::getpid());
+    }
+
+    TEST(shm_list, single_process) {
+        auto lst = saxion::shm_list<int>::anonymous(3);
+        ASSERT_TRUE(lst.empty());
+        ASSERT_EQ(lst.capacity(), 3);
+        ASSERT_FALSE(lst.try_pop_front().has_value());
+
+        ASSERT_TRUE(lst.try_push_back(1));
+        lst.push_back(2);
+        ASSERT_TRUE(lst.try_push_back(3));
+        ASSERT_FALSE(lst.try_push_back(4)) << "The segment should not grow";
+        ASSERT_EQ(lst.size(), 3);
+
+        std::vector<int> seen;
+        lst.for_each([&](const int& v) { seen.push_back(v); });
+        ASSERT_EQ(seen, (std::vector<int>{1, 2, 3}));
+
+        ASSERT_EQ(lst.pop_front(), 1);
+        ASSERT_TRUE(lst.try_push_back(4)) << "A popped slot should be reused";
+        ASSERT_EQ(lst.pop_front(), 2);
+        ASSERT_EQ(lst.pop_front(), 3);
+        ASSERT_EQ(lst.try_pop_front(), 4);
+        ASSERT_TRUE(lst.empty());
+    }
+
+    TEST(shm_list, fork_producer_consumer) {
+        constexpr int count = 20000;
+        // small capacity: the producer has to wait for the consumer
+        auto lst = saxion::shm_list<record>::anonymous(16);
+
+        pid_t producer = fork_child([&] {
+            for (int i = 0; i < count; ++i) {
+                lst.push_back(record{1, i, "rec"});
+            }
+            return 0;
+        });
+        pid_t consumer = fork_child([&] {
+            for (int i = 0; i < count; ++i) {
+                auto r = lst.pop_front();
+                if (r.producer != 1 || r.sequence != i || std::string(r.tag) != "rec") {
+                    return 2;
+                }
+            }
+            return 0;
+        });
+
+        ASSERT_EQ(wait_child(producer), 0);
+        ASSERT_EQ(wait_child(consumer), 0) << "The consumer should see every record once, in order";
+        ASSERT_TRUE(lst.empty());
+    }
+
+    TEST(shm_list, fork_many_producers) {
+        constexpr int producers = 4;
+        constexpr int per_producer = 5000;
+        auto lst = saxion::shm_list<record>::anonymous(64);
+
+        std::vector<pid_t> children;
+        for (int p = 0; p < producers; ++p) {
+            children.push_back(fork_child([&, p] {
+                for (int i = 0; i < per_producer; ++i) {
+                    lst.push_back(record{p, i, {}});
+                }
+                return 0;
+            }));
+        }
+
+        std::vector<int> next(producers, 0);
+        for (int i = 0; i < producers * per_producer; ++i) {
+            auto r = lst.pop_front();
+            ASSERT_EQ(r.sequence, next[static_cast<std::size_t>(r.producer)]++) << "The records of a process should keep their order";
+        }
+        for (auto pid : children) {
+            ASSERT_EQ(wait_child(pid), 0);
+        }
+        ASSERT_TRUE(lst.empty());
+    }
+
+    TEST(shm_list, named_segment) {
+        auto name = segment_name("named");
+        auto lst = saxion::shm_list<record>::create(name, 8);
+        ASSERT_THROW((void) saxion::shm_list<record>::create(name, 8), std::system_error);
+        ASSERT_THROW((void) saxion::shm_list<double>::open(name), std::system_error) << "The record layout should be checked";
+
+        pid_t child = fork_child([&] {
+            // a process of its own would only know the name
+            auto other = saxion::shm_list<record>::open(name);
+            for (int i = 0; i < 5; ++i) {
+                other.push_back(record{7, i, "named"});
+            }
+            return 0;
+        });
+        ASSERT_EQ(wait_child(child), 0);
+
+        auto reopened = saxion::shm_list<record>::open(name);
+        ASSERT_EQ(reopened.size(), 5);
+        for (int i = 0; i < 5; ++i) {
+            auto r = lst.pop_front();
+            ASSERT_EQ(r.producer, 7);
+            ASSERT_EQ(r.sequence, i);
+        }
+        ASSERT_TRUE(reopened.empty()) << "Both mappings should see the same list";
+
+        ASSERT_TRUE(saxion::shm_list<record>::remove(name));
+        ASSERT_FALSE(saxion::shm_list<record>::remove(name));
+        ASSERT_THROW((void) saxion::shm_list<record>::open(name), std::system_error);
+    }
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "unrolled_list.h"
+
+namespace {
+
+    // small chunks, so a handful of elements already exercises splitting and merging
+    using small_list = saxion::unrolled_list<int, std::allocator<int>, 64>;
+
+    template<typename List>
+    std::vector<typename List::value_type> to_vector(const List& lst) {
+        return {lst.begin(), lst.end()};
+    }
+
+    TEST(unrolled_list, empty) {
+        saxion::unrolled_list<int> lst;
+        ASSERT_TRUE(lst.empty());
+        ASSERT_EQ(lst.size(), 0);
+        ASSERT_EQ(lst.chunk_count(), 0);
+        ASSERT_EQ(lst.begin(), lst.end());
+    }
+
+    TEST(unrolled_list, chunk_capacity) {
+        ASSERT_GT(saxion::unrolled_list<int>::chunk_capacity, 32) << "A chunk of ints should span a few cache lines";
+        ASSERT_GE((saxion::unrolled_list<std::string, std::allocator<std::string>, 16>::chunk_capacity), 2)
+                                    << "A chunk should always hold at least two elements";
+    }
+
+    TEST(unrolled_list, push_and_iterate) {
+        small_list lst;
+        std::vector<int> expected;
+        for (int i = 0; i < 100; ++i) {
+            lst.push_back(i);
+            expected.push_back(i);
+        }
+        ASSERT_EQ(lst.size(), 100);
+        ASSERT_EQ(to_vector(lst), expected);
+        ASSERT_EQ(lst.front(), 0);
+        ASSERT_EQ(lst.back(), 99);
+        ASSERT_EQ(lst.chunk_count(), (100 + small_list::chunk_capacity - 1) / small_list::chunk_capacity)
+                                    << "Appending should fill the chunks completely";
+
+        std::vector<int> reversed(lst.size());
+        std::reverse_copy(lst.begin(), lst.end(), reversed.begin());
+        std::reverse(expected.begin(), expected.end());
+        ASSERT_EQ(reversed, expected) << "The iterators should be bidirectional";
+    }
+
+    TEST(unrolled_list, push_front) {
+        small_list lst;
+        for (int i = 0; i < 50; ++i) {
+            lst.push_front(i);
+        }
+        ASSERT_EQ(lst.front(), 49);
+        ASSERT_EQ(lst.back(), 0);
+        auto values = to_vector(lst);
+        ASSERT_TRUE(std::is_sorted(values.rbegin(), values.rend()));
+    }
+
+    TEST(unrolled_list, insert_splits_chunks) {
+        small_list lst;
+        for (std::size_t i = 0; i < small_list::chunk_capacity; ++i) {
+            lst.push_back(static_cast<int>(i));
+        }
+        ASSERT_EQ(lst.chunk_count(), 1);
+
+        auto pos = std::next(lst.begin(), 3);
+        auto it = lst.insert(pos, -1);
+        ASSERT_EQ(*it, -1);
+        ASSERT_EQ(lst.chunk_count(), 2) << "Inserting into a full chunk should split it";
+        ASSERT_EQ(std::distance(lst.begin(), it), 3);
+        ASSERT_EQ(lst.size(), small_list::chunk_capacity + 1);
+    }
+
+    TEST(unrolled_list, erase_merges_chunks) {
+        small_list lst;
+        auto n = 4 * small_list::chunk_capacity;
+        for (std::size_t i = 0; i < n; ++i) {
+            lst.push_back(static_cast<int>(i));
+        }
+        ASSERT_EQ(lst.chunk_count(), 4);
+
+        // erase every other element: the chunks get half empty and should be merged
+        auto it = lst.begin();
+        while (it != lst.end()) {
+            it = lst.erase(it);
+            if (it != lst.end()) {
+                ++it;
+            }
+        }
+        ASSERT_EQ(lst.size(), n / 2);
+        ASSERT_LT(lst.chunk_count(), 4);
+        for (auto value : lst) {
+            ASSERT_EQ(value % 2, 1);
+        }
+
+        while (!lst.empty()) {
+            lst.pop_back();
+        }
+        ASSERT_EQ(lst.chunk_count(), 0) << "Empty chunks should be released";
+    }
+
+    TEST(unrolled_list, random_operations) {
+        std::mt19937 gen(42);
+        small_list lst;
+        std::vector<int> expected;
+
+        for (int step = 0; step < 5000; ++step) {
+            auto roll = gen() % 10;
+            if (roll < 6 || expected.empty()) {
+                auto index = gen() % (expected.size() + 1);
+                auto it = lst.insert(std::next(lst.begin(), static_cast<std::ptrdiff_t>(index)), step);
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index), step);
+                ASSERT_EQ(*it, step);
+            } else {
+                auto index = gen() % expected.size();
+                auto it = lst.erase(std::next(lst.begin(), static_cast<std::ptrdiff_t>(index)));
+                expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+                if (index < expected.size()) {
+                    ASSERT_EQ(*it, expected[index]) << "erase should return the element after the erased one";
+                } else {
+                    ASSERT_EQ(it, lst.end());
+                }
+            }
+            ASSERT_EQ(lst.size(), expected.size());
+        }
+        ASSERT_EQ(to_vector(lst), expected);
+        ASSERT_LE(lst.chunk_count() * small_list::chunk_capacity, 2 * lst.size() + 2 * small_list::chunk_capacity)
+                                    << "The chunks should stay reasonably full";
+    }
+
+    /// copies through a throwing, non-noexcept move, and can be told to fail after a number of copies or moves
+    struct fragile {
+        static inline int alive{};
+        static inline int budget{-1};
+
+        int value;
+
+        fragile(int value) : value{value} {
+            ++alive;
+        }
+
+        fragile(const fragile& other) : value{other.value} {
+            spend();
+            ++alive;
+        }
+
+        fragile(fragile&& other) : value{other.value} {
+            spend();
+            ++alive;
+        }
+
+        fragile& operator=(const fragile& other) {
+            spend();
+            value = other.value;
+            return *this;
+        }
+
+        fragile& operator=(fragile&& other) {
+            spend();
+            value = other.value;
+            return *this;
+        }
+
+        ~fragile() {
+            --alive;
+        }
+
+        static void spend() {
+            if (budget == 0) {
+                throw std::runtime_error("copy failed");
+            }
+            if (budget > 0) {
+                --budget;
+            }
+        }
+    };
+
+    using fragile_list = saxion::unrolled_list<fragile, std::allocator<fragile>, 64>;
+
+    std::vector<int> values_of(const fragile_list& lst) {
+        std::vector<int> values;
+        for (const auto& element : lst) {
+            values.push_back(element.value);
+        }
+        return values;
+    }
+
+    TEST(unrolled_list, throwing_split) {
+        fragile::alive = 0;
+        {
+            fragile_list lst;
+            std::vector<int> expected;
+            for (std::size_t i = 0; i < fragile_list::chunk_capacity; ++i) {
+                lst.emplace_back(static_cast<int>(i));
+                expected.push_back(static_cast<int>(i));
+            }
+            ASSERT_EQ(lst.chunk_count(), 1);
+
+            // the split copies the upper half of the chunk, let a copy in the middle of it fail
+            fragile::budget = 1;
+            ASSERT_THROW(lst.emplace(std::next(lst.begin()), -1), std::runtime_error);
+            fragile::budget = -1;
+            ASSERT_EQ(lst.size(), expected.size()) << "A failed split shouldn't change the list";
+            ASSERT_EQ(lst.chunk_count(), 1) << "The new chunk should be released";
+            ASSERT_EQ(values_of(lst), expected);
+            ASSERT_EQ(fragile::alive, static_cast<int>(expected.size())) << "The copies made so far should be destroyed";
+
+            lst.emplace(std::next(lst.begin()), -1);
+            expected.insert(std::next(expected.begin()), -1);
+            ASSERT_EQ(values_of(lst), expected);
+        }
+        ASSERT_EQ(fragile::alive, 0);
+    }
+
+    TEST(unrolled_list, throwing_shift) {
+        fragile::alive = 0;
+        {
+            fragile_list lst;
+            for (int i = 0; i < 3; ++i) {
+                lst.emplace_back(i);
+            }
+
+            // the last element gets moved into a new slot, then shifting the others fails
+            fragile::budget = 1;
+            ASSERT_THROW(lst.emplace(lst.begin(), -1), std::runtime_error);
+            fragile::budget = -1;
+            ASSERT_EQ(lst.size(), 3);
+            ASSERT_EQ(values_of(lst), (std::vector<int>{0, 1, 2}));
+            ASSERT_EQ(fragile::alive, 3) << "The element moved into the new slot should be destroyed";
+        }
+        ASSERT_EQ(fragile::alive, 0);
+    }
+
+    TEST(unrolled_list, strings) {
+        saxion::unrolled_list<std::string, std::allocator<std::string>, 128> lst{"b", "d"};
+        lst.insert(lst.begin(), "a");
+        lst.insert(std::next(lst.begin(), 2), std::string(40, 'c'));
+        lst.emplace_back(3, 'e');
+        ASSERT_EQ(to_vector(lst), (std::vector<std::string>{"a", "b", std::string(40, 'c'), "d", "eee"}));
+
+        lst.erase(std::next(lst.begin()));
+        lst.pop_front();
+        ASSERT_EQ(lst.front(), std::string(40, 'c'));
+    }
+
+    TEST(unrolled_list, copy_move_swap) {
+        small_list first{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
+        small_list copy{first};
+        ASSERT_EQ(to_vector(copy), to_vector(first));
+
+        small_list moved{std::move(first)};
+        ASSERT_TRUE(first.empty());
+        ASSERT_EQ(to_vector(moved), to_vector(copy));
+
+        small_list other{42};
+        other.swap(moved);
+        ASSERT_EQ(to_vector(moved), (std::vector<int>{42}));
+        ASSERT_EQ(to_vector(other), to_vector(copy));
+
+        moved = other;
+        ASSERT_EQ(to_vector(moved), to_vector(copy));
+        copy = std::move(moved);
+        ASSERT_EQ(copy.size(), 20);
+        ASSERT_EQ(*std::prev(copy.end()), 20);
+    }
+
+    TEST(unrolled_list, const_iterators) {
+        const small_list lst{3, 1, 2};
+        ASSERT_EQ(std::distance(lst.cbegin(), lst.cend()), 3);
+        ASSERT_EQ(*std::max_element(lst.begin(), lst.end()), 3);
+
+        small_list mutable_list{1, 2};
+        small_list::const_iterator it = mutable_list.begin();
+        ASSERT_EQ(mutable_list.begin(), it) << "It should be possible to compare const and non-const iterators";
+    }
+
+    TEST(unrolled_list, polymorphic_allocator) {
+        std::pmr::monotonic_buffer_resource resource;
+        saxion::pmr::unrolled_list<int> lst{&resource};
+        for (int i = 0; i < 1000; ++i) {
+            lst.push_back(i);
+        }
+        ASSERT_EQ(lst.get_allocator().resource(), &resource);
+        ASSERT_EQ(lst.back(), 999);
+    }
+}
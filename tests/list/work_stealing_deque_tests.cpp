@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "work_stealing_deque.h"
+
+namespace {
+
+    constexpr int n_thieves = 3;
+
+    template<typename Deque>
+    std::vector<typename Deque::value_type> drain_back(Deque& deque) {
+        std::vector<typename Deque::value_type> result;
+        while (auto value = deque.pop_back()) {
+            result.push_back(std::move(*value));
+        }
+        return result;
+    }
+
+    TEST(work_stealing_deque, owner_and_thief_ends) {
+        saxion::work_stealing_deque<int> deque;
+        ASSERT_TRUE(deque.empty());
+        ASSERT_FALSE(deque.pop_back().has_value());
+        ASSERT_FALSE(deque.steal().has_value());
+
+        for (int i = 0; i < 5; ++i) {
+            deque.push_back(i);
+        }
+        ASSERT_EQ(deque.size(), 5);
+        ASSERT_EQ(deque.pop_back(), 4) << "The owner should work at the back";
+        ASSERT_EQ(deque.steal(), 0) << "Thieves should take the oldest element";
+        ASSERT_EQ(deque.steal(), 1);
+        ASSERT_EQ(drain_back(deque), (std::vector<int>{3, 2}));
+        ASSERT_FALSE(deque.steal().has_value());
+
+        deque.emplace_back(7);
+        ASSERT_EQ(deque.steal(), 7);
+        deque.push_back(8);
+        ASSERT_EQ(deque.pop_back(), 8);
+        ASSERT_TRUE(deque.empty());
+    }
+
+    TEST(work_stealing_deque, steal_half) {
+        saxion::work_stealing_deque<std::unique_ptr<int>> victim;
+        saxion::work_stealing_deque<std::unique_ptr<int>> thief;
+        ASSERT_EQ(victim.steal_half(thief), 0);
+
+        for (int i = 0; i < 9; ++i) {
+            victim.push_back(std::make_unique<int>(i));
+        }
+        ASSERT_EQ(victim.steal_half(thief), 4);
+        ASSERT_EQ(victim.size(), 5);
+        ASSERT_EQ(thief.size(), 4);
+
+        thief.push_back(std::make_unique<int>(100));
+        std::vector<int> stolen;
+        for (auto& value : drain_back(thief)) {
+            stolen.push_back(*value);
+        }
+        ASSERT_EQ(stolen, (std::vector<int>{100, 3, 2, 1, 0})) << "The stolen elements should keep their order";
+
+        ASSERT_EQ(victim.steal_half(thief), 2);
+        ASSERT_EQ(victim.steal_half(thief), 1);
+        ASSERT_EQ(victim.steal_half(thief), 1) << "A single element should be stolen as well";
+        ASSERT_EQ(**victim.pop_back(), 8);
+        ASSERT_TRUE(victim.empty());
+        ASSERT_EQ(**thief.steal(), 4);
+        ASSERT_EQ(thief.size(), 3);
+    }
+
+    TEST(work_stealing_deque, owner_with_thieves) {
+        constexpr int n_values = 100000;
+        saxion::work_stealing_deque<int> deque;
+        std::atomic<bool> done{false};
+        std::vector<std::vector<int>> stolen(n_thieves);
+
+        std::vector<std::thread> thieves;
+        for (int t = 0; t < n_thieves; ++t) {
+            thieves.emplace_back([&, t] {
+                auto& mine = stolen[static_cast<std::size_t>(t)];
+                saxion::work_stealing_deque<int> own;
+                while (!done.load() || !deque.empty()) {
+                    if (t == 0) {
+                        if (auto value = deque.steal()) {
+                            mine.push_back(*value);
+                        }
+                    } else if (deque.steal_half(own) != 0) {
+                        while (auto value = own.pop_back()) {
+                            mine.push_back(*value);
+                        }
+                    }
+                }
+            });
+        }
+
+        std::vector<int> popped;
+        for (int i = 0; i < n_values; ++i) {
+            deque.push_back(i);
+            if (i % 3 == 0) {
+                if (auto value = deque.pop_back()) {
+                    popped.push_back(*value);
+                }
+            }
+        }
+        while (auto value = deque.pop_back()) {
+            popped.push_back(*value);
+        }
+        done = true;
+        for (auto& thief : thieves) {
+            thief.join();
+        }
+
+        std::vector<int> seen(n_values);
+        for (int value : popped) {
+            ++seen[static_cast<std::size_t>(value)];
+        }
+        for (const auto& values : stolen) {
+            for (int value : values) {
+                ++seen[static_cast<std::size_t>(value)];
+            }
+        }
+        ASSERT_EQ(std::count(seen.begin(), seen.end(), 1), n_values) << "Every element should be taken exactly once";
+    }
+
+    TEST(work_stealing_deque, empty_only_when_empty) {
+        // every round the owner pushes, then pops until the deque looks empty while a thief steals half of it
+        constexpr int n_rounds = 20000;
+        constexpr int n_per_round = 16;
+        saxion::work_stealing_deque<int> deque;
+        std::atomic<int> round{0};
+        std::atomic<int> thief_round{0};
+        std::vector<int> stolen;
+
+        std::thread thief([&] {
+            saxion::work_stealing_deque<int> own;
+            for (int r = 1; r <= n_rounds; ++r) {
+                while (round.load() < r) {
+                    std::this_thread::yield();
+                }
+                deque.steal_half(own);
+                while (auto value = own.pop_back()) {
+                    stolen.push_back(*value);
+                }
+                thief_round.store(r);
+            }
+        });
+
+        std::vector<int> popped;
+        int left_behind = 0;
+        for (int r = 1; r <= n_rounds; ++r) {
+            for (int i = 0; i < n_per_round; ++i) {
+                deque.push_back((r - 1) * n_per_round + i);
+            }
+            round.store(r);
+            while (auto value = deque.pop_back()) {
+                popped.push_back(*value);
+            }
+            while (thief_round.load() < r) {
+                std::this_thread::yield();
+            }
+            // the thief only takes elements, so nothing can be left once the owner saw an empty deque
+            if (!deque.empty()) {
+                ++left_behind;
+                popped.push_back(*deque.pop_back());
+                while (auto value = deque.pop_back()) {
+                    popped.push_back(*value);
+                }
+            }
+        }
+        thief.join();
+        ASSERT_EQ(left_behind, 0) << "pop_back() should not report an empty deque while it holds elements";
+
+        std::vector<int> seen(n_rounds * n_per_round);
+        for (const auto& values : {popped, stolen}) {
+            for (int value : values) {
+                ++seen[static_cast<std::size_t>(value)];
+            }
+        }
+        ASSERT_EQ(std::count(seen.begin(), seen.end(), 1), n_rounds * n_per_round) << "Every element should be taken exactly once";
+    }
+}